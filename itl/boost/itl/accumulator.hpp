@@ -0,0 +1,147 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class accumulator
+    Private interval maps of threads, that are added up on collect
+--------------------------------------------------------------------*/
+#ifndef __itl_accumulator_JOFA_081104_H__
+#define __itl_accumulator_JOFA_081104_H__
+
+#include <vector>
+#include <boost/thread/thread.hpp>
+#include <boost/itl/parallel.hpp>
+#include <boost/itl/buffered.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Accumulate
+{
+    /// Number of threads that run concurrently on this machine, at least 1
+    inline unsigned hardware_threads()
+    {
+        unsigned count = boost::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+    /// Run task(0), ..., task(count-1), each one in a thread of its own
+    /** Unlike Parallel::run threads are started regardless of
+        ITL_USE_BOOST_THREAD. The calling thread runs task(0) itself. */
+    template <class TaskT>
+    void run(TaskT task, unsigned count)
+    {
+        boost::thread_group workers;
+        for(unsigned part = 1; part < count; part++)
+            workers.create_thread(Parallel::bind_part<TaskT>(task, part));
+        if(count > 0)
+            task(0);
+        workers.join_all();
+    }
+
+    /// One round of a tree reduction of parts
+    /** Task \c j adds part <tt>(2*j+1)*width</tt> to part <tt>2*j*width</tt>.
+        Thread \c t runs the tasks <tt>t, t+threads, t+2*threads, ...</tt> */
+    template <class PartsT>
+    struct reduce_parts
+    {
+        reduce_parts(PartsT& parts, std::size_t width, unsigned threads)
+            : _parts(&parts), _width(width), _threads(threads) {}
+
+        void operator()(unsigned thread)const
+        {
+            for(std::size_t target = 2 * thread * _width; target + _width < _parts->size();
+                target += 2 * _threads * _width)
+            {
+                Buffer::merge_into((*_parts)[target]._object, (*_parts)[target + _width]._object);
+                (*_parts)[target + _width]._object.clear();
+            }
+        }
+
+        PartsT*     _parts;
+        std::size_t _width;
+        unsigned    _threads;
+    };
+
+} // namespace Accumulate
+
+
+/// Interval maps of concurrent writers, that are added up on \c collect
+/**
+    An <b>accumulator</b> keeps a private interval map for every part of a
+    parallel computation, e.g. for every task of Parallel::run. Writers
+    update <tt>part(idx)</tt> of their own without any locks.
+    <tt>collect()</tt> adds up all parts by a tree reduction: In round k
+    part <tt>(2*j+1)*2^k</tt> is added to part <tt>2*j*2^k</tt>, and the
+    additions of one round run concurrently. So for p parts there are
+    log(p) rounds, each of which sweeps maps of similar size.
+
+    Since addition is commutative and associative the collected map equals
+    a map to which all updates were added by a single thread. Collecting
+    must not run concurrently with writers.
+
+    Accumulators always run threads of Boost.Thread, so programs using
+    them link boost_thread, whether ITL_USE_BOOST_THREAD is defined or not.
+
+    @author Joachim Faulhaber
+*/
+template <class MapT>
+class accumulator
+{
+public:
+    typedef MapT container_type;
+
+    /// An accumulator of \c count parts, one per hardware thread by default
+    explicit accumulator(unsigned count = Accumulate::hardware_threads())
+        : _parts(count == 0 ? 1 : count) {}
+
+    unsigned part_count()const { return static_cast<unsigned>(_parts.size()); }
+
+    /// The private map of part \c idx
+    MapT& part(unsigned idx) { return _parts[idx]._object; }
+
+    /// Add all parts to part 0 using up to \c threads threads and return it
+    /** Parts other than part 0 are empty afterwards, so writers may go on
+        and be collected again. */
+    const MapT& collect(unsigned threads = Accumulate::hardware_threads())
+    {
+        for(std::size_t width = 1; width < _parts.size(); width *= 2)
+        {
+            std::size_t tasks = (_parts.size() + width - 1) / (2*width);
+            unsigned count = tasks < threads ? static_cast<unsigned>(tasks) : threads;
+            if(count == 0)
+                count = 1;
+            Accumulate::run(Accumulate::reduce_parts<parts_type>(_parts, width, count), count);
+        }
+        return _parts[0]._object;
+    }
+
+    void clear()
+    {
+        for(std::size_t idx = 0; idx < _parts.size(); idx++)
+            _parts[idx]._object.clear();
+    }
+
+private:
+    // The headers of the maps of different writers do not share cache lines
+    struct padded_part
+    {
+        MapT _object;
+        char _padding[64];
+    };
+
+    typedef std::vector<padded_part> parts_type;
+
+private:
+    parts_type _parts;
+};
+
+}} // namespace itl boost
+
+#endif
+
@@ -0,0 +1,271 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+function aggregate
+    k-way aggregation of many interval maps in one sweep
+--------------------------------------------------------------------*/
+#ifndef __itl_aggregate_JOFA_081026_H__
+#define __itl_aggregate_JOFA_081026_H__
+
+#include <set>
+#include <vector>
+#include <limits>
+#include <iterator>
+#include <algorithm>
+#include <boost/mpl/if.hpp>
+#include <boost/itl/notate.hpp>
+#include <boost/itl/functors.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Aggregate
+{
+    /// Running value of the segments that overlap the sweep position
+    /** For integral sums the aggregated value of the active segments is
+        maintained by adding and subtracting values. Other combinators
+        recompute the value from the active segments. */
+    template <class CodomainT>
+    struct running_sum
+    {
+        enum { is_running = true };
+
+        running_sum(): _value() {}
+        void add(const CodomainT& value)      { _value += value; }
+        void subtract(const CodomainT& value) { _value -= value; }
+        const CodomainT& value()const { return _value; }
+
+        CodomainT _value;
+    };
+
+    template <class CodomainT>
+    struct no_running_value
+    {
+        enum { is_running = false };
+
+        void add(const CodomainT&) {}
+        void subtract(const CodomainT&) {}
+        CodomainT value()const { return CodomainT(); }
+    };
+
+    template <template<class>class Combinator, class CodomainT>
+    struct running_value
+    { typedef no_running_value<CodomainT> type; };
+
+    template <class CodomainT>
+    struct running_value<inplace_plus, CodomainT>
+    {
+        typedef typename mpl::if_c<std::numeric_limits<CodomainT>::is_integer,
+                                   running_sum<CodomainT>,
+                                   no_running_value<CodomainT> >::type type;
+    };
+
+    /// Position of the sweep in one of the aggregated maps
+    template <class InputMapT>
+    struct cursor
+    {
+        typedef typename InputMapT::const_iterator segment_iterator;
+        typedef typename InputMapT::interval_type  interval_type;
+        typedef typename InputMapT::codomain_type  codomain_type;
+
+        cursor(const segment_iterator& segment_, const segment_iterator& end_)
+            : _segment(segment_), _end(end_) {}
+
+        const interval_type& interval()const { return (*_segment).KEY_VALUE; }
+        const codomain_type& value()const    { return (*_segment).CONT_VALUE; }
+
+        segment_iterator _segment;
+        segment_iterator _end;
+    };
+
+    // Heap orders: std heaps are max heaps, so these compare 'later than'
+    template <class CursorT>
+    struct starts_later
+    {
+        starts_later(const std::vector<CursorT>& cursors): _cursors(&cursors) {}
+        bool operator()(std::size_t lhs, std::size_t rhs)const
+        { return (*_cursors)[rhs].interval().lower_less((*_cursors)[lhs].interval()); }
+        const std::vector<CursorT>* _cursors;
+    };
+
+    template <class CursorT>
+    struct ends_later
+    {
+        ends_later(const std::vector<CursorT>& cursors): _cursors(&cursors) {}
+        bool operator()(std::size_t lhs, std::size_t rhs)const
+        { return (*_cursors)[rhs].interval().upper_less((*_cursors)[lhs].interval()); }
+        const std::vector<CursorT>* _cursors;
+    };
+
+} // namespace Aggregate
+
+
+/// Aggregate the interval maps of the range [first, past) into \c result
+/** The result is the same as that of adding all maps of the range to
+    \c result one after another using <tt>add<Combinator></tt>. The maps are
+    swept simultaneously: A heap of the maps ordered by the next segment
+    start and a heap of the active segments ordered by their end yield the
+    elementary intervals between all segment borders in ascending order.
+    They are appended to \c result using hints. For k maps with S segments
+    in total the sweep takes O(S log k), where repeated addition walks the
+    accumulated map for every map.
+
+    For integral sums the aggregated value is maintained incrementally, so
+    aggregation takes O(S log k). For other combinators it is folded from
+    the values of the active segments in the order of the maps, so it is
+    correct for non commutative and non associative combinators, too. The
+    fold visits every active segment for every elementary interval, so
+    aggregation takes O(S log k + E a) for E elementary intervals with a
+    active segments on average, which is O(S k) in the worst case.
+    A split result is split at all segment borders of the aggregated maps.
+*/
+template <template<class>class Combinator, class IntervalMapT, class IteratorT>
+IntervalMapT& aggregate(IntervalMapT& result, IteratorT first, IteratorT past)
+{
+    typedef typename std::iterator_traits<IteratorT>::value_type InputMapT;
+    typedef typename IntervalMapT::interval_type interval_type;
+    typedef typename IntervalMapT::codomain_type codomain_type;
+    typedef typename IntervalMapT::value_type    value_type;
+    typedef typename IntervalMapT::traits        traits;
+    typedef Aggregate::cursor<InputMapT>         cursor_type;
+    typedef typename Aggregate::running_value<Combinator, codomain_type>::type running_type;
+
+    // The content of result is aggregated as first map
+    InputMapT initial;
+    const_FORALL(typename IntervalMapT, segment_, result)
+        initial.insert(*segment_);
+    result.clear();
+
+    std::vector<cursor_type> cursors;
+    if(!initial.empty())
+        cursors.push_back(cursor_type(initial.begin(), initial.end()));
+    for(; first != past; ++first)
+        if(!(*first).empty())
+            cursors.push_back(cursor_type((*first).begin(), (*first).end()));
+
+    Aggregate::starts_later<cursor_type> starts_later(cursors);
+    Aggregate::ends_later<cursor_type>   ends_later(cursors);
+
+    std::vector<std::size_t> pending, active;
+    for(std::size_t idx = 0; idx < cursors.size(); idx++)
+        pending.push_back(idx);
+    std::make_heap(pending.begin(), pending.end(), starts_later);
+
+    // Active maps in the order of the range for folding their values
+    std::set<std::size_t> active_maps;
+    std::size_t  active_count = 0;
+    running_type running;
+    Combinator<codomain_type> combine;
+
+    interval_type done;
+    bool started = false;
+    typename IntervalMapT::iterator prior_ = result.end();
+
+    while(!pending.empty() || !active.empty())
+    {
+        // Segments that start right after the last elementary interval
+        // become active. After a gap, the next segments to start do.
+        bool gap = active.empty();
+        interval_type next = gap ? cursors[pending.front()].interval() : interval_type();
+        while(!pending.empty() && (gap ? cursors[pending.front()].interval().lower_equal(next)
+                                       : done.touches(cursors[pending.front()].interval())))
+        {
+            std::size_t idx = pending.front();
+            std::pop_heap(pending.begin(), pending.end(), starts_later);
+            pending.pop_back();
+            active.push_back(idx);
+            std::push_heap(active.begin(), active.end(), ends_later);
+            active_maps.insert(idx);
+            if(!(traits::absorbs_neutrons && cursors[idx].value() == codomain_type()))
+            {
+                ++active_count;
+                running.add(cursors[idx].value());
+            }
+        }
+
+        // The next elementary interval ends with the first active segment
+        // or before the next segment start
+        const interval_type& ending = cursors[active.front()].interval();
+        interval_type elementary = ending;
+        if(started && !done.exclusive_less(ending))
+            ending.right_surplus(elementary, done);
+        if(!pending.empty() && !elementary.exclusive_less(cursors[pending.front()].interval()))
+        {
+            interval_type left;
+            elementary.left_surplus(left, cursors[pending.front()].interval());
+            elementary = left;
+        }
+
+        // Aggregated value of the active segments like repeated addition yields it
+        bool present = false;
+        codomain_type value = running.value();
+        if(running_type::is_running)
+            present = active_count > 0 && !(traits::absorbs_neutrons && value == codomain_type());
+        else
+            for(std::set<std::size_t>::const_iterator map_ = active_maps.begin();
+                map_ != active_maps.end(); ++map_)
+            {
+                const codomain_type& operand = cursors[*map_].value();
+                if(traits::absorbs_neutrons && operand == codomain_type())
+                    continue;
+                if(!present)
+                {
+                    value = operand;
+                    if(traits::emits_neutrons)
+                    {
+                        value = codomain_type();
+                        combine(value, operand);
+                    }
+                    present = true;
+                }
+                else
+                    combine(value, operand);
+                if(traits::absorbs_neutrons && value == codomain_type())
+                    present = false;
+            }
+
+        if(present)
+            prior_ = result.add(prior_, value_type(elementary, value));
+        done = elementary;
+        started = true;
+
+        // Segments that end with the elementary interval are left
+        while(!active.empty() && cursors[active.front()].interval().upper_equal(done))
+        {
+            std::size_t idx = active.front();
+            std::pop_heap(active.begin(), active.end(), ends_later);
+            active.pop_back();
+            active_maps.erase(idx);
+            if(!(traits::absorbs_neutrons && cursors[idx].value() == codomain_type()))
+            {
+                --active_count;
+                running.subtract(cursors[idx].value());
+            }
+            if(++cursors[idx]._segment != cursors[idx]._end)
+            {
+                pending.push_back(idx);
+                std::push_heap(pending.begin(), pending.end(), starts_later);
+            }
+        }
+    }
+    return result;
+}
+
+/// Aggregate the interval maps of the range [first, past) into \c result by addition
+template <class IntervalMapT, class IteratorT>
+IntervalMapT& aggregate(IntervalMapT& result, IteratorT first, IteratorT past)
+{
+    return aggregate<inplace_plus>(result, first, past);
+}
+
+}} // namespace itl boost
+
+#endif
+
+
@@ -0,0 +1,1134 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class bitmap_interval_set
+    a compressed interval set for dense integral domains
+--------------------------------------------------------------------*/
+#ifndef __itl_bitmap_interval_set_JOFA_081024_H__
+#define __itl_bitmap_interval_set_JOFA_081024_H__
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/itl/notate.hpp>
+#include <boost/itl/interval.hpp>
+#include <boost/itl/set.hpp>
+#include <boost/itl/interval_morphism.hpp>
+
+namespace boost{namespace itl
+{
+
+/// A chunk of 2^16 consecutive values of a bitmap_interval_set
+/**
+    The values of a chunk are the low 16 bits of the keys of a
+    bitmap_interval_set that share the high 16 bits <tt>key()</tt>.
+    They are stored in one of three representations:
+
+    <b>array</b>: The sorted values, for sparse chunks of up to 4096 values.
+    <b>bitmap</b>: 1024 words of 64 bits, for dense chunks.
+    <b>runs</b>: Sorted pairs of first and last values of runs.
+
+    After operations that may change the best representation, a chunk
+    is normalized to the representation that needs the least memory.
+*/
+class bitmap_chunk
+{
+public:
+    typedef boost::uint16_t value_type;
+    typedef boost::uint64_t word_type;
+    typedef std::vector<value_type> ValueVectorT;
+    typedef std::vector<word_type>  WordVectorT;
+
+    enum kind_type { array_kind, bitmap_kind, run_kind };
+
+    enum { word_bits = 64, word_count = 1024, array_limit = 4096 };
+
+    /// The greatest value of a chunk
+    static const unsigned value_limit = 0xffff;
+
+public:
+    explicit bitmap_chunk(unsigned key = 0)
+        : _key(static_cast<value_type>(key)), _kind(array_kind), _cardinality(0) {}
+
+    void swap(bitmap_chunk& src)
+    {
+        std::swap(_key,         src._key);
+        std::swap(_kind,        src._kind);
+        std::swap(_cardinality, src._cardinality);
+        _values.swap(src._values);
+        _words.swap(src._words);
+    }
+
+    /// The high 16 bits common to all values of the chunk
+    unsigned key()const { return _key; }
+    kind_type kind()const { return _kind; }
+    /// Number of values in the chunk
+    std::size_t cardinality()const { return _cardinality; }
+    bool empty()const { return _cardinality == 0; }
+
+    bool contains(unsigned value)const { return contains(value, value); }
+
+    /// Does the chunk contain all values of [first,last]
+    bool contains(unsigned first, unsigned last)const
+    {
+        switch(_kind)
+        {
+        case array_kind:
+            {
+                ValueVectorT::const_iterator it_
+                    = std::lower_bound(_values.begin(), _values.end(), static_cast<value_type>(first));
+                // Unique sorted values: [first,last] is contained, if last is at the right distance
+                return static_cast<unsigned>(_values.end() - it_) > last - first
+                    && *it_ == first && it_[last - first] == last;
+            }
+        case bitmap_kind:
+            {
+                unsigned gap = 0;
+                return !find_bit(_words, first, false, gap) || gap > last;
+            }
+        default:
+            {
+                std::size_t idx = find_run(first);
+                return idx < _values.size() && _values[idx] <= first && last <= _values[idx+1];
+            }
+        }
+    }
+
+    unsigned first_value()const
+    {
+        BOOST_ASSERT(!empty());
+        unsigned pos = 0, first, last;
+        next_run(pos, first, last);
+        return first;
+    }
+
+    unsigned last_value()const
+    {
+        BOOST_ASSERT(!empty());
+        if(_kind != bitmap_kind)
+            return _values.back();
+        std::size_t idx = word_count;
+        while(_words[--idx] == 0) ;
+        return static_cast<unsigned>(idx * word_bits + word_bits - 1 - count_leading_zeros(_words[idx]));
+    }
+
+    /// Find the first run of values that starts at or after position \c pos.
+    /** Positions are opaque; iteration starts with <tt>pos=0</tt>. On success
+        [first,last] is the run and \c pos the position to continue with. */
+    bool next_run(unsigned& pos, unsigned& first, unsigned& last)const
+    {
+        switch(_kind)
+        {
+        case array_kind:
+            if(pos >= _values.size())
+                return false;
+            first = last = _values[pos++];
+            while(pos < _values.size() && _values[pos] == last + 1)
+                last = _values[pos++];
+            return true;
+        case bitmap_kind:
+            if(pos > value_limit || !find_bit(_words, pos, true, first))
+                return false;
+            if(find_bit(_words, first, false, last))
+                last--;
+            else
+                last = value_limit;
+            pos = last + 1;
+            return true;
+        default:
+            if(pos >= _values.size())
+                return false;
+            first = _values[pos];
+            last  = _values[pos+1];
+            pos += 2;
+            return true;
+        }
+    }
+
+    /// Add the values [first,last]
+    void add(unsigned first, unsigned last)
+    {
+        if(_kind == bitmap_kind)
+        {
+            _cardinality -= count_bits(_words, first, last);
+            set_range(_words, first, last, true);
+            _cardinality += count_bits(_words, first, last);
+        }
+        else if(_kind == array_kind && first == last)
+        {
+            ValueVectorT::iterator it_
+                = std::lower_bound(_values.begin(), _values.end(), static_cast<value_type>(first));
+            if(it_ == _values.end() || *it_ != first)
+            {
+                _values.insert(it_, static_cast<value_type>(first));
+                if(++_cardinality > array_limit)
+                    normalize();
+            }
+        }
+        else
+        {
+            ValueVectorT runs, range(2), joined;
+            to_runs(runs);
+            range[0] = static_cast<value_type>(first);
+            range[1] = static_cast<value_type>(last);
+            unite_runs(joined, runs, range);
+            assign_runs(joined);
+        }
+    }
+
+    /// Remove the values [first,last]
+    void subtract(unsigned first, unsigned last)
+    {
+        if(_kind == bitmap_kind)
+        {
+            _cardinality -= count_bits(_words, first, last);
+            set_range(_words, first, last, false);
+            _cardinality += count_bits(_words, first, last);
+            if(_cardinality <= array_limit)
+                normalize();
+        }
+        else if(_kind == array_kind && first == last)
+        {
+            ValueVectorT::iterator it_
+                = std::lower_bound(_values.begin(), _values.end(), static_cast<value_type>(first));
+            if(it_ != _values.end() && *it_ == first)
+            {
+                _values.erase(it_);
+                --_cardinality;
+            }
+        }
+        else
+        {
+            ValueVectorT runs, range(2), rest;
+            to_runs(runs);
+            range[0] = static_cast<value_type>(first);
+            range[1] = static_cast<value_type>(last);
+            subtract_runs(rest, runs, range);
+            assign_runs(rest);
+        }
+    }
+
+    /// Add all values of \c operand, a chunk of the same key
+    void add(const bitmap_chunk& operand)
+    { combine(operand, union_operation); }
+
+    /// Remove all values of \c operand, a chunk of the same key
+    void subtract(const bitmap_chunk& operand)
+    { combine(operand, difference_operation); }
+
+    /// Keep only values that are also in \c operand, a chunk of the same key
+    void intersect(const bitmap_chunk& operand)
+    { combine(operand, intersection_operation); }
+
+    /// Replace the contents by the sorted unique \c values; \c values is cleared
+    void assign_values(ValueVectorT& values)
+    {
+        _kind = array_kind;
+        _values.swap(values);
+        values.clear();
+        _words.clear();
+        _cardinality = _values.size();
+        normalize();
+    }
+
+    /// Convert to the representation that needs the least memory
+    void normalize()
+    {
+        ValueVectorT runs;
+        to_runs(runs);
+        std::size_t run_bytes    = sizeof(value_type) * runs.size();
+        std::size_t array_bytes  = sizeof(value_type) * _cardinality;
+        std::size_t bitmap_bytes = sizeof(word_type)  * word_count;
+
+        if(run_bytes < array_bytes && run_bytes < bitmap_bytes)
+        {
+            _kind = run_kind;
+            _values.swap(runs);
+            _words.clear();
+        }
+        else if(_cardinality <= array_limit)
+        {
+            if(_kind == array_kind)
+                return;
+            ValueVectorT values;
+            values.reserve(_cardinality);
+            for(std::size_t idx = 0; idx < runs.size(); idx += 2)
+                for(unsigned value = runs[idx]; value <= runs[idx+1]; value++)
+                    values.push_back(static_cast<value_type>(value));
+            _kind = array_kind;
+            _values.swap(values);
+            _words.clear();
+        }
+        else
+        {
+            if(_kind == bitmap_kind)
+                return;
+            WordVectorT words(word_count, 0);
+            for(std::size_t idx = 0; idx < runs.size(); idx += 2)
+                set_range(words, runs[idx], runs[idx+1], true);
+            _kind = bitmap_kind;
+            _words.swap(words);
+            ValueVectorT().swap(_values);
+        }
+    }
+
+    bool operator == (const bitmap_chunk& rhs)const
+    {
+        if(_key != rhs._key || _cardinality != rhs._cardinality)
+            return false;
+        if(_kind == rhs._kind)
+            return _kind == bitmap_kind ? _words == rhs._words : _values == rhs._values;
+        ValueVectorT lhs_runs, rhs_runs;
+        to_runs(lhs_runs);
+        rhs.to_runs(rhs_runs);
+        return lhs_runs == rhs_runs;
+    }
+
+private:
+    enum operation_type { union_operation, intersection_operation, difference_operation };
+
+    void combine(const bitmap_chunk& operand, operation_type operation)
+    {
+        BOOST_ASSERT(_key == operand._key);
+        if(_kind == bitmap_kind || operand._kind == bitmap_kind)
+        {
+            WordVectorT operand_words_;
+            const WordVectorT* operand_words = &operand._words;
+            if(operand._kind != bitmap_kind)
+            {
+                operand.to_words(operand_words_);
+                operand_words = &operand_words_;
+            }
+            if(_kind != bitmap_kind)
+            {
+                WordVectorT words;
+                to_words(words);
+                _words.swap(words);
+                ValueVectorT().swap(_values);
+                _kind = bitmap_kind;
+            }
+            combine_words(_words, *operand_words, operation);
+            _cardinality = count_bits(_words);
+            normalize();
+        }
+        else if(_kind == array_kind && operand._kind == array_kind)
+        {
+            ValueVectorT values;
+            values.reserve(operation == union_operation ? _values.size() + operand._values.size()
+                                                        : _values.size());
+            switch(operation)
+            {
+            case union_operation:
+                std::set_union(_values.begin(), _values.end(),
+                               operand._values.begin(), operand._values.end(),
+                               std::back_inserter(values));
+                break;
+            case intersection_operation:
+                std::set_intersection(_values.begin(), _values.end(),
+                                      operand._values.begin(), operand._values.end(),
+                                      std::back_inserter(values));
+                break;
+            default:
+                std::set_difference(_values.begin(), _values.end(),
+                                    operand._values.begin(), operand._values.end(),
+                                    std::back_inserter(values));
+            }
+            _values.swap(values);
+            _cardinality = _values.size();
+            if(_cardinality > array_limit || operation == union_operation)
+                normalize();
+        }
+        else
+        {
+            ValueVectorT lhs_runs, rhs_runs, result;
+            to_runs(lhs_runs);
+            operand.to_runs(rhs_runs);
+            switch(operation)
+            {
+            case union_operation:        unite_runs(result, lhs_runs, rhs_runs);     break;
+            case intersection_operation: intersect_runs(result, lhs_runs, rhs_runs); break;
+            default:                     subtract_runs(result, lhs_runs, rhs_runs);
+            }
+            assign_runs(result);
+        }
+    }
+
+    // The word loops are kept free of branches so that they can be vectorized
+    static void combine_words(WordVectorT& words, const WordVectorT& operand, operation_type operation)
+    {
+        word_type* lhs = &words[0];
+        const word_type* rhs = &operand[0];
+        switch(operation)
+        {
+        case union_operation:
+            for(int idx = 0; idx < word_count; idx++) lhs[idx] |= rhs[idx];
+            break;
+        case intersection_operation:
+            for(int idx = 0; idx < word_count; idx++) lhs[idx] &= rhs[idx];
+            break;
+        default:
+            for(int idx = 0; idx < word_count; idx++) lhs[idx] &= ~rhs[idx];
+        }
+    }
+
+    void assign_runs(ValueVectorT& runs)
+    {
+        _kind = run_kind;
+        _values.swap(runs);
+        _words.clear();
+        _cardinality = 0;
+        for(std::size_t idx = 0; idx < _values.size(); idx += 2)
+            _cardinality += _values[idx+1] - _values[idx] + 1;
+        normalize();
+    }
+
+    void to_runs(ValueVectorT& runs)const
+    {
+        if(_kind == run_kind)
+        {
+            runs = _values;
+            return;
+        }
+        runs.clear();
+        unsigned pos = 0, first, last;
+        while(next_run(pos, first, last))
+        {
+            runs.push_back(static_cast<value_type>(first));
+            runs.push_back(static_cast<value_type>(last));
+        }
+    }
+
+    void to_words(WordVectorT& words)const
+    {
+        if(_kind == bitmap_kind)
+        {
+            words = _words;
+            return;
+        }
+        words.assign(word_count, 0);
+        unsigned pos = 0, first, last;
+        while(next_run(pos, first, last))
+            set_range(words, first, last, true);
+    }
+
+    // Index of the run containing value or the first run after it
+    std::size_t find_run(unsigned value)const
+    {
+        std::size_t lwb = 0, upb = _values.size() / 2;
+        while(lwb < upb)
+        {
+            std::size_t mid = (lwb + upb) / 2;
+            if(_values[2*mid+1] < value)
+                lwb = mid + 1;
+            else
+                upb = mid;
+        }
+        return 2*lwb;
+    }
+
+    static void push_run(ValueVectorT& runs, unsigned first, unsigned last)
+    {
+        if(!runs.empty() && static_cast<unsigned>(runs.back()) + 1 >= first)
+            runs.back() = static_cast<value_type>((std::max)(last, static_cast<unsigned>(runs.back())));
+        else
+        {
+            runs.push_back(static_cast<value_type>(first));
+            runs.push_back(static_cast<value_type>(last));
+        }
+    }
+
+    static void unite_runs(ValueVectorT& result, const ValueVectorT& lhs, const ValueVectorT& rhs)
+    {
+        result.clear();
+        std::size_t lhs_idx = 0, rhs_idx = 0;
+        while(lhs_idx < lhs.size() || rhs_idx < rhs.size())
+        {
+            if(rhs_idx == rhs.size() || (lhs_idx < lhs.size() && lhs[lhs_idx] <= rhs[rhs_idx]))
+            {
+                push_run(result, lhs[lhs_idx], lhs[lhs_idx+1]);
+                lhs_idx += 2;
+            }
+            else
+            {
+                push_run(result, rhs[rhs_idx], rhs[rhs_idx+1]);
+                rhs_idx += 2;
+            }
+        }
+    }
+
+    static void intersect_runs(ValueVectorT& result, const ValueVectorT& lhs, const ValueVectorT& rhs)
+    {
+        result.clear();
+        std::size_t lhs_idx = 0, rhs_idx = 0;
+        while(lhs_idx < lhs.size() && rhs_idx < rhs.size())
+        {
+            unsigned first = (std::max)(lhs[lhs_idx],   rhs[rhs_idx]);
+            unsigned last  = (std::min)(lhs[lhs_idx+1], rhs[rhs_idx+1]);
+            if(first <= last)
+                push_run(result, first, last);
+            if(lhs[lhs_idx+1] < rhs[rhs_idx+1])
+                lhs_idx += 2;
+            else
+                rhs_idx += 2;
+        }
+    }
+
+    static void subtract_runs(ValueVectorT& result, const ValueVectorT& lhs, const ValueVectorT& rhs)
+    {
+        result.clear();
+        std::size_t rhs_idx = 0;
+        for(std::size_t lhs_idx = 0; lhs_idx < lhs.size(); lhs_idx += 2)
+        {
+            unsigned first = lhs[lhs_idx], last = lhs[lhs_idx+1];
+            while(rhs_idx < rhs.size() && rhs[rhs_idx+1] < first)
+                rhs_idx += 2;
+            // Runs of rhs that overlap [first,last] cut it into pieces
+            std::size_t cut_idx = rhs_idx;
+            bool rest = true;
+            while(cut_idx < rhs.size() && rhs[cut_idx] <= last)
+            {
+                if(first < rhs[cut_idx])
+                    push_run(result, first, rhs[cut_idx] - 1u);
+                if(rhs[cut_idx+1] >= last)
+                {
+                    rest = false;
+                    break;
+                }
+                first = rhs[cut_idx+1] + 1u;
+                cut_idx += 2;
+            }
+            if(rest)
+                push_run(result, first, last);
+        }
+    }
+
+    static void set_range(WordVectorT& words, unsigned first, unsigned last, bool value)
+    {
+        std::size_t first_word = first / word_bits, last_word = last / word_bits;
+        word_type first_mask = ~word_type(0) << (first % word_bits);
+        word_type last_mask  = ~word_type(0) >> (word_bits - 1 - last % word_bits);
+        if(first_word == last_word)
+            first_mask &= last_mask;
+        for(std::size_t idx = first_word; idx <= last_word; idx++)
+        {
+            word_type mask = idx == first_word ? first_mask : idx == last_word ? last_mask : ~word_type(0);
+            if(value)
+                words[idx] |= mask;
+            else
+                words[idx] &= ~mask;
+        }
+    }
+
+    // Find the first bit at or after pos that equals value
+    static bool find_bit(const WordVectorT& words, unsigned pos, bool value, unsigned& found)
+    {
+        std::size_t idx = pos / word_bits;
+        word_type word = (value ? words[idx] : ~words[idx]) & (~word_type(0) << (pos % word_bits));
+        while(word == 0)
+        {
+            if(++idx == word_count)
+                return false;
+            word = value ? words[idx] : ~words[idx];
+        }
+        found = static_cast<unsigned>(idx * word_bits + count_trailing_zeros(word));
+        return true;
+    }
+
+    static std::size_t count_bits(const WordVectorT& words)
+    {
+        std::size_t count = 0;
+        for(int idx = 0; idx < word_count; idx++)
+            count += popcount(words[idx]);
+        return count;
+    }
+
+    // Count the bits of the words that contain the values [first,last]
+    static std::size_t count_bits(const WordVectorT& words, unsigned first, unsigned last)
+    {
+        std::size_t count = 0;
+        for(unsigned idx = first / word_bits; idx <= last / word_bits; idx++)
+            count += popcount(words[idx]);
+        return count;
+    }
+
+    static unsigned popcount(word_type word)
+    {
+#ifdef __GNUC__
+        return __builtin_popcountll(word);
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    static unsigned count_trailing_zeros(word_type word)
+    {
+        BOOST_ASSERT(word != 0);
+#ifdef __GNUC__
+        return __builtin_ctzll(word);
+#else
+        unsigned count = 0;
+        while(!(word & 1)) { word >>= 1; count++; }
+        return count;
+#endif
+    }
+
+    static unsigned count_leading_zeros(word_type word)
+    {
+        BOOST_ASSERT(word != 0);
+#ifdef __GNUC__
+        return __builtin_clzll(word);
+#else
+        unsigned count = 0;
+        while(!(word >> (word_bits - 1))) { word <<= 1; count++; }
+        return count;
+#endif
+    }
+
+private:
+    value_type   _key;
+    kind_type    _kind;
+    std::size_t  _cardinality;
+    ValueVectorT _values; // sorted values or pairs of first and last values of runs
+    WordVectorT  _words;
+};
+
+
+/// Compressed interval set for integral domains of up to 32 bits
+/**
+    <b>bitmap_interval_set</b> has the semantics of an <b>interval_set</b>
+    for integral domains. Instead of an interval per tree node it stores
+    the elements in chunks of 2^16 values that are arrays, bitmaps or runs,
+    like roaring bitmaps do. For millions of short intervals, e.g. sets of
+    identifiers, this needs a fraction of the memory of an interval_set, and
+    union, intersection and difference of dense chunks are word operations.
+
+    Iteration yields the maximal intervals of the set as closed intervals.
+
+    <tt>Interval::atomize</tt> and <tt>Interval::cluster</tt> convert between
+    bitmap_interval_sets and element sets without inserting single elements
+    into a tree.
+*/
+template <typename DomainT>
+class bitmap_interval_set
+{
+    BOOST_STATIC_ASSERT(std::numeric_limits<DomainT>::is_integer);
+    BOOST_STATIC_ASSERT(sizeof(DomainT) <= sizeof(boost::uint32_t));
+
+public:
+    typedef bitmap_interval_set<DomainT> type;
+
+    /// The domain type of the set
+    typedef DomainT   domain_type;
+    /// The codomaintype is the same as domain_type
+    typedef DomainT   codomain_type;
+
+    /// The interval type of the set
+    typedef itl::interval<DomainT> interval_type;
+    /// Comparison functor for intervals
+    typedef exclusive_less<interval_type> key_compare;
+
+    typedef interval_type key_type;
+    typedef interval_type data_type;
+    typedef interval_type value_type;
+
+    /// The corresponding atomized type representing this interval container of elements
+    typedef itl::set<DomainT> atomized_type;
+
+    typedef std::size_t size_type;
+
+    /// Keys of elements: Domain values mapped to 32 bit unsigned preserving order
+    typedef boost::uint32_t element_key_type;
+
+private:
+    typedef std::vector<bitmap_chunk> ChunkVectorT;
+    typedef typename ChunkVectorT::iterator       chunk_iterator;
+    typedef typename ChunkVectorT::const_iterator chunk_const_iterator;
+
+public:
+    /// const_iterator for iteration over the maximal intervals of the set
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef interval_type             value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef const interval_type*      pointer;
+        typedef const interval_type&      reference;
+
+        const_iterator(): _chunks(0), _index(0), _next_index(0), _next_pos(0), _first(0) {}
+        const_iterator(const ChunkVectorT& chunks, std::size_t index)
+            : _chunks(&chunks), _index(index), _next_index(index), _next_pos(0), _first(0)
+        { fetch(); }
+
+        reference operator*()const  { return _current; }
+        pointer   operator->()const { return &_current; }
+
+        const_iterator& operator++() { fetch(); return *this; }
+        const_iterator  operator++(int) { const_iterator it_ = *this; fetch(); return it_; }
+
+        bool operator == (const const_iterator& rhs)const
+        { return _index == rhs._index && (_index == _chunks->size() || _first == rhs._first); }
+        bool operator != (const const_iterator& rhs)const { return !(*this == rhs); }
+
+    private:
+        void fetch()
+        {
+            unsigned first, last;
+            _index = _next_index;
+            while(_index < _chunks->size() && !(*_chunks)[_index].next_run(_next_pos, first, last))
+            {
+                _next_pos = 0;
+                _next_index = ++_index;
+            }
+            if(_index == _chunks->size())
+                return;
+
+            _first = key_of((*_chunks)[_index].key(), first);
+            element_key_type upper = key_of((*_chunks)[_index].key(), last);
+            // Runs that end at the end of a chunk continue in the next chunk
+            while(last == bitmap_chunk::value_limit && _next_index + 1 < _chunks->size()
+                  && (*_chunks)[_next_index + 1].key() == (*_chunks)[_next_index].key() + 1
+                  && (*_chunks)[_next_index + 1].contains(0))
+            {
+                _next_pos = 0;
+                (*_chunks)[++_next_index].next_run(_next_pos, first, last);
+                upper = key_of((*_chunks)[_next_index].key(), last);
+            }
+            _current = closed_interval(domain_of(_first), domain_of(upper));
+        }
+
+    private:
+        const ChunkVectorT* _chunks;
+        std::size_t         _index;
+        std::size_t         _next_index;
+        unsigned            _next_pos;
+        element_key_type    _first;
+        interval_type       _current;
+    };
+
+    typedef const_iterator iterator;
+
+public:
+    /// Default constructor for the empty set
+    bitmap_interval_set(){}
+
+    /// Constructor for a single element
+    explicit bitmap_interval_set(const domain_type& value) { add(value); }
+
+    /// Constructor for a single interval
+    explicit bitmap_interval_set(const interval_type& itv) { add(itv); }
+
+    void swap(bitmap_interval_set& src) { _chunks.swap(src._chunks); }
+
+    /// sets the container empty
+    void clear() { _chunks.clear(); }
+
+    /// is the container empty
+    bool empty()const { return _chunks.empty(); }
+
+    /// Does the container contain the element \c x
+    bool contains(const DomainT& x)const
+    {
+        element_key_type key = key_of(x);
+        chunk_const_iterator chunk_ = find_chunk(key >> 16);
+        return chunk_ != _chunks.end() && chunk_->contains(key & bitmap_chunk::value_limit);
+    }
+
+    /// Does the container contain the interval x
+    bool contains(const interval_type& x)const
+    {
+        if(x.empty())
+            return true;
+        element_key_type first = key_of(x.first()), last = key_of(x.last());
+        chunk_const_iterator chunk_ = find_chunk(first >> 16);
+        for(element_key_type high = first >> 16; ; ++high, ++chunk_)
+        {
+            if(chunk_ == _chunks.end() || chunk_->key() != high)
+                return false;
+            if(!chunk_->contains(high == first >> 16 ? first & bitmap_chunk::value_limit : 0,
+                                 high == last  >> 16 ? last  & bitmap_chunk::value_limit : bitmap_chunk::value_limit))
+                return false;
+            if(high == last >> 16)
+                return true;
+        }
+    }
+
+    /// Does the container contain the set \c sub
+    bool contains(const bitmap_interval_set& sub)const
+    {
+        bitmap_interval_set rest(sub);
+        rest -= *this;
+        return rest.empty();
+    }
+
+    /// <tt>*this</tt> is subset of <tt>super</tt>
+    bool contained_in(const bitmap_interval_set& super)const { return super.contains(*this); }
+
+    /// lower bound of all elements in the set
+    DomainT lower()const
+    { return empty()? interval_type().lower() : first(); }
+    /// upper bound of all elements in the set
+    DomainT upper()const
+    { return empty()? interval_type().upper() : last(); }
+
+    /// The least element of the set
+    DomainT first()const
+    { return domain_of(key_of(_chunks.front().key(), _chunks.front().first_value())); }
+    /// The greatest element of the set
+    DomainT last()const
+    { return domain_of(key_of(_chunks.back().key(), _chunks.back().last_value())); }
+
+    /// Number of elements in the set
+    size_type cardinality()const
+    {
+        size_type count = 0;
+        for(chunk_const_iterator chunk_ = _chunks.begin(); chunk_ != _chunks.end(); ++chunk_)
+            count += chunk_->cardinality();
+        return count;
+    }
+    size_type size()const { return cardinality(); }
+
+    /// Number of maximal intervals. This needs a pass over the set.
+    std::size_t interval_count()const { return iterative_size(); }
+    std::size_t iterative_size()const
+    {
+        std::size_t count = 0;
+        for(const_iterator it_ = begin(); it_ != end(); ++it_)
+            count++;
+        return count;
+    }
+
+    /// Number of chunks of 2^16 values
+    std::size_t chunk_count()const { return _chunks.size(); }
+
+    const_iterator begin()const { return const_iterator(_chunks, 0); }
+    const_iterator end()const   { return const_iterator(_chunks, _chunks.size()); }
+
+    /// Add a single element \c x to the set
+    bitmap_interval_set& add(const DomainT& x)
+    { element_key_type key = key_of(x); add_(key, key); return *this; }
+    /// Add an interval of elements \c x to the set
+    bitmap_interval_set& add(const interval_type& x)
+    { if(!x.empty()) add_(key_of(x.first()), key_of(x.last())); return *this; }
+
+    /// Add an interval of elements \c x; chunks are found without a hint
+    iterator add(iterator, const interval_type& x) { add(x); return end(); }
+
+    /// Subtract a single element \c x from the set
+    bitmap_interval_set& subtract(const DomainT& x)
+    { element_key_type key = key_of(x); subtract_(key, key); return *this; }
+    /// Subtract an interval of elements \c x from the set
+    bitmap_interval_set& subtract(const interval_type& x)
+    { if(!x.empty()) subtract_(key_of(x.first()), key_of(x.last())); return *this; }
+
+    /// Insertion and addition are the same for sets
+    bitmap_interval_set& insert(const DomainT& x)       { return add(x); }
+    bitmap_interval_set& insert(const interval_type& x) { return add(x); }
+    /// Erasure and subtraction are the same for sets
+    bitmap_interval_set& erase(const DomainT& x)       { return subtract(x); }
+    bitmap_interval_set& erase(const interval_type& x) { return subtract(x); }
+
+    bitmap_interval_set& operator += (const DomainT& x)       { return add(x); }
+    bitmap_interval_set& operator += (const interval_type& x) { return add(x); }
+    bitmap_interval_set& operator += (const bitmap_interval_set& x2);
+
+    bitmap_interval_set& operator -= (const DomainT& x)       { return subtract(x); }
+    bitmap_interval_set& operator -= (const interval_type& x) { return subtract(x); }
+    bitmap_interval_set& operator -= (const bitmap_interval_set& x2);
+
+    bitmap_interval_set& operator *= (const DomainT& x)
+    { return *this *= bitmap_interval_set(x); }
+    bitmap_interval_set& operator *= (const interval_type& x)
+    { return *this *= bitmap_interval_set(x); }
+    bitmap_interval_set& operator *= (const bitmap_interval_set& x2);
+
+    /// Insert all elements into the element container \c result in ascending order
+    template<class ElementContainerT>
+    void atomize(ElementContainerT& result)const
+    {
+        for(chunk_const_iterator chunk_ = _chunks.begin(); chunk_ != _chunks.end(); ++chunk_)
+        {
+            unsigned pos = 0, first, last;
+            while(chunk_->next_run(pos, first, last))
+                for(unsigned value = first; value <= last; value++)
+                    result.insert(result.end(), domain_of(key_of(chunk_->key(), value)));
+        }
+    }
+
+    /// Add all elements of the element container \c src, that is ordered by \c std::less
+    template<class ElementContainerT>
+    void cluster(const ElementContainerT& src)
+    {
+        bitmap_interval_set clustered;
+        bitmap_chunk::ValueVectorT values;
+        element_key_type high = 0;
+        const_FORALL(typename ElementContainerT, element_, src)
+        {
+            element_key_type key = key_of(ElementContainerT::key_value(element_));
+            if(!values.empty() && (key >> 16) != high)
+                clustered.append_chunk(high, values);
+            high = key >> 16;
+            values.push_back(static_cast<bitmap_chunk::value_type>(key & bitmap_chunk::value_limit));
+        }
+        if(!values.empty())
+            clustered.append_chunk(high, values);
+
+        if(empty())
+            swap(clustered);
+        else
+            *this += clustered;
+    }
+
+    const std::string as_string()const
+    {
+        std::string res("");
+        for(const_iterator it_ = begin(); it_ != end(); ++it_)
+            res += (*it_).as_string();
+        return res;
+    }
+
+    bool operator == (const bitmap_interval_set& rhs)const { return _chunks == rhs._chunks; }
+
+    template<typename IteratorT>
+    static const key_type& key_value(IteratorT& value_){ return (*value_); }
+
+    template<typename IteratorT>
+    static codomain_type codomain_value(IteratorT& value_)
+    { return (*value_).empty()? codomain_type() : (*value_).first(); }
+
+    static value_type make_domain_element(const domain_type& dom_val, const codomain_type&)
+    { return value_type(interval_type(dom_val)); }
+
+    static value_type make_segment(const interval_type& itv, const codomain_type&)
+    { return itv; }
+
+    /// Map a domain value to its key. Keys preserve the order of domain values.
+    static element_key_type key_of(const DomainT& value)
+    {
+        return std::numeric_limits<DomainT>::is_signed
+            ? static_cast<element_key_type>(static_cast<boost::int32_t>(value)) ^ 0x80000000u
+            : static_cast<element_key_type>(value);
+    }
+
+    static DomainT domain_of(element_key_type key)
+    {
+        return std::numeric_limits<DomainT>::is_signed
+            ? static_cast<DomainT>(static_cast<boost::int32_t>(key ^ 0x80000000u))
+            : static_cast<DomainT>(key);
+    }
+
+private:
+    static element_key_type key_of(unsigned high, unsigned low)
+    { return (static_cast<element_key_type>(high) << 16) | low; }
+
+    chunk_const_iterator find_chunk(element_key_type high)const
+    {
+        chunk_const_iterator chunk_ = lower_chunk(_chunks.begin(), _chunks.end(), high);
+        return chunk_ != _chunks.end() && chunk_->key() == high ? chunk_ : _chunks.end();
+    }
+
+    template<class IteratorT>
+    static IteratorT lower_chunk(IteratorT first, IteratorT past, element_key_type high)
+    {
+        // Appending is the common case
+        if(first == past || (past-1)->key() < high)
+            return past;
+        std::size_t count = past - first;
+        while(count > 0)
+        {
+            std::size_t half = count / 2;
+            if((first + half)->key() < high)
+            {
+                first += half + 1;
+                count -= half + 1;
+            }
+            else
+                count = half;
+        }
+        return first;
+    }
+
+    void add_(element_key_type first, element_key_type last);
+    void subtract_(element_key_type first, element_key_type last);
+
+    void append_chunk(element_key_type high, bitmap_chunk::ValueVectorT& values)
+    {
+        BOOST_ASSERT(_chunks.empty() || _chunks.back().key() < high);
+        _chunks.push_back(bitmap_chunk(high));
+        _chunks.back().assign_values(values);
+    }
+
+private:
+    ChunkVectorT _chunks; // sorted by key, no empty chunks
+};
+
+
+template <typename DomainT>
+void bitmap_interval_set<DomainT>::add_(element_key_type first, element_key_type last)
+{
+    chunk_iterator chunk_ = lower_chunk(_chunks.begin(), _chunks.end(), first >> 16);
+    for(element_key_type high = first >> 16; ; ++high, ++chunk_)
+    {
+        if(chunk_ == _chunks.end() || chunk_->key() != high)
+            chunk_ = _chunks.insert(chunk_, bitmap_chunk(high));
+        chunk_->add(high == first >> 16 ? first & bitmap_chunk::value_limit : 0,
+                    high == last  >> 16 ? last  & bitmap_chunk::value_limit : bitmap_chunk::value_limit);
+        if(high == last >> 16)
+            return;
+    }
+}
+
+
+template <typename DomainT>
+void bitmap_interval_set<DomainT>::subtract_(element_key_type first, element_key_type last)
+{
+    chunk_iterator chunk_ = lower_chunk(_chunks.begin(), _chunks.end(), first >> 16);
+    chunk_iterator kept_  = chunk_;
+    for(; chunk_ != _chunks.end() && chunk_->key() <= (last >> 16); ++chunk_)
+    {
+        element_key_type high = chunk_->key();
+        chunk_->subtract(high == first >> 16 ? first & bitmap_chunk::value_limit : 0,
+                         high == last  >> 16 ? last  & bitmap_chunk::value_limit : bitmap_chunk::value_limit);
+        if(!chunk_->empty())
+            (kept_++)->swap(*chunk_);
+    }
+    _chunks.erase(kept_, chunk_);
+}
+
+
+template <typename DomainT>
+bitmap_interval_set<DomainT>& bitmap_interval_set<DomainT>
+    ::operator += (const bitmap_interval_set& x2)
+{
+    if(this == &x2 || x2.empty())
+        return *this;
+
+    ChunkVectorT joined;
+    joined.reserve(_chunks.size() + x2._chunks.size());
+    chunk_iterator       lhs_ = _chunks.begin();
+    chunk_const_iterator rhs_ = x2._chunks.begin();
+    while(lhs_ != _chunks.end() || rhs_ != x2._chunks.end())
+    {
+        if(rhs_ == x2._chunks.end() || (lhs_ != _chunks.end() && lhs_->key() < rhs_->key()))
+        {
+            joined.push_back(bitmap_chunk());
+            joined.back().swap(*lhs_++);
+        }
+        else if(lhs_ == _chunks.end() || rhs_->key() < lhs_->key())
+            joined.push_back(*rhs_++);
+        else
+        {
+            joined.push_back(bitmap_chunk());
+            joined.back().swap(*lhs_++);
+            joined.back().add(*rhs_++);
+        }
+    }
+    _chunks.swap(joined);
+    return *this;
+}
+
+
+template <typename DomainT>
+bitmap_interval_set<DomainT>& bitmap_interval_set<DomainT>
+    ::operator -= (const bitmap_interval_set& x2)
+{
+    if(this == &x2)
+    {
+        clear();
+        return *this;
+    }
+
+    chunk_iterator       kept_ = _chunks.begin();
+    chunk_const_iterator rhs_  = x2._chunks.begin();
+    for(chunk_iterator lhs_ = _chunks.begin(); lhs_ != _chunks.end(); ++lhs_)
+    {
+        rhs_ = lower_chunk(rhs_, x2._chunks.end(), lhs_->key());
+        if(rhs_ != x2._chunks.end() && rhs_->key() == lhs_->key())
+            lhs_->subtract(*rhs_);
+        if(!lhs_->empty())
+            (kept_++)->swap(*lhs_);
+    }
+    _chunks.erase(kept_, _chunks.end());
+    return *this;
+}
+
+
+template <typename DomainT>
+bitmap_interval_set<DomainT>& bitmap_interval_set<DomainT>
+    ::operator *= (const bitmap_interval_set& x2)
+{
+    if(this == &x2)
+        return *this;
+
+    chunk_iterator       kept_ = _chunks.begin();
+    chunk_const_iterator rhs_  = x2._chunks.begin();
+    for(chunk_iterator lhs_ = _chunks.begin(); lhs_ != _chunks.end(); ++lhs_)
+    {
+        rhs_ = lower_chunk(rhs_, x2._chunks.end(), lhs_->key());
+        if(rhs_ == x2._chunks.end() || rhs_->key() != lhs_->key())
+            continue;
+        lhs_->intersect(*rhs_);
+        if(!lhs_->empty())
+            (kept_++)->swap(*lhs_);
+    }
+    _chunks.erase(kept_, _chunks.end());
+    return *this;
+}
+
+
+template <typename DomainT>
+inline bool operator < (const bitmap_interval_set<DomainT>& lhs, const bitmap_interval_set<DomainT>& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+
+template <class Type>
+struct is_set<itl::bitmap_interval_set<Type> >
+{ enum{value = true}; };
+
+template <class Type>
+struct is_interval_container<itl::bitmap_interval_set<Type> >
+{ enum{value = true}; };
+
+template <class Type>
+struct is_interval_splitter<itl::bitmap_interval_set<Type> >
+{ enum{value = false}; };
+
+template <class Type>
+struct is_interval_joiner<itl::bitmap_interval_set<Type> >
+{ enum{value = true}; };
+
+template <class Type>
+struct is_neutron_absorber<itl::bitmap_interval_set<Type> >
+{ enum{value = false}; };
+
+template <class Type>
+struct is_neutron_emitter<itl::bitmap_interval_set<Type> >
+{ enum{value = false}; };
+
+template <class Type>
+struct type_to_string<itl::bitmap_interval_set<Type> >
+{
+    static std::string apply()
+    { return "bitmap_interval_set<"+ type_to_string<Type>::apply() +">"; }
+};
+
+}} // namespace itl boost
+
+#endif
+
+
@@ -0,0 +1,1052 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class itl::btree
+    a B+tree with linked leaves, that implements btree_set and btree_map
+--------------------------------------------------------------------*/
+#ifndef __itl_btree_JOFA_081022_H__
+#define __itl_btree_JOFA_081022_H__
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <new>
+#include <boost/assert.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/remove_const.hpp>
+
+/** Size of the element array of a btree leaf and of the key array of an
+    inner node. The default of 256 bytes spans four cache lines. */
+#ifndef ITL_BTREE_NODE_BYTES
+#define ITL_BTREE_NODE_BYTES 256
+#endif
+
+namespace boost{namespace itl
+{
+
+    template <class ValueT>
+    struct btree_identity
+    {
+        const ValueT& operator()(const ValueT& value)const { return value; }
+
+        /// Construct a copy of \c source at the uninitialized \c target
+        template <class SourceT>
+        static void construct(ValueT* target, SourceT& source)
+        { new(target) ValueT(source); }
+
+        /// Overwrite \c target by a copy of \c source
+        /** The copy is made aside, so \c target is unchanged, if it throws. */
+        template <class SourceT>
+        static void assign(ValueT& target, SourceT& source)
+        {
+            ValueT value(source);
+            using std::swap;
+            swap(target, value);
+        }
+    };
+
+    template <class PairT>
+    struct btree_select_first
+    {
+        const typename PairT::first_type& operator()(const PairT& value)const
+        { return value.first; }
+
+        /// Construct a copy of \c source at the uninitialized \c target
+        static void construct(PairT* target, const PairT& source)
+        { new(target) PairT(source); }
+
+        /** Construct an element of the key of \c source at the uninitialized
+            \c target and swap the data of \c source into it. So heavy data
+            are not copied, when elements are moved within the tree. */
+        template <class SourceT>
+        static void construct(PairT* target, SourceT& source)
+        {
+            new(target) PairT(source.first, typename PairT::second_type());
+            using std::swap;
+            swap(target->second, source.second);
+        }
+
+        /** Overwrite \c target by the key of \c source and swap the data of
+            \c source into it. The element is built aside, so \c target is
+            unchanged, if copying the key throws. */
+        template <class SourceT>
+        static void assign(PairT& target, SourceT& source)
+        {
+            typedef typename boost::remove_const<typename PairT::first_type>::type key_type;
+            PairT value(source.first, typename PairT::second_type());
+            using std::swap;
+            swap(value.second, source.second);
+            // The ordering of keys is invariant, so the key is swapped in place
+            swap(const_cast<key_type&>(target.first), const_cast<key_type&>(value.first));
+            swap(target.second, value.second);
+        }
+    };
+
+
+    /// A B+tree that keeps its elements in linked leaves
+    /**
+    Class template <b>itl::btree</b> is the common implementation of
+    <b>btree_set</b> and <b>btree_map</b>. Leaves store the elements in
+    arrays of <tt>ITL_BTREE_NODE_BYTES</tt>, inner nodes store copies of
+    the greatest key of each child, so a search touches few cache lines on
+    each level. Leaves are linked for in order iteration. An iterator is a
+    leaf and a slot in it, so it is incremented and decremented in constant
+    time.
+
+    Insertion and erasure move elements within and between leaves, so they
+    invalidate all iterators but end(). Erasure returns the position
+    behind the erased elements. A range of elements is rewritten leaf by
+    leaf by <tt>replace</tt>, that overwrites elements in place.
+
+    Keys of elements must not be changed in a way that changes their
+    ordering.
+
+    @author Joachim Faulhaber
+    */
+    template
+    <
+        typename KeyT,
+        typename ValueT,
+        class KeyOfValue,
+        class KeyCompare,
+        template<class>class Alloc = std::allocator
+    >
+    class btree
+    {
+    public:
+        typedef btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc> type;
+
+        typedef KeyT                  key_type;
+        typedef ValueT                value_type;
+        typedef KeyCompare            key_compare;
+        typedef std::size_t           size_type;
+        typedef std::ptrdiff_t        difference_type;
+        typedef value_type&           reference;
+        typedef const value_type&     const_reference;
+        typedef value_type*           pointer;
+        typedef const value_type*     const_pointer;
+
+        enum { leaf_capacity  = ITL_BTREE_NODE_BYTES / sizeof(ValueT) < 4 ? 4
+                              : ITL_BTREE_NODE_BYTES / sizeof(ValueT) };
+        enum { inner_capacity = ITL_BTREE_NODE_BYTES / sizeof(KeyT) < 4 ? 4
+                              : ITL_BTREE_NODE_BYTES / sizeof(KeyT) };
+
+    private:
+        struct inner_node;
+
+        struct node_header
+        {
+            inner_node* parent;
+            int         used;  // number of occupied slots
+            int         level; // 0 for leaves
+        };
+
+        struct leaf_node : public node_header
+        {
+            leaf_node* prev;
+            leaf_node* next;
+            // Elements are constructed in the first used slots only
+            typename boost::aligned_storage<sizeof(ValueT) * leaf_capacity,
+                                            boost::alignment_of<ValueT>::value>::type storage;
+
+            ValueT* values() { return static_cast<ValueT*>(static_cast<void*>(&storage)); }
+            const ValueT* values()const
+            { return static_cast<const ValueT*>(static_cast<const void*>(&storage)); }
+        };
+
+        struct inner_node : public node_header
+        {
+            KeyT         keys[inner_capacity]; // Greatest key of each child
+            node_header* children[inner_capacity];
+        };
+
+    public:
+        class iterator;
+        class const_iterator;
+        friend class iterator;
+        friend class const_iterator;
+
+        class iterator
+        {
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef ValueT                          value_type;
+            typedef std::ptrdiff_t                  difference_type;
+            typedef ValueT*                         pointer;
+            typedef ValueT&                         reference;
+
+            iterator(): _tree(0), _leaf(0), _slot(0) {}
+
+            reference operator*()const  { return _leaf->values()[_slot]; }
+            pointer   operator->()const { return _leaf->values() + _slot; }
+
+            iterator& operator++() { btree::increment(_leaf, _slot); return *this; }
+            iterator  operator++(int) { iterator it_ = *this; ++*this; return it_; }
+            iterator& operator--() { _tree->decrement(_leaf, _slot); return *this; }
+            iterator  operator--(int) { iterator it_ = *this; --*this; return it_; }
+
+            friend bool operator == (const iterator& lhs, const iterator& rhs)
+            { return lhs._leaf == rhs._leaf && lhs._slot == rhs._slot; }
+            friend bool operator != (const iterator& lhs, const iterator& rhs)
+            { return !(lhs == rhs); }
+
+        private:
+            friend class btree;
+            friend class const_iterator;
+            iterator(const btree* tree, leaf_node* leaf, int slot)
+                : _tree(tree), _leaf(leaf), _slot(slot) {}
+
+            const btree* _tree;
+            leaf_node*   _leaf;
+            int          _slot;
+        };
+
+        class const_iterator
+        {
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef ValueT                          value_type;
+            typedef std::ptrdiff_t                  difference_type;
+            typedef const ValueT*                   pointer;
+            typedef const ValueT&                   reference;
+
+            const_iterator(): _tree(0), _leaf(0), _slot(0) {}
+            const_iterator(const iterator& it_): _tree(it_._tree), _leaf(it_._leaf), _slot(it_._slot) {}
+
+            reference operator*()const  { return _leaf->values()[_slot]; }
+            pointer   operator->()const { return _leaf->values() + _slot; }
+
+            const_iterator& operator++() { btree::increment(_leaf, _slot); return *this; }
+            const_iterator  operator++(int) { const_iterator it_ = *this; ++*this; return it_; }
+            const_iterator& operator--() { _tree->decrement(_leaf, _slot); return *this; }
+            const_iterator  operator--(int) { const_iterator it_ = *this; --*this; return it_; }
+
+            friend bool operator == (const const_iterator& lhs, const const_iterator& rhs)
+            { return lhs._leaf == rhs._leaf && lhs._slot == rhs._slot; }
+            friend bool operator != (const const_iterator& lhs, const const_iterator& rhs)
+            { return !(lhs == rhs); }
+
+        private:
+            friend class btree;
+            const_iterator(const btree* tree, const leaf_node* leaf, int slot)
+                : _tree(tree), _leaf(leaf), _slot(slot) {}
+
+            const btree*     _tree;
+            const leaf_node* _leaf;
+            int              _slot;
+        };
+
+        typedef std::reverse_iterator<iterator>       reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    public:
+        btree(): _root(0), _height(0), _first(0), _last(0), _size(0) {}
+
+        btree(const btree& src): _root(0), _height(0), _first(0), _last(0), _size(0)
+        {
+            for(const_iterator it_ = src.begin(); it_ != src.end(); ++it_)
+                insert(*it_);
+        }
+
+        btree& operator = (const btree& src)
+        {
+            if(this != &src)
+            {
+                btree copy(src);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        ~btree(){ clear(); }
+
+        void swap(btree& src)
+        {
+            std::swap(_root,   src._root);
+            std::swap(_height, src._height);
+            std::swap(_first,  src._first);
+            std::swap(_last,   src._last);
+            std::swap(_size,   src._size);
+        }
+
+        void clear()
+        {
+            if(_root != 0)
+                destroy(_root);
+            _root = 0; _height = 0; _first = 0; _last = 0; _size = 0;
+        }
+
+        bool empty()const { return _size == 0; }
+        size_type size()const { return _size; }
+        size_type max_size()const { return static_cast<size_type>(-1) / sizeof(value_type); }
+
+        key_compare key_comp()const { return key_compare(); }
+
+        /// Number of inner levels above the leaves
+        int height()const { return _root == 0 ? 0 : _height; }
+
+        iterator begin() { return iterator(this, _first, 0); }
+        iterator end()   { return iterator(this, 0, 0); }
+        const_iterator begin()const { return const_iterator(this, _first, 0); }
+        const_iterator end()const   { return const_iterator(this, 0, 0); }
+
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend()   { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin()const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend()const   { return const_reverse_iterator(begin()); }
+
+        iterator lower_bound(const key_type& key)
+        { int idx; leaf_node* leaf = lower_leaf(key, idx); return iterator(this, leaf, idx); }
+        const_iterator lower_bound(const key_type& key)const
+        { int idx; leaf_node* leaf = lower_leaf(key, idx); return const_iterator(this, leaf, idx); }
+
+        iterator upper_bound(const key_type& key)
+        { int idx; leaf_node* leaf = upper_position(key, idx); return iterator(this, leaf, idx); }
+        const_iterator upper_bound(const key_type& key)const
+        { int idx; leaf_node* leaf = upper_position(key, idx); return const_iterator(this, leaf, idx); }
+
+        iterator find(const key_type& key)
+        { int idx; leaf_node* leaf = found_leaf(key, idx); return iterator(this, leaf, idx); }
+        const_iterator find(const key_type& key)const
+        { int idx; leaf_node* leaf = found_leaf(key, idx); return const_iterator(this, leaf, idx); }
+
+        size_type count(const key_type& key)const { int idx; return found_leaf(key, idx) == 0 ? 0 : 1; }
+
+        /** Insert \c value, if there is no element of an equivalent key.
+            Otherwise return the last element that is equivalent to \c value,
+            like std::set and std::map do. */
+        std::pair<iterator,bool> insert(const value_type& value);
+
+        /** Insert \c value like insert(value). If the key of \c value belongs
+            into the leaf of \c prior_, or into the last leaf for end(), it
+            is inserted there without a search from the root. */
+        iterator insert(iterator prior_, const value_type& value);
+
+        template<class InputIterator>
+        void insert(InputIterator first, InputIterator past)
+        { for(; first != past; ++first) insert(*first); }
+
+        /// Erase the element at \c victim and return the position behind it
+        iterator erase(iterator victim) { return erase_block(victim._leaf, victim._slot, 1); }
+
+        /// Erase the elements of [first, past) and return the position behind them
+        iterator erase(iterator first, iterator past)
+        {
+            if(first._leaf == _first && first._slot == 0 && past._leaf == 0)
+            {
+                clear();
+                return end();
+            }
+            return erase_block(first._leaf, first._slot,
+                               distance(first._leaf, first._slot, past._leaf, past._slot));
+        }
+
+        size_type erase(const key_type& key)
+        {
+            int idx;
+            leaf_node* leaf = found_leaf(key, idx);
+            if(leaf == 0)
+                return 0;
+            erase_block(leaf, idx, 1);
+            return 1;
+        }
+
+        /// Replace the elements of [first, past) by the elements of \c segments
+        /** The keys of \c segments must be ascending and ordered between the
+            elements in front of \c first and the elements from \c past on.
+            Elements are overwritten in place leaf by leaf. Surplus elements
+            are erased by blocks, missing ones are inserted behind the
+            overwritten ones. Data of \c segments are swapped into the tree.
+            \c SegmentsT is a vector of elements or of pairs of a key and its
+            data. */
+        template <class SegmentsT>
+        void replace(iterator first, iterator past, SegmentsT& segments);
+
+    private:
+        const key_type& key_of(const value_type& value)const { return KeyOfValue()(value); }
+        bool less(const key_type& lhs, const key_type& rhs)const { return _compare(lhs, rhs); }
+
+        // Index of the first item, whose key is not less than key
+        template <class ItemT, class KeyOfItem>
+        int lower_index(const ItemT* items, int size, const key_type& key, KeyOfItem key_of_item)const
+        {
+            int first = 0;
+            while(size > 0)
+            {
+                int half = size / 2;
+                if(less(key_of_item(items[first + half]), key)) { first += half + 1; size -= half + 1; }
+                else size = half;
+            }
+            return first;
+        }
+
+        // Index of the first item, whose key is greater than key
+        template <class ItemT, class KeyOfItem>
+        int upper_index(const ItemT* items, int size, const key_type& key, KeyOfItem key_of_item)const
+        {
+            int first = 0;
+            while(size > 0)
+            {
+                int half = size / 2;
+                if(!less(key, key_of_item(items[first + half]))) { first += half + 1; size -= half + 1; }
+                else size = half;
+            }
+            return first;
+        }
+
+        static const ValueT& last_value(const leaf_node* leaf)
+        { return leaf->values()[leaf->used-1]; }
+
+        static const KeyT& greatest_key(const node_header* node)
+        {
+            return node->level == 0
+                ? KeyOfValue()(last_value(static_cast<const leaf_node*>(node)))
+                : static_cast<const inner_node*>(node)->keys[node->used-1];
+        }
+
+        static int child_index(const inner_node* parent, const node_header* child)
+        {
+            int idx = 0;
+            while(parent->children[idx] != child)
+                ++idx;
+            return idx;
+        }
+
+        static bool rightmost(const node_header* node)
+        {
+            for(; node->parent != 0; node = node->parent)
+                if(node->parent->children[node->parent->used-1] != node)
+                    return false;
+            return true;
+        }
+
+        // Positions are a leaf and a slot in it. The end position has no leaf.
+        template <class LeafPtrT>
+        static void increment(LeafPtrT& leaf, int& slot)
+        {
+            BOOST_ASSERT(leaf != 0);
+            if(++slot == leaf->used)
+            {
+                leaf = leaf->next;
+                slot = 0;
+            }
+        }
+
+        template <class LeafPtrT>
+        void decrement(LeafPtrT& leaf, int& slot)const
+        {
+            if(leaf == 0)
+            {
+                BOOST_ASSERT(_last != 0);
+                leaf = _last;
+                slot = _last->used - 1;
+            }
+            else if(slot > 0)
+                --slot;
+            else
+            {
+                leaf = leaf->prev;
+                BOOST_ASSERT(leaf != 0);
+                slot = leaf->used - 1;
+            }
+        }
+
+        // Number of elements from position (leaf, slot) to (past_leaf, past_slot)
+        static size_type distance(const leaf_node* leaf, int slot, const leaf_node* past_leaf, int past_slot)
+        {
+            size_type count = 0;
+            for(; leaf != past_leaf; leaf = leaf->next, slot = 0)
+                count += leaf->used - slot;
+            return count + past_slot - slot;
+        }
+
+        // Moves the element at source to the uninitialized target
+        static void relocate(ValueT* target, ValueT& source)
+        {
+            KeyOfValue::construct(target, source);
+            source.~ValueT();
+        }
+
+        // True, if key is greater than the elements of the leaves in front
+        // of leaf and less than the elements of the leaves behind it
+        bool covers(const leaf_node* leaf, const key_type& key)const
+        {
+            return (leaf->prev == 0 || less(key_of(last_value(leaf->prev)), key))
+                && (leaf->next == 0 || less(key, key_of(leaf->next->values()[0])));
+        }
+
+        leaf_node* lower_leaf(const key_type& key, int& idx)const;
+        leaf_node* upper_leaf(const key_type& key, int& idx)const;
+        leaf_node* upper_position(const key_type& key, int& idx)const
+        {
+            idx = 0;
+            if(_root == 0)
+                return 0;
+            leaf_node* leaf = upper_leaf(key, idx);
+            if(idx == leaf->used)
+            {
+                leaf = leaf->next;
+                idx = 0;
+            }
+            return leaf;
+        }
+
+        leaf_node* found_leaf(const key_type& key, int& idx)const
+        {
+            leaf_node* leaf = lower_leaf(key, idx);
+            if(leaf != 0 && less(key, key_of(leaf->values()[idx])))
+            {
+                idx = 0;
+                return 0;
+            }
+            return leaf;
+        }
+
+        leaf_node*  new_leaf();
+        leaf_node*  new_root();
+        inner_node* new_inner(int level);
+        void destroy(node_header* node);
+
+        template <class SourceT>
+        iterator insert_at(leaf_node* leaf, int idx, SourceT& source);
+        leaf_node*  split_leaf(leaf_node* leaf, int keep);
+        inner_node* split_inner(inner_node* inner, int keep);
+        void link_sibling(node_header* left, node_header* right);
+        void update_max(node_header* node);
+
+        iterator erase_block(leaf_node* leaf, int slot, size_type count);
+        void remove_node(node_header* node);
+        node_header* merge(node_header* node, int& offset);
+        void shrink_root();
+
+    private:
+        node_header* _root;
+        int          _height;
+        leaf_node*   _first;
+        leaf_node*   _last;
+        size_type    _size;
+        key_compare  _compare;
+    };
+
+
+    //--------------------------------------------------------------------------
+    // Search
+    //--------------------------------------------------------------------------
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::leaf_node*
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::lower_leaf(const key_type& key, int& idx)const
+    {
+        // The first element that is not less than key is in the first child
+        // whose greatest key is not less than key.
+        idx = 0;
+        node_header* node = _root;
+        if(node == 0)
+            return 0;
+        while(node->level > 0)
+        {
+            inner_node* inner = static_cast<inner_node*>(node);
+            int child = lower_index(inner->keys, inner->used, key, btree_identity<KeyT>());
+            if(child == inner->used)
+                return 0;
+            node = inner->children[child];
+        }
+        leaf_node* leaf = static_cast<leaf_node*>(node);
+        idx = lower_index(leaf->values(), leaf->used, key, KeyOfValue());
+        if(idx == leaf->used)
+        {
+            idx = 0;
+            return 0;
+        }
+        return leaf;
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::leaf_node*
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::upper_leaf(const key_type& key, int& idx)const
+    {
+        // The first element that is greater than key is in the first child
+        // whose greatest key is greater than key. If there is none, the
+        // position behind the last element of the last leaf is returned.
+        node_header* node = _root;
+        while(node->level > 0)
+        {
+            inner_node* inner = static_cast<inner_node*>(node);
+            int child = upper_index(inner->keys, inner->used, key, btree_identity<KeyT>());
+            node = inner->children[child == inner->used ? inner->used-1 : child];
+        }
+        leaf_node* leaf = static_cast<leaf_node*>(node);
+        idx = upper_index(leaf->values(), leaf->used, key, KeyOfValue());
+        return leaf;
+    }
+
+
+    //--------------------------------------------------------------------------
+    // Nodes
+    //--------------------------------------------------------------------------
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::leaf_node*
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::new_leaf()
+    {
+        leaf_node* leaf = new(Alloc<leaf_node>().allocate(1)) leaf_node();
+        leaf->parent = 0;
+        leaf->used   = 0;
+        leaf->level  = 0;
+        leaf->prev   = 0;
+        leaf->next   = 0;
+        return leaf;
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::leaf_node*
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::new_root()
+    {
+        BOOST_ASSERT(_root == 0);
+        leaf_node* leaf = new_leaf();
+        _root = _first = _last = leaf;
+        _height = 0;
+        return leaf;
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::inner_node*
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::new_inner(int level)
+    {
+        inner_node* inner = new(Alloc<inner_node>().allocate(1)) inner_node();
+        inner->parent = 0;
+        inner->used   = 0;
+        inner->level  = level;
+        return inner;
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    void btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::destroy(node_header* node)
+    {
+        if(node->level == 0)
+        {
+            leaf_node* leaf = static_cast<leaf_node*>(node);
+            for(int idx = 0; idx < leaf->used; ++idx)
+                leaf->values()[idx].~ValueT();
+            leaf->~leaf_node();
+            Alloc<leaf_node>().deallocate(leaf, 1);
+        }
+        else
+        {
+            inner_node* inner = static_cast<inner_node*>(node);
+            for(int idx = 0; idx < inner->used; ++idx)
+                destroy(inner->children[idx]);
+            inner->~inner_node();
+            Alloc<inner_node>().deallocate(inner, 1);
+        }
+    }
+
+
+    //--------------------------------------------------------------------------
+    // Insertion
+    //--------------------------------------------------------------------------
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    std::pair<typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::iterator, bool>
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::insert(const value_type& value)
+    {
+        const key_type& key = key_of(value);
+
+        leaf_node* leaf;
+        int idx;
+        if(_root == 0)
+        {
+            leaf = new_root();
+            idx = 0;
+        }
+        else if(less(key_of(last_value(_last)), key))
+        {
+            // Appending is the most frequent case for ordered input
+            leaf = _last;
+            idx  = _last->used;
+        }
+        else
+        {
+            leaf = upper_leaf(key, idx);
+
+            // The element in front of the upper bound is equivalent, if it is not less
+            leaf_node* prior_leaf = idx > 0 ? leaf : leaf->prev;
+            int prior_idx = idx > 0 ? idx-1 : (prior_leaf == 0 ? 0 : prior_leaf->used-1);
+            if(prior_leaf != 0 && !less(key_of(prior_leaf->values()[prior_idx]), key))
+                return std::pair<iterator,bool>(iterator(this, prior_leaf, prior_idx), false);
+        }
+
+        return std::pair<iterator,bool>(insert_at(leaf, idx, value), true);
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::iterator
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::insert(iterator prior_, const value_type& value)
+    {
+        const key_type& key = key_of(value);
+        leaf_node* leaf = prior_._leaf == 0 ? _last : prior_._leaf;
+        if(leaf == 0 || !covers(leaf, key))
+            return insert(value).first;
+
+        int idx = upper_index(leaf->values(), leaf->used, key, KeyOfValue());
+        if(idx > 0 && !less(key_of(leaf->values()[idx-1]), key))
+            return iterator(this, leaf, idx-1);
+        return insert_at(leaf, idx, value);
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    template <class SourceT>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::iterator
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::insert_at(leaf_node* leaf, int idx, SourceT& source)
+    {
+        if(leaf->used == leaf_capacity)
+        {
+            // Ordered appends fill leaves completely. Otherwise leaves are halved.
+            int keep = (leaf == _last && idx == leaf->used) ? leaf->used : leaf->used / 2;
+            leaf_node* right = split_leaf(leaf, keep);
+            iterator inserted = (idx > keep || (idx == keep && right->used == 0))
+                ? insert_at(right, idx - keep, source)
+                : insert_at(leaf, idx, source);
+
+            link_sibling(leaf, right);
+            update_max(leaf);
+            update_max(right);
+            return inserted;
+        }
+
+        ValueT* values = leaf->values();
+        for(int pos = leaf->used; pos > idx; --pos)
+            relocate(values + pos, values[pos-1]);
+        KeyOfValue::construct(values + idx, source);
+        ++leaf->used;
+        ++_size;
+
+        if(idx == leaf->used-1 && leaf->parent != 0)
+            update_max(leaf);
+        return iterator(this, leaf, idx);
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::leaf_node*
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::split_leaf(leaf_node* leaf, int keep)
+    {
+        // The new right sibling is linked into the leaf chain but not yet into the parent
+        leaf_node* right = new_leaf();
+        for(int idx = keep; idx < leaf->used; ++idx)
+            relocate(right->values() + idx - keep, leaf->values()[idx]);
+        right->used = leaf->used - keep;
+        leaf->used  = keep;
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if(leaf->next != 0)
+            leaf->next->prev = right;
+        else
+            _last = right;
+        leaf->next = right;
+        return right;
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::inner_node*
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::split_inner(inner_node* inner, int keep)
+    {
+        inner_node* right = new_inner(inner->level);
+        for(int idx = keep; idx < inner->used; ++idx)
+        {
+            right->keys[idx-keep]     = inner->keys[idx];
+            right->children[idx-keep] = inner->children[idx];
+            right->children[idx-keep]->parent = right;
+            inner->keys[idx] = KeyT();
+        }
+        right->used = inner->used - keep;
+        inner->used = keep;
+        return right;
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    void btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::link_sibling(node_header* left, node_header* right)
+    {
+        // Insert right behind its left sibling into the parent of left
+        inner_node* parent = left->parent;
+        if(parent == 0)
+        {
+            inner_node* root = new_inner(left->level + 1);
+            root->used = 2;
+            root->keys[0]     = greatest_key(left);
+            root->children[0] = left;
+            root->keys[1]     = greatest_key(right);
+            root->children[1] = right;
+            left->parent = right->parent = root;
+            _root = root;
+            ++_height;
+            return;
+        }
+
+        int slot = child_index(parent, left) + 1;
+        inner_node* target = parent;
+        inner_node* sibling = 0;
+        if(parent->used == inner_capacity)
+        {
+            int keep = (slot == parent->used && rightmost(parent)) ? parent->used : parent->used / 2;
+            sibling = split_inner(parent, keep);
+            if(slot > keep || (slot == keep && sibling->used == 0))
+            {
+                target = sibling;
+                slot  -= keep;
+            }
+        }
+
+        for(int pos = target->used; pos > slot; --pos)
+        {
+            target->keys[pos]     = target->keys[pos-1];
+            target->children[pos] = target->children[pos-1];
+        }
+        target->keys[slot]     = greatest_key(right);
+        target->children[slot] = right;
+        right->parent = target;
+        ++target->used;
+        left->parent->keys[child_index(left->parent, left)] = greatest_key(left);
+
+        if(sibling != 0)
+        {
+            link_sibling(parent, sibling);
+            update_max(parent);
+            update_max(sibling);
+        }
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    void btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::update_max(node_header* node)
+    {
+        // Propagate the greatest key of node to its ancestors
+        while(node->parent != 0)
+        {
+            inner_node* parent = node->parent;
+            int slot = child_index(parent, node);
+            parent->keys[slot] = greatest_key(node);
+            if(slot != parent->used-1)
+                return;
+            node = parent;
+        }
+    }
+
+
+    //--------------------------------------------------------------------------
+    // Erasure
+    //--------------------------------------------------------------------------
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::iterator
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::erase_block(leaf_node* leaf, int slot, size_type count)
+    {
+        // Elements are erased leaf by leaf. The rest of a leaf is shifted
+        // once for each leaf. A sparse leaf is merged with a sibling, so the
+        // position behind the erased elements may move into that sibling.
+        while(count > 0)
+        {
+            BOOST_ASSERT(leaf != 0 && slot < leaf->used);
+            int erased = static_cast<int>(std::min<size_type>(count, leaf->used - slot));
+            ValueT* values = leaf->values();
+            for(int idx = slot; idx < slot + erased; ++idx)
+                values[idx].~ValueT();
+            for(int idx = slot + erased; idx < leaf->used; ++idx)
+                relocate(values + idx - erased, values[idx]);
+            leaf->used -= erased;
+            _size      -= erased;
+            count      -= erased;
+
+            if(leaf->used == 0)
+            {
+                leaf_node* next = leaf->next;
+                remove_node(leaf);
+                leaf = next;
+                slot = 0;
+            }
+            else
+            {
+                if(slot == leaf->used)
+                    update_max(leaf);
+                int offset;
+                leaf  = static_cast<leaf_node*>(merge(leaf, offset));
+                slot += offset;
+                if(slot == leaf->used)
+                {
+                    leaf = leaf->next;
+                    slot = 0;
+                }
+            }
+        }
+        shrink_root();
+        return iterator(this, leaf, slot);
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    void btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::remove_node(node_header* node)
+    {
+        // Unlink an empty node from the tree and deallocate it
+        BOOST_ASSERT(node->used == 0);
+        inner_node* parent = node->parent;
+
+        if(node->level == 0)
+        {
+            leaf_node* leaf = static_cast<leaf_node*>(node);
+            if(leaf->prev != 0) leaf->prev->next = leaf->next; else _first = leaf->next;
+            if(leaf->next != 0) leaf->next->prev = leaf->prev; else _last  = leaf->prev;
+            leaf->~leaf_node();
+            Alloc<leaf_node>().deallocate(leaf, 1);
+        }
+        else
+        {
+            inner_node* inner = static_cast<inner_node*>(node);
+            inner->~inner_node();
+            Alloc<inner_node>().deallocate(inner, 1);
+        }
+
+        if(parent == 0)
+        {
+            _root = 0;
+            _height = 0;
+            return;
+        }
+
+        int slot = child_index(parent, node);
+        for(int pos = slot+1; pos < parent->used; ++pos)
+        {
+            parent->keys[pos-1]     = parent->keys[pos];
+            parent->children[pos-1] = parent->children[pos];
+        }
+        --parent->used;
+        parent->keys[parent->used] = KeyT();
+
+        if(parent->used == 0)
+            remove_node(parent);
+        else
+        {
+            if(slot == parent->used)
+                update_max(parent);
+            int offset;
+            merge(parent, offset);
+        }
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    typename btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::node_header*
+        btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::merge(node_header* node, int& offset)
+    {
+        // A sparse node is merged with a sibling, if both fit into three
+        // quarters of a node. So erasing elements does not degrade the tree
+        // and merged nodes are not split again by the next insertion.
+        // The node that holds the slots of node afterwards is returned,
+        // offset is the index that the first slot of node has got there.
+        offset = 0;
+        inner_node* parent = node->parent;
+        int capacity = node->level == 0 ? static_cast<int>(leaf_capacity) : static_cast<int>(inner_capacity);
+        if(parent == 0 || (parent->used < 2) || (node->used > capacity/4))
+            return node;
+
+        int slot = child_index(parent, node);
+        node_header* left  = slot > 0 ? parent->children[slot-1] : node;
+        node_header* right = slot > 0 ? node : parent->children[slot+1];
+        if(left->used + right->used > (3*capacity)/4)
+            return node;
+
+        if(left->level == 0)
+        {
+            leaf_node* lhs = static_cast<leaf_node*>(left);
+            leaf_node* rhs = static_cast<leaf_node*>(right);
+            for(int idx = 0; idx < rhs->used; ++idx)
+                relocate(lhs->values() + lhs->used + idx, rhs->values()[idx]);
+        }
+        else
+        {
+            inner_node* lhs = static_cast<inner_node*>(left);
+            inner_node* rhs = static_cast<inner_node*>(right);
+            for(int idx = 0; idx < rhs->used; ++idx)
+            {
+                lhs->keys[lhs->used + idx]     = rhs->keys[idx];
+                lhs->children[lhs->used + idx] = rhs->children[idx];
+                rhs->children[idx]->parent = lhs;
+                rhs->keys[idx] = KeyT();
+            }
+        }
+        if(node == right)
+            offset = left->used;
+        left->used += right->used;
+        right->used = 0;
+
+        // left takes over the greatest key of right before right is removed
+        parent->keys[child_index(parent, left)] = greatest_key(left);
+        remove_node(right);
+        return left;
+    }
+
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    void btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::shrink_root()
+    {
+        while(_root != 0 && _root->level > 0 && _root->used == 1)
+        {
+            inner_node* root = static_cast<inner_node*>(_root);
+            _root = root->children[0];
+            _root->parent = 0;
+            --_height;
+            root->~inner_node();
+            Alloc<inner_node>().deallocate(root, 1);
+        }
+    }
+
+
+    //--------------------------------------------------------------------------
+    // Replacement
+    //--------------------------------------------------------------------------
+    template <typename KeyT, typename ValueT, class KeyOfValue, class KeyCompare, template<class>class Alloc>
+    template <class SegmentsT>
+    void btree<KeyT,ValueT,KeyOfValue,KeyCompare,Alloc>::replace(iterator first, iterator past, SegmentsT& segments)
+    {
+        size_type count = distance(first._leaf, first._slot, past._leaf, past._slot);
+        leaf_node* leaf = first._leaf;
+        int slot = first._slot;
+        typename SegmentsT::size_type seg = 0;
+
+        // The greatest key of a leaf changes, if its last element is overwritten
+        for(; seg < segments.size() && count > 0; ++seg, --count)
+        {
+            KeyOfValue::assign(leaf->values()[slot], segments[seg]);
+            if(++slot == leaf->used)
+            {
+                update_max(leaf);
+                leaf = leaf->next;
+                slot = 0;
+            }
+        }
+
+        if(count > 0)
+        {
+            erase_block(leaf, slot, count);
+            return;
+        }
+        if(seg == segments.size())
+            return;
+
+        // The remaining segments go in front of past, behind the last
+        // element for past == end()
+        if(leaf == 0)
+        {
+            leaf = _root == 0 ? new_root() : _last;
+            slot = leaf->used;
+        }
+        for(; seg < segments.size(); ++seg)
+        {
+            iterator inserted = insert_at(leaf, slot, segments[seg]);
+            leaf = inserted._leaf;
+            slot = inserted._slot + 1;
+        }
+    }
+
+}} // namespace itl boost
+
+#endif // __itl_btree_JOFA_081022_H__
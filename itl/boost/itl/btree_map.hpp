@@ -0,0 +1,207 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class itl::btree_map
+    a map on a B+tree, that can replace itl::map as implementation 
+    container of interval maps
+--------------------------------------------------------------------*/
+#ifndef __itl_btree_map_JOFA_081022_H__
+#define __itl_btree_map_JOFA_081022_H__
+
+#include <string>
+#include <boost/itl/notate.hpp>
+#include <boost/itl/type_traits/to_string.hpp>
+#include <boost/itl/predicates.hpp>
+#include <boost/itl/map.hpp>
+#include <boost/itl/btree.hpp>
+
+namespace boost{namespace itl
+{
+    /// a map that is implemented by a B+tree
+    /** 
+    Class template <b>itl::btree_map</b> provides the interface of 
+    <b>std::map</b> that interval maps use for their implementation
+    container. Like itl::map it does not insert neutral values, if 
+    \c Traits absorb neutrons. Searching touches fewer cache lines than 
+    in the red-black trees of <b>std::map</b>. Insertion and erasure 
+    invalidate iterators, other than for std::map, and erasure returns 
+    the position behind the erased elements.
+
+    @author Joachim Faulhaber
+    */
+    template 
+    <
+        typename KeyT, 
+        typename DataT, 
+        class Traits = itl::neutron_absorber,
+        template<class>class Compare = std::less,
+        template<class>class Alloc   = std::allocator 
+    >
+    class btree_map: private itl::btree<KeyT, std::pair<const KeyT, DataT>, 
+                                        btree_select_first<std::pair<const KeyT, DataT> >,
+                                        Compare<KeyT>, Alloc>
+    {
+    public:
+        typedef Alloc<typename std::pair<const KeyT, DataT> >  allocator_type;
+
+        typedef typename itl::btree_map<KeyT, DataT, Traits, Compare, Alloc> type;
+        typedef typename itl::btree<KeyT, std::pair<const KeyT, DataT>, 
+                                    btree_select_first<std::pair<const KeyT, DataT> >,
+                                    Compare<KeyT>, Alloc>      base_type;
+
+        typedef Traits traits;
+
+    public:
+        typedef KeyT                                       key_type;
+        typedef KeyT                                       domain_type;
+        typedef DataT                                      mapped_type;
+        typedef DataT                                      data_type;
+        typedef DataT                                      codomain_type;
+        typedef std::pair<const KeyT, DataT>               value_type;
+        typedef Compare<KeyT>                              key_compare;
+
+    public:
+        typedef typename base_type::pointer                pointer;
+        typedef typename base_type::const_pointer          const_pointer;
+        typedef typename base_type::reference              reference;
+        typedef typename base_type::const_reference        const_reference;
+        typedef typename base_type::iterator               iterator;
+        typedef typename base_type::const_iterator         const_iterator;
+        typedef typename base_type::size_type              size_type;
+        typedef typename base_type::difference_type        difference_type;
+        typedef typename base_type::reverse_iterator       reverse_iterator;
+        typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+        
+    public:
+        btree_map(){}
+        btree_map(const btree_map& src): base_type(src){}
+
+        btree_map& operator=(const btree_map& src) { base_type::operator=(src); return *this; } 
+        void swap(btree_map& src) { base_type::swap(src); }
+
+        using base_type::begin;
+        using base_type::end;
+        using base_type::rbegin;
+        using base_type::rend;
+
+        using base_type::size;
+        using base_type::max_size;
+        using base_type::empty;
+        using base_type::height;
+
+        using base_type::key_comp;
+
+        using base_type::erase;
+        using base_type::clear;
+        using base_type::find;
+        using base_type::count;
+
+        using base_type::lower_bound;
+        using base_type::upper_bound;
+
+        using base_type::replace;
+
+    public:
+        /** Checks if a key element is in the map */
+        bool contains(const KeyT& x)const { return !(find(x) == end()); }
+
+        std::pair<iterator,bool> insert(const value_type& value_pair)
+        {
+            if(Traits::absorbs_neutrons && value_pair.CONT_VALUE == DataT()) 
+                return std::pair<iterator,bool>(end(),true);
+            else
+                return base_type::insert(value_pair);
+        }
+
+        /** Insert \c key with the value of \c data, that is swapped into the
+            map: \c data gets a neutron, if it is inserted. So heavy values
+            are inserted without being copied. */
+        std::pair<iterator,bool> insert_moved(const KeyT& key, DataT& data)
+        {
+            if(Traits::absorbs_neutrons && data == DataT()) 
+                return std::pair<iterator,bool>(end(),true);
+            std::pair<iterator,bool> insertion = base_type::insert(value_type(key, DataT()));
+            if(insertion.WAS_SUCCESSFUL)
+            {
+                using std::swap;
+                swap((*insertion.ITERATOR).CONT_VALUE, data);
+            }
+            return insertion;
+        }
+
+        iterator insert(iterator prior_, const value_type& value_pair)
+        {
+            if(Traits::absorbs_neutrons && value_pair.CONT_VALUE == DataT()) 
+                return end();
+            else
+                return base_type::insert(prior_, value_pair);
+        }
+
+        size_t iterative_size()const { return size(); }
+
+        /** Erase the elements in *this map to which property \c hasProperty applies. 
+        Keep all the rest. */
+        template<template<class>class Predicate>
+        btree_map& erase_if()
+        {
+            iterator it = begin();
+            while(it != end())
+                if(Predicate<value_type>()(*it))
+                    it = erase(it); 
+                else ++it;
+            return *this;
+        }
+
+        /** Copy the elements in map \c src to which property \c hasProperty applies 
+        into \c *this map. */
+        template<template<class>class Predicate>
+        btree_map& assign_if(const btree_map& src)
+        {
+            clear();
+            for(const_iterator it = src.begin(); it != src.end(); ++it)
+                if(Predicate<value_type>()(*it)) 
+                    insert(*it); 
+            return *this;
+        }
+
+        /** Represent this map as string */
+        std::string as_string()const
+        { 
+            std::string repr;
+            for(const_iterator it = begin(); it != end(); ++it)
+            {
+                repr += "(";
+                repr += to_string<KeyT>::apply((*it).KEY_VALUE);
+                repr += "->";
+                repr += to_string<DataT>::apply((*it).CONT_VALUE);
+                repr += ")";
+            }
+            return repr;
+        }
+    };
+
+
+    template <typename KeyT, typename DataT, class Traits, template<class>class Compare, template<class>class Alloc>
+    inline bool operator == (const itl::btree_map<KeyT,DataT,Traits,Compare,Alloc>& lhs,
+                             const itl::btree_map<KeyT,DataT,Traits,Compare,Alloc>& rhs)
+    {
+        typedef typename itl::btree_map<KeyT,DataT,Traits,Compare,Alloc>::const_iterator const_iterator;
+        if(lhs.size() != rhs.size())
+            return false;
+        const_iterator rhs_ = rhs.begin();
+        for(const_iterator lhs_ = lhs.begin(); lhs_ != lhs.end(); ++lhs_, ++rhs_)
+            if(!((*lhs_).KEY_VALUE == (*rhs_).KEY_VALUE && (*lhs_).CONT_VALUE == (*rhs_).CONT_VALUE))
+                return false;
+        return true;
+    }
+
+}} // namespace itl boost
+
+#endif // __itl_btree_map_JOFA_081022_H__
+
@@ -0,0 +1,138 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class itl::btree_set
+    a set on a B+tree, that can replace itl::set as implementation 
+    container of interval sets
+--------------------------------------------------------------------*/
+#ifndef __itl_btree_set_JOFA_081022_H__
+#define __itl_btree_set_JOFA_081022_H__
+
+#include <string>
+#include <boost/itl/notate.hpp>
+#include <boost/itl/type_traits/to_string.hpp>
+#include <boost/itl/btree.hpp>
+
+namespace boost{namespace itl
+{
+    /// a set that is implemented by a B+tree
+    /** 
+    Class template <b>itl::btree_set</b> provides the interface of 
+    <b>std::set</b> that interval sets use for their implementation
+    container. Searching touches fewer cache lines than in the red-black 
+    trees of <b>std::set</b>. Insertion and erasure invalidate iterators,
+    other than for std::set, and erasure returns the position behind the
+    erased elements.
+
+    @author Joachim Faulhaber
+    */
+    template 
+    <
+        typename KeyT, 
+        template<class>class Compare = std::less,
+        template<class>class Alloc   = std::allocator 
+    >
+    class btree_set: private itl::btree<KeyT, KeyT, btree_identity<KeyT>, Compare<KeyT>, Alloc>
+    {
+    public:
+        typedef typename itl::btree_set<KeyT, Compare, Alloc> type;
+        typedef typename itl::btree<KeyT, KeyT, btree_identity<KeyT>, 
+                                    Compare<KeyT>, Alloc>     base_type;
+
+    public:
+        typedef KeyT     key_type;
+        typedef KeyT     value_type;
+        typedef KeyT     data_type;
+        typedef Compare<KeyT> key_compare;
+        typedef Compare<KeyT> value_compare;
+        typedef Alloc<KeyT>   allocator_type;
+
+    public:        
+        typedef typename base_type::pointer                pointer;
+        typedef typename base_type::const_pointer          const_pointer;
+        typedef typename base_type::reference              reference;
+        typedef typename base_type::const_reference        const_reference;
+        typedef typename base_type::iterator               iterator;
+        typedef typename base_type::const_iterator         const_iterator;
+        typedef typename base_type::size_type              size_type;
+        typedef typename base_type::difference_type        difference_type;
+        typedef typename base_type::reverse_iterator       reverse_iterator;
+        typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+
+    public:
+        btree_set(){}
+        btree_set(const btree_set& src): base_type(src){}
+
+        btree_set& operator=(const btree_set& src) { base_type::operator=(src); return *this; } 
+        void swap(btree_set& src) { base_type::swap(src); }
+
+        using base_type::begin;
+        using base_type::end;
+        using base_type::rbegin;
+        using base_type::rend;
+
+        using base_type::size;
+        using base_type::max_size;
+        using base_type::empty;
+        using base_type::height;
+
+        using base_type::key_comp;
+
+        using base_type::insert;
+        using base_type::erase;
+        using base_type::clear;
+        using base_type::find;
+        using base_type::count;
+
+        using base_type::lower_bound;
+        using base_type::upper_bound;
+
+        using base_type::replace;
+
+        value_compare value_comp()const { return value_compare(); }
+
+    public:
+        /// Checks if the element \c x is in the set
+        bool contains(const KeyT& x)const { return !(find(x) == end()); }
+
+        size_t iterative_size()const { return size(); }
+
+        /** Represent this set as string */
+        std::string as_string(const char* sep = " ")const
+        {
+            std::string repr;
+            for(const_iterator it_ = begin(); it_ != end(); ++it_)
+            {
+                if(it_ != begin())
+                    repr += sep;
+                repr += to_string<KeyT>::apply(*it_);
+            }
+            return repr;
+        }
+    };
+
+
+    template <typename KeyT, template<class>class Compare, template<class>class Alloc>
+    inline bool operator == (const itl::btree_set<KeyT,Compare,Alloc>& lhs,
+                             const itl::btree_set<KeyT,Compare,Alloc>& rhs)
+    {
+        typedef typename itl::btree_set<KeyT,Compare,Alloc>::const_iterator const_iterator;
+        if(lhs.size() != rhs.size())
+            return false;
+        const_iterator rhs_ = rhs.begin();
+        for(const_iterator lhs_ = lhs.begin(); lhs_ != lhs.end(); ++lhs_, ++rhs_)
+            if(!(*lhs_ == *rhs_))
+                return false;
+        return true;
+    }
+
+}} // namespace itl boost
+
+#endif // __itl_btree_set_JOFA_081022_H__
+
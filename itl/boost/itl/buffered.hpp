@@ -0,0 +1,297 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class buffered
+    Interval maps that collect additions in a log and merge them lazily
+--------------------------------------------------------------------*/
+#ifndef __itl_buffered_JOFA_081104_H__
+#define __itl_buffered_JOFA_081104_H__
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <boost/itl/interval.hpp>
+#include <boost/itl/functors.hpp>
+#include <boost/itl/interval_diff.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Buffer
+{
+    template <class IntervalT, class CodomainT>
+    struct lower_less
+    {
+        bool operator()(const std::pair<IntervalT, CodomainT>& lhs,
+                        const std::pair<IntervalT, CodomainT>& rhs)const
+        { return lhs.first.lower_less(rhs.first); }
+    };
+
+    /// Add the segments of \c older and \c newer to the empty map \c result in one sweep
+    /** Segments of both maps are cut at the borders of the other one and
+        appended to \c result in ascending order, so this takes O(n + m). */
+    template <class MapT>
+    void merge(MapT& result, const MapT& older, const MapT& newer)
+    {
+        typedef typename MapT::interval_type interval_type;
+        typedef typename MapT::codomain_type codomain_type;
+        typedef typename MapT::value_type    value_type;
+
+        Diff::cursor<MapT> left(older);
+        Diff::cursor<MapT> right(newer);
+        typename MapT::iterator prior_ = result.end();
+        interval_type piece;
+
+        while(!left.done() || !right.done())
+        {
+            if(right.done() || (!left.done() && left._rest.lower_less(right._rest)))
+            {
+                if(right.done() || left._rest.exclusive_less(right._rest))
+                    piece = left._rest;
+                else
+                    left._rest.left_surplus(piece, right._rest);
+                prior_ = result.add(prior_, value_type(piece, left.value()));
+                left.consume(piece);
+            }
+            else if(left.done() || right._rest.lower_less(left._rest))
+            {
+                if(left.done() || right._rest.exclusive_less(left._rest))
+                    piece = right._rest;
+                else
+                    right._rest.left_surplus(piece, left._rest);
+                prior_ = result.add(prior_, value_type(piece, right.value()));
+                right.consume(piece);
+            }
+            else
+            {
+                left._rest.intersect(piece, right._rest);
+                codomain_type sum = left.value();
+                typename MapT::codomain_combine()(sum, right.value());
+                prior_ = result.add(prior_, value_type(piece, sum));
+                left.consume(piece);
+                right.consume(piece);
+            }
+        }
+    }
+
+    /// Add the segments of \c newer to \c older
+    /** Maps of similar size are merged by one sweep. Few segments are added
+        to a large map one by one, which is faster than sweeping it. */
+    template <class MapT>
+    void merge_into(MapT& older, const MapT& newer)
+    {
+        enum { merge_ratio = 16 };
+        if(newer.iterative_size() * merge_ratio < older.iterative_size())
+        {
+            const_FORALL(typename MapT, it_, newer)
+                older.add(*it_);
+        }
+        else
+        {
+            MapT merged;
+            merge(merged, older, newer);
+            older.swap(merged);
+        }
+    }
+
+} // namespace Buffer
+
+
+/// An interval map that is optimized for many additions between queries
+/**
+    A <b>buffered</b> map wraps an interval map. Additions are appended to
+    a log of at most <tt>capacity()</tt> pairs. A full log is sorted and
+    split into chains of disjoint pairs, that are appended to maps of their
+    own. The chains are merged pairwise into a new <b>run</b>, a small map
+    of its own, so a sorted log of disjoint pairs is built in one pass and a
+    log of c chains in O(n log c). Runs are
+    tiered like in log structured merge trees: Whenever a run is at least
+    half as large as the run before it, or as the base map, both of them are
+    merged by a single sweep. So run sizes grow geometrically and every
+    segment is merged O(log(n/capacity)) times.
+
+    Queries compact the log and all runs into the base map first. Since
+    addition is commutative and associative the results are those of the
+    eager map. Only split maps may be split at other borders, where values
+    cancel out, because their borders depend on the order of additions
+    then. Subtractions, insertions and erasures are not buffered; they
+    compact the map and are applied to the base map directly.
+
+    Queries are const. They merge the log and the runs, which are
+    mutable, because merging changes the representation only. So a
+    buffered map must not be queried by several threads at once.
+
+    @author Joachim Faulhaber
+*/
+template <class MapT>
+class buffered
+{
+public:
+    typedef MapT                                        container_type;
+    typedef typename MapT::domain_type                  domain_type;
+    typedef typename MapT::codomain_type                codomain_type;
+    typedef typename MapT::interval_type                interval_type;
+    typedef typename MapT::value_type                   value_type;
+    typedef typename MapT::size_type                    size_type;
+    typedef typename MapT::const_iterator               const_iterator;
+
+    typedef std::pair<interval_type, codomain_type>     log_entry_type;
+    typedef std::vector<log_entry_type>                 log_type;
+
+    explicit buffered(size_type capacity = 4096): _capacity(capacity)
+    {
+        _log.reserve(_capacity);
+        // Runs are not empty and their sizes at least halve from run to run,
+        // so runs are never copied by reallocation
+        _runs.reserve(8 * sizeof(std::size_t));
+    }
+
+    /// Maximal number of pairs in the log
+    size_type capacity()const { return _capacity; }
+
+    /// Number of pairs in the log and number of runs, that are not yet merged
+    size_type log_size()const { return _log.size(); }
+    size_type run_count()const { return _runs.size(); }
+
+    /** @name Buffered updates */
+    //@{
+    buffered& add(const value_type& x)
+    {
+        if(x.KEY_VALUE.empty())
+            return *this;
+        _log.push_back(log_entry_type(x.KEY_VALUE, x.CONT_VALUE));
+        if(_log.size() >= _capacity)
+            flush();
+        return *this;
+    }
+
+    buffered& operator += (const value_type& x) { return add(x); }
+    //@}
+
+    /** @name Eager updates */
+    //@{
+    template <class OperandT>
+    buffered& subtract(const OperandT& x) { compact(); _base.subtract(x); return *this; }
+
+    template <class OperandT>
+    buffered& insert(const OperandT& x) { compact(); _base.insert(x); return *this; }
+
+    template <class OperandT>
+    buffered& erase(const OperandT& x) { compact(); _base.erase(x); return *this; }
+
+    template <class OperandT>
+    buffered& operator -= (const OperandT& x) { return subtract(x); }
+    //@}
+
+    /** @name Queries */
+    //@{
+    /// The wrapped map after merging the log and all runs into it
+    const container_type& container()const { compact(); return _base; }
+
+    const_iterator begin()const { return container().begin(); }
+    const_iterator end()const   { return container().end(); }
+
+    bool empty()const { return container().empty(); }
+    size_type iterative_size()const { return container().iterative_size(); }
+
+    template <class OperandT>
+    bool contains(const OperandT& x)const { return container().contains(x); }
+    //@}
+
+    /// Merge the log and all runs into the base map
+    void compact()const
+    {
+        flush();
+        while(!_runs.empty())
+            merge_newest();
+    }
+
+    void clear()
+    {
+        _log.clear();
+        _runs.clear();
+        _base.clear();
+    }
+
+    void swap(buffered& src)
+    {
+        std::swap(_capacity, src._capacity);
+        _log.swap(src._log);
+        _runs.swap(src._runs);
+        _base.swap(src._base);
+    }
+
+private:
+    // Sorts the log into a new run and merges runs of similar size
+    void flush()const
+    {
+        if(_log.empty())
+            return;
+
+        std::sort(_log.begin(), _log.end(),
+                  Buffer::lower_less<interval_type, codomain_type>());
+
+        // A chain ends, where a pair overlaps the pair before it
+        std::vector<std::size_t> chain_begin(1, 0);
+        for(std::size_t idx = 1; idx < _log.size(); idx++)
+            if(!_log[idx-1].first.exclusive_less(_log[idx].first))
+                chain_begin.push_back(idx);
+        chain_begin.push_back(_log.size());
+
+        // Chains are appended to maps of their own, that are merged pairwise by sweeps
+        std::size_t chain_count = chain_begin.size() - 1;
+        std::vector<MapT> chains(chain_count);
+        for(std::size_t chain = 0; chain < chain_count; chain++)
+        {
+            typename MapT::iterator prior_ = chains[chain].end();
+            for(std::size_t idx = chain_begin[chain]; idx < chain_begin[chain+1]; idx++)
+                prior_ = chains[chain].add(prior_, value_type(_log[idx].first, _log[idx].second));
+        }
+        for(std::size_t width = 1; width < chain_count; width *= 2)
+            for(std::size_t chain = 0; chain + width < chain_count; chain += 2*width)
+            {
+                MapT merged;
+                Buffer::merge(merged, chains[chain], chains[chain + width]);
+                chains[chain].swap(merged);
+                chains[chain + width].clear();
+            }
+        _log.clear();
+
+        if(chains[0].empty())
+            return;
+        _runs.push_back(MapT());
+        _runs.back().swap(chains[0]);
+
+        while(!_runs.empty() && older_run().iterative_size() < 2 * _runs.back().iterative_size())
+            merge_newest();
+    }
+
+    MapT& older_run()const { return _runs.size() < 2 ? _base : _runs[_runs.size() - 2]; }
+
+    // Merges the newest run into the run before it or into the base map.
+    // Runs, whose values cancel out, are dropped.
+    void merge_newest()const
+    {
+        Buffer::merge_into(older_run(), _runs.back());
+        _runs.pop_back();
+        if(!_runs.empty() && _runs.back().empty())
+            _runs.pop_back();
+    }
+
+private:
+    size_type                 _capacity;
+    mutable log_type          _log;
+    mutable std::vector<MapT> _runs;
+    mutable MapT              _base;
+};
+
+}} // namespace itl boost
+
+#endif
+
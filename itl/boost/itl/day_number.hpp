@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class day_number
+    Integer encoded domain adapter for boost::gregorian::date
+--------------------------------------------------------------------*/
+#ifndef __itl_day_number_JOFA_081031_H__
+#define __itl_day_number_JOFA_081031_H__
+
+#include <string>
+#include <ostream>
+#include <boost/assert.hpp>
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include <boost/itl/type_traits/difference.hpp>
+#include <boost/itl/type_traits/type_to_string.hpp>
+#include <boost/itl/type_traits/domain_conversion.hpp>
+
+namespace boost{namespace itl
+{
+
+/// A date, that is represented by the number of days since 1970-01-01
+/**
+    Intervals of boost::gregorian::date step and compare by date arithmetic,
+    which checks for special values at every <tt>++</tt>, <tt>--</tt> and
+    comparison. A day_number keeps a plain <tt>int</tt>, so
+    <tt>interval<day_number></tt> and interval containers of day_numbers
+    are as fast as those of <tt>int</tt>. Dates are converted only at the
+    boundary of the API:
+
+    <tt>day_number(date)</tt> and <tt>x.to_date()</tt> convert single values,
+    <tt>interval_cast<day_number>(date_interval)</tt> and
+    <tt>interval_cast<date>(day_interval)</tt> convert intervals.
+
+    Special values like <tt>not_a_date_time</tt> have no day_number.
+    Other than boost/itl/gregorian.hpp, this header can be included
+    at any position.
+
+    @author Joachim Faulhaber
+*/
+class day_number
+{
+public:
+    typedef int  rep_type;
+    typedef long difference_type;
+    typedef boost::gregorian::date date_type;
+
+    /// Julian day number of 1970-01-01
+    enum { epoch_julian_day = 2440588 };
+
+    day_number(): _rep(0) {}
+    explicit day_number(rep_type days): _rep(days) {}
+
+    /// Implicit conversion from dates at the API boundary
+    day_number(const date_type& date): _rep(julian_day(date) - epoch_julian_day) {}
+
+    date_type to_date()const
+    { return date_type(date_type::calendar_type::from_day_number(_rep + epoch_julian_day)); }
+
+    rep_type days()const { return _rep; }
+
+    day_number& operator ++ () { ++_rep; return *this; }
+    day_number& operator -- () { --_rep; return *this; }
+    day_number& operator += (difference_type days) { _rep += static_cast<rep_type>(days); return *this; }
+    day_number& operator -= (difference_type days) { _rep -= static_cast<rep_type>(days); return *this; }
+
+    const std::string as_string()const
+    { return boost::gregorian::to_simple_string(to_date()); }
+
+private:
+    static rep_type julian_day(const date_type& date)
+    {
+        BOOST_ASSERT(!date.is_special());
+        return static_cast<rep_type>(date.day_number());
+    }
+
+    rep_type _rep;
+};
+
+inline bool operator == (const day_number& lhs, const day_number& rhs) { return lhs.days() == rhs.days(); }
+inline bool operator != (const day_number& lhs, const day_number& rhs) { return lhs.days() != rhs.days(); }
+inline bool operator <  (const day_number& lhs, const day_number& rhs) { return lhs.days() <  rhs.days(); }
+inline bool operator <= (const day_number& lhs, const day_number& rhs) { return lhs.days() <= rhs.days(); }
+inline bool operator >  (const day_number& lhs, const day_number& rhs) { return lhs.days() >  rhs.days(); }
+inline bool operator >= (const day_number& lhs, const day_number& rhs) { return lhs.days() >= rhs.days(); }
+
+inline day_number operator + (day_number lhs, day_number::difference_type days) { return lhs += days; }
+inline day_number operator - (day_number lhs, day_number::difference_type days) { return lhs -= days; }
+
+inline day_number::difference_type operator - (const day_number& lhs, const day_number& rhs)
+{ return static_cast<day_number::difference_type>(lhs.days()) - rhs.days(); }
+
+template<class CharType, class CharTraits>
+std::basic_ostream<CharType, CharTraits>& operator <<
+  (std::basic_ostream<CharType, CharTraits>& stream, const day_number& x)
+{ return stream << x.to_date(); }
+
+
+template<>
+struct difference<day_number> { typedef day_number::difference_type type; };
+
+template<>
+struct domain_conversion<boost::gregorian::date, day_number>
+{
+    static boost::gregorian::date apply(const day_number& value){ return value.to_date(); }
+};
+
+template<>
+inline std::string type_to_string<day_number>::apply() { return "day_number"; }
+
+}} // namespace itl boost
+
+#endif
+
+
@@ -0,0 +1,252 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class fingerprinted; function fingerprint
+    Interval containers with an incrementally maintained content hash
+--------------------------------------------------------------------*/
+#ifndef __itl_fingerprinted_JOFA_081103_H__
+#define __itl_fingerprinted_JOFA_081103_H__
+
+#include <cstddef>
+#include <utility>
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/itl/notate.hpp>
+#include <boost/itl/interval.hpp>
+#include <boost/itl/interval_gaps.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Fingerprint
+{
+    /// Finalizer of splitmix64: Spreads the bits of hash values, that are summed up
+    inline boost::uint64_t mix(boost::uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    template <class DomainT>
+    std::size_t interval_hash(const itl::interval<DomainT>& itv)
+    {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, itv.lower());
+        boost::hash_combine(seed, itv.upper());
+        boost::hash_combine(seed, static_cast<unsigned>(itv.boundtypes()));
+        return seed;
+    }
+
+    template <class DomainT>
+    boost::uint64_t segment_hash(const itl::interval<DomainT>& itv)
+    { return mix(interval_hash(itv)); }
+
+    template <class IntervalT, class CodomainT>
+    boost::uint64_t segment_hash(const std::pair<IntervalT, CodomainT>& segment)
+    {
+        std::size_t seed = interval_hash(segment.first);
+        boost::hash_combine(seed, segment.second);
+        return mix(seed);
+    }
+
+} // namespace Fingerprint
+
+
+/// Hash of the segments of \c object, computed in linear time
+/** The fingerprint is the sum of hash values of the segments, that are
+    computed by <tt>boost::hash</tt> of bounds and associated values. So
+    it is independent of the order of computation and can be maintained
+    by fingerprinted containers. Equal containers have equal fingerprints.
+    Containers that are equal by elements, but split differently, have
+    different ones. */
+template <class ContainerT>
+boost::uint64_t fingerprint(const ContainerT& object)
+{
+    boost::uint64_t sum = 0;
+    const_FORALL(typename ContainerT, it_, object)
+        sum += Fingerprint::segment_hash(*it_);
+    return sum;
+}
+
+
+/// An interval container that maintains the fingerprint of its content
+/**
+    A <b>fingerprinted</b> container wraps an interval set or map. Every
+    update subtracts the hashes of the segments next to its operand from the
+    fingerprint and adds the hashes of the segments there afterwards, which
+    costs O(log n) plus the segments that are changed. In return
+    <tt>fingerprint()</tt> takes constant time, so checking whether a
+    container changed since a fingerprint was taken is O(1). Containers with
+    different fingerprints are unequal; equal fingerprints are confirmed by
+    comparing the contents.
+
+    @author Joachim Faulhaber
+*/
+template <class ContainerT>
+class fingerprinted
+{
+public:
+    typedef ContainerT                                  container_type;
+    typedef typename ContainerT::domain_type            domain_type;
+    typedef typename ContainerT::interval_type          interval_type;
+    typedef typename ContainerT::value_type             value_type;
+    typedef typename ContainerT::size_type              size_type;
+    typedef typename ContainerT::const_iterator         const_iterator;
+
+    fingerprinted(): _fingerprint(0) {}
+    explicit fingerprinted(const ContainerT& object)
+        : _object(object), _fingerprint(itl::fingerprint(object)) {}
+
+    /// The wrapped container
+    const container_type& container()const { return _object; }
+
+    /// Hash of the content; equal to <tt>itl::fingerprint(container())</tt>
+    boost::uint64_t fingerprint()const { return _fingerprint; }
+
+    const_iterator begin()const { return _object.begin(); }
+    const_iterator end()const   { return _object.end(); }
+    bool empty()const { return _object.empty(); }
+    size_type iterative_size()const { return _object.iterative_size(); }
+
+    template <class OperandT>
+    bool contains(const OperandT& x)const { return _object.contains(x); }
+
+    void clear() { _object.clear(); _fingerprint = 0; }
+
+    void swap(fingerprinted& src)
+    {
+        _object.swap(src._object);
+        std::swap(_fingerprint, src._fingerprint);
+    }
+
+    /** @name Updates of segments and elements */
+    //@{
+    template <class OperandT>
+    fingerprinted& add(const OperandT& x)
+    {
+        interval_type region = unhash(region_of(x));
+        _object.add(x);
+        rehash(region);
+        return *this;
+    }
+
+    template <class OperandT>
+    fingerprinted& subtract(const OperandT& x)
+    {
+        interval_type region = unhash(region_of(x));
+        _object.subtract(x);
+        rehash(region);
+        return *this;
+    }
+
+    template <class OperandT>
+    fingerprinted& insert(const OperandT& x)
+    {
+        interval_type region = unhash(region_of(x));
+        _object.insert(x);
+        rehash(region);
+        return *this;
+    }
+
+    template <class OperandT>
+    fingerprinted& erase(const OperandT& x)
+    {
+        interval_type region = unhash(region_of(x));
+        _object.erase(x);
+        rehash(region);
+        return *this;
+    }
+
+    template <class OperandT>
+    fingerprinted& operator += (const OperandT& x) { return add(x); }
+
+    template <class OperandT>
+    fingerprinted& operator -= (const OperandT& x) { return subtract(x); }
+
+    /// Add the segments of \c operand one by one
+    fingerprinted& operator += (const ContainerT& operand)
+    {
+        const_FORALL(typename ContainerT, it_, operand)
+            add(*it_);
+        return *this;
+    }
+
+    fingerprinted& operator -= (const ContainerT& operand)
+    {
+        const_FORALL(typename ContainerT, it_, operand)
+            subtract(*it_);
+        return *this;
+    }
+    //@}
+
+private:
+    static interval_type region_of(const domain_type& x) { return interval_type(x); }
+    static interval_type region_of(const interval_type& x) { return x; }
+
+    template <class IntervalT, class CodomainT>
+    static interval_type region_of(const std::pair<IntervalT, CodomainT>& x) { return x.first; }
+
+    // Subtracts the hashes of the segments that an update of \c x may change
+    // and returns the region in which they are
+    interval_type unhash(const interval_type& x)
+    {
+        if(x.empty())
+            return x;
+        // The region reaches from the last segment before x to the first one after it
+        const_iterator first_ = _object.lower_bound(x);
+        const_iterator past_  = _object.upper_bound(x);
+        if(first_ != _object.begin())
+            --first_;
+        if(past_ != _object.end())
+            ++past_;
+        if(first_ == past_)
+            return x;
+
+        interval_type region = x;
+        region.extend(Gap::segment_interval(*first_));
+        const_iterator last_ = first_;
+        for(const_iterator it_ = first_; it_ != past_; ++it_)
+        {
+            _fingerprint -= Fingerprint::segment_hash(*it_);
+            last_ = it_;
+        }
+        region.extend(Gap::segment_interval(*last_));
+        return region;
+    }
+
+    // Adds the hashes of the segments that overlap \c region
+    void rehash(const interval_type& region)
+    {
+        if(region.empty())
+            return;
+        const_iterator past_ = _object.upper_bound(region);
+        for(const_iterator it_ = _object.lower_bound(region); it_ != past_; ++it_)
+            _fingerprint += Fingerprint::segment_hash(*it_);
+    }
+
+private:
+    ContainerT      _object;
+    boost::uint64_t _fingerprint;
+};
+
+template <class ContainerT>
+inline bool operator == (const fingerprinted<ContainerT>& lhs, const fingerprinted<ContainerT>& rhs)
+{ return lhs.fingerprint() == rhs.fingerprint() && lhs.container() == rhs.container(); }
+
+template <class ContainerT>
+inline bool operator != (const fingerprinted<ContainerT>& lhs, const fingerprinted<ContainerT>& rhs)
+{ return !(lhs == rhs); }
+
+}} // namespace itl boost
+
+#endif
+
+
@@ -0,0 +1,527 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class gap_index, class gap_indexed_set
+    Interval sets with a maintained index of their gaps
+--------------------------------------------------------------------*/
+#ifndef __itl_gap_indexed_set_JOFA_081029_H__
+#define __itl_gap_indexed_set_JOFA_081029_H__
+
+#include <memory>
+#include <boost/assert.hpp>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/interval_gaps.hpp>
+
+namespace boost{namespace itl
+{
+
+/// Search tree of disjoint intervals that knows the longest interval of each subtree
+/**
+    A <b>gap_index</b> keeps the gaps of an interval container in a treap
+    ordered by <tt>exclusive_less</tt>. Each node is augmented by the
+    greatest length in its subtree, so subtrees without gaps of a
+    requested length are skipped. Insertions, deletions and the search
+    for a first gap take O(log n) expected time, the search for the
+    largest gap within a window O(log^2 n).
+
+    @author Joachim Faulhaber
+*/
+template <class IntervalT, template<class>class Alloc = std::allocator>
+class gap_index
+{
+public:
+    typedef IntervalT                             interval_type;
+    typedef typename IntervalT::difference_type   difference_type;
+    typedef std::size_t                           size_type;
+
+private:
+    struct node
+    {
+        node(const interval_type& gap_, unsigned priority_)
+            : gap(gap_), length(gap_.length()), max_length(length),
+              priority(priority_), left(0), right(0) {}
+
+        interval_type   gap;
+        difference_type length;
+        difference_type max_length; // Greatest length in the subtree
+        unsigned        priority;
+        node*           left;
+        node*           right;
+    };
+
+    typedef Alloc<node> node_allocator_type;
+
+public:
+    gap_index(): _root(0), _size(0), _seed(2463534242u) {}
+    gap_index(const gap_index& src): _root(0), _size(0), _seed(src._seed) { copy(src._root); }
+    ~gap_index() { clear(); }
+
+    gap_index& operator = (const gap_index& src)
+    {
+        if(this != &src)
+        {
+            gap_index copied(src);
+            swap(copied);
+        }
+        return *this;
+    }
+
+    void swap(gap_index& src)
+    {
+        std::swap(_root, src._root);
+        std::swap(_size, src._size);
+        std::swap(_seed, src._seed);
+    }
+
+    void clear() { destroy(_root); _root = 0; _size = 0; }
+    bool empty()const { return _root == 0; }
+    size_type size()const { return _size; }
+
+    /// Insert \c gap, that is disjoint to all gaps of the index
+    void insert(const interval_type& gap)
+    {
+        node *lower, *upper;
+        split(_root, gap, lower, upper);
+        _root = join(join(lower, new_node(gap)), upper);
+        ++_size;
+    }
+
+    /// Remove the gap that is equal to \c gap
+    void erase(const interval_type& gap) { _root = erase(_root, gap); }
+
+    /// Longest gap of the index; the first one, if there are several
+    interval_type largest()const
+    {
+        const node* current = _root;
+        while(current != 0)
+        {
+            if(current->left != 0 && !(current->left->max_length < current->max_length))
+                current = current->left;
+            else if(!(current->length < current->max_length))
+                return current->gap;
+            else
+                current = current->right;
+        }
+        return interval_type();
+    }
+
+    /// First gap that is at least \c min_length long, after clipping it to \c window
+    interval_type first(const interval_type& window, const difference_type& min_length)const
+    {
+        interval_type found;
+        first(_root, window, min_length, found);
+        return found;
+    }
+
+    /// Longest gap after clipping the gaps to \c window
+    interval_type largest(const interval_type& window)const
+    {
+        interval_type best;
+        largest(_root, window, 0, 0, best);
+        return best;
+    }
+
+    /// Write the gaps clipped to \c window to \c out in ascending order
+    template <class OutputIterator>
+    OutputIterator within(const interval_type& window, OutputIterator out)const
+    { return within(_root, window, out); }
+
+private:
+    static difference_type max_of(const difference_type& lhs, const difference_type& rhs)
+    { return lhs < rhs ? rhs : lhs; }
+
+    static void update(node* current)
+    {
+        current->max_length = current->length;
+        if(current->left != 0)
+            current->max_length = max_of(current->max_length, current->left->max_length);
+        if(current->right != 0)
+            current->max_length = max_of(current->max_length, current->right->max_length);
+    }
+
+    unsigned next_priority()
+    {
+        // xorshift: Priorities need not be random in a cryptographic sense
+        _seed ^= _seed << 13; _seed ^= _seed >> 17; _seed ^= _seed << 5;
+        return _seed;
+    }
+
+    node* new_node(const interval_type& gap)
+    {
+        node_allocator_type allocator;
+        node* created = allocator.allocate(1);
+        new(created) node(gap, next_priority());
+        return created;
+    }
+
+    void delete_node(node* victim)
+    {
+        node_allocator_type allocator;
+        victim->~node();
+        allocator.deallocate(victim, 1);
+    }
+
+    void destroy(node* current)
+    {
+        if(current == 0)
+            return;
+        destroy(current->left);
+        destroy(current->right);
+        delete_node(current);
+    }
+
+    void copy(const node* current)
+    {
+        if(current == 0)
+            return;
+        insert(current->gap);
+        copy(current->left);
+        copy(current->right);
+    }
+
+    // Split the treap into the gaps before \c gap and the others
+    static void split(node* current, const interval_type& gap, node*& lower, node*& upper)
+    {
+        if(current == 0)
+        {
+            lower = upper = 0;
+            return;
+        }
+        if(current->gap.exclusive_less(gap))
+        {
+            split(current->right, gap, current->right, upper);
+            lower = current;
+        }
+        else
+        {
+            split(current->left, gap, lower, current->left);
+            upper = current;
+        }
+        update(current);
+    }
+
+    // Join treaps, all gaps of \c lower being before the gaps of \c upper
+    static node* join(node* lower, node* upper)
+    {
+        if(lower == 0) return upper;
+        if(upper == 0) return lower;
+        if(upper->priority < lower->priority)
+        {
+            lower->right = join(lower->right, upper);
+            update(lower);
+            return lower;
+        }
+        else
+        {
+            upper->left = join(lower, upper->left);
+            update(upper);
+            return upper;
+        }
+    }
+
+    node* erase(node* current, const interval_type& gap)
+    {
+        if(current == 0)
+            return 0;
+        if(current->gap.exclusive_less(gap))
+            current->right = erase(current->right, gap);
+        else if(gap.exclusive_less(current->gap))
+            current->left = erase(current->left, gap);
+        else
+        {
+            BOOST_ASSERT(current->gap == gap);
+            node* joined = join(current->left, current->right);
+            delete_node(current);
+            --_size;
+            return joined;
+        }
+        update(current);
+        return current;
+    }
+
+    static bool first(const node* current, const interval_type& window,
+                      const difference_type& min_length, interval_type& found)
+    {
+        if(current == 0 || current->max_length < min_length)
+            return false;
+        if(current->gap.exclusive_less(window))
+            return first(current->right, window, min_length, found);
+        if(first(current->left, window, min_length, found))
+            return true;
+        if(window.exclusive_less(current->gap))
+            return false;
+
+        interval_type clipped = current->gap;
+        clipped.intersect(clipped, window);
+        if(!(clipped.length() < min_length))
+        {
+            found = clipped;
+            return true;
+        }
+        return first(current->right, window, min_length, found);
+    }
+
+    // The subtree of \c current lies between the gaps \c before and \c after,
+    // that are null if there is no bound
+    static void largest(const node* current, const interval_type& window,
+                        const interval_type* before, const interval_type* after,
+                        interval_type& best)
+    {
+        if(current == 0 || (!best.empty() && !(best.length() < current->max_length)))
+            return;
+
+        bool inside = before != 0 && after != 0
+                   && !before->lower_less(window) && !window.upper_less(*after);
+        if(inside)
+        {
+            // The longest gap of the subtree is not clipped
+            while(current->length < current->max_length)
+                current = current->left != 0 && !(current->left->max_length < current->max_length)
+                        ? current->left : current->right;
+            best = current->gap;
+            return;
+        }
+
+        if(current->gap.exclusive_less(window))
+            return largest(current->right, window, &current->gap, after, best);
+        if(window.exclusive_less(current->gap))
+            return largest(current->left, window, before, &current->gap, best);
+
+        largest(current->left, window, before, &current->gap, best);
+        interval_type clipped = current->gap;
+        clipped.intersect(clipped, window);
+        if(best.empty() || best.length() < clipped.length())
+            best = clipped;
+        largest(current->right, window, &current->gap, after, best);
+    }
+
+    template <class OutputIterator>
+    static OutputIterator within(const node* current, const interval_type& window, OutputIterator out)
+    {
+        if(current == 0)
+            return out;
+        if(current->gap.exclusive_less(window))
+            return within(current->right, window, out);
+        if(window.exclusive_less(current->gap))
+            return within(current->left, window, out);
+
+        out = within(current->left, window, out);
+        interval_type clipped = current->gap;
+        clipped.intersect(clipped, window);
+        *out++ = clipped;
+        return within(current->right, window, out);
+    }
+
+private:
+    node*     _root;
+    size_type _size;
+    unsigned  _seed;
+};
+
+
+/// An interval set that maintains an index of its gaps
+/**
+    A <b>gap_indexed_set</b> wraps an interval set and keeps the gaps
+    between its segments in a gap_index. Every update recomputes the gaps
+    next to its operand, which costs O(log n) for each segment that is
+    changed. In return the gap queries <tt>first_gap</tt> and
+    <tt>largest_gap</tt> search the index instead of walking the segments,
+    and <tt>gaps</tt> takes O(log n + k) for k gaps.
+
+    The gap queries of interval_gaps.hpp work for all interval containers
+    without an index.
+
+    @author Joachim Faulhaber
+*/
+template <class IntervalSetT = interval_set<int> >
+class gap_indexed_set
+{
+public:
+    typedef IntervalSetT                                  interval_set_type;
+    typedef typename IntervalSetT::domain_type            domain_type;
+    typedef typename IntervalSetT::interval_type          interval_type;
+    typedef typename IntervalSetT::difference_type        difference_type;
+    typedef typename IntervalSetT::size_type              size_type;
+    typedef typename IntervalSetT::const_iterator         const_iterator;
+    typedef gap_index<interval_type>                      gap_index_type;
+
+    /// The indexed interval set
+    const interval_set_type& intervals()const { return _set; }
+
+    const_iterator begin()const { return _set.begin(); }
+    const_iterator end()const   { return _set.end(); }
+    bool empty()const { return _set.empty(); }
+    size_type iterative_size()const { return _set.iterative_size(); }
+    bool contains(const domain_type& x)const { return _set.contains(x); }
+    bool contains(const interval_type& x)const { return _set.contains(x); }
+
+    /// Number of gaps between the segments
+    size_type gap_count()const { return _gaps.size(); }
+
+    void clear() { _set.clear(); _gaps.clear(); }
+
+    gap_indexed_set& add(const domain_type& x) { return add(interval_type(x)); }
+    gap_indexed_set& add(const interval_type& x)
+    {
+        if(!x.empty())
+        {
+            interval_type region = unindex(x);
+            _set.add(x);
+            reindex(region);
+        }
+        return *this;
+    }
+
+    gap_indexed_set& subtract(const domain_type& x) { return subtract(interval_type(x)); }
+    gap_indexed_set& subtract(const interval_type& x)
+    {
+        if(!x.empty())
+        {
+            interval_type region = unindex(x);
+            _set.subtract(x);
+            reindex(region);
+        }
+        return *this;
+    }
+
+    gap_indexed_set& operator += (const domain_type& x)   { return add(x); }
+    gap_indexed_set& operator += (const interval_type& x) { return add(x); }
+    gap_indexed_set& operator -= (const domain_type& x)   { return subtract(x); }
+    gap_indexed_set& operator -= (const interval_type& x) { return subtract(x); }
+
+    /// First gap within \c window that is at least \c min_length long
+    /** Yields an empty interval, if there is no such gap. */
+    interval_type first_gap(const interval_type& window, const difference_type& min_length)const
+    {
+        if(window.empty())
+            return interval_type();
+        if(is_free(window))
+            return window.length() < min_length ? interval_type() : window;
+
+        interval_type gap;
+        window.left_surplus(gap, hull());
+        if(!gap.empty() && !(gap.length() < min_length))
+            return gap;
+        gap = _gaps.first(window, min_length);
+        if(!gap.empty())
+            return gap;
+        window.right_surplus(gap, hull());
+        return gap.empty() || gap.length() < min_length ? interval_type() : gap;
+    }
+
+    /// Largest gap within \c window; the first one, if there are several
+    interval_type largest_gap(const interval_type& window)const
+    {
+        if(is_free(window))
+            return window;
+
+        interval_type best, gap;
+        window.left_surplus(best, hull());
+        gap = _gaps.largest(window);
+        if(best.empty() || (!gap.empty() && best.length() < gap.length()))
+            best = gap;
+        window.right_surplus(gap, hull());
+        if(best.empty() || (!gap.empty() && best.length() < gap.length()))
+            best = gap;
+        return best;
+    }
+
+    /// Largest gap between the segments
+    interval_type largest_gap()const { return _gaps.largest(); }
+
+    /// Write the gaps within \c window to \c out in ascending order
+    template <class OutputIterator>
+    OutputIterator gaps(const interval_type& window, OutputIterator out)const
+    {
+        if(window.empty())
+            return out;
+        if(is_free(window))
+        {
+            *out++ = window;
+            return out;
+        }
+
+        interval_type gap;
+        window.left_surplus(gap, hull());
+        if(!gap.empty())
+            *out++ = gap;
+        out = _gaps.within(window, out);
+        window.right_surplus(gap, hull());
+        if(!gap.empty())
+            *out++ = gap;
+        return out;
+    }
+
+private:
+    interval_type hull()const
+    { return (*_set.begin()).span(*_set.rbegin()); }
+
+    // Is no segment within \c window?
+    bool is_free(const interval_type& window)const
+    {
+        return _set.empty() || window.exclusive_less(*_set.begin())
+                            || (*_set.rbegin()).exclusive_less(window);
+    }
+
+    // Removes the gaps that an update by \c x may change from the index
+    // and returns the region in which they are
+    interval_type unindex(const interval_type& x)
+    {
+        typedef typename IntervalSetT::const_iterator set_iterator;
+
+        // The region reaches from the last segment before x to the first one after it
+        set_iterator first_ = _set.lower_bound(x);
+        set_iterator past_  = _set.upper_bound(x);
+        if(first_ != _set.begin())
+            --first_;
+        if(past_ != _set.end())
+            ++past_;
+        if(first_ == past_)
+            return x;
+
+        interval_type region = x;
+        set_iterator pred_ = first_;
+        region.extend(*first_);
+        for(set_iterator it_ = first_; ++it_ != past_; pred_ = it_)
+        {
+            interval_type gap = Gap::between(*pred_, *it_);
+            if(!gap.empty())
+                _gaps.erase(gap);
+        }
+        region.extend(*pred_);
+        return region;
+    }
+
+    // Inserts the gaps between the segments that overlap \c region into the index
+    void reindex(const interval_type& region)
+    {
+        typedef typename IntervalSetT::const_iterator set_iterator;
+        set_iterator first_ = _set.lower_bound(region);
+        set_iterator past_  = _set.upper_bound(region);
+        if(first_ == past_)
+            return;
+
+        set_iterator pred_ = first_;
+        for(set_iterator it_ = first_; ++it_ != past_; pred_ = it_)
+        {
+            interval_type gap = Gap::between(*pred_, *it_);
+            if(!gap.empty())
+                _gaps.insert(gap);
+        }
+    }
+
+private:
+    IntervalSetT   _set;
+    gap_index_type _gaps;
+};
+
+}} // namespace itl boost
+
+#endif
+
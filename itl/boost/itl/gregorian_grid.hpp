@@ -0,0 +1,94 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class month_grid, iso_week_grid
+    Calendar grids on boost::gregorian::date
+    #include this file PRIOR TO the other itl headers
+--------------------------------------------------------------------*/
+#ifndef __itl_gregorian_grid_JOFA_081030_H__
+#define __itl_gregorian_grid_JOFA_081030_H__
+
+#include <boost/itl/gregorian.hpp>
+#include <boost/itl/grid.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Grid
+{
+    template <>
+    struct step_traits<boost::gregorian::date_duration>
+    {
+        typedef boost::gregorian::date_duration duration_type;
+
+        static long count(const duration_type& distance, const duration_type& step)
+        {
+            long steps = distance.days() / step.days();
+            return distance.days() < 0 && steps * step.days() != distance.days() ? steps - 1 : steps;
+        }
+
+        static duration_type scale(const duration_type& step, long count)
+        { return duration_type(step.days() * count); }
+    };
+}
+
+
+/// Grid of calendar months or of \c months_per_cell months, that are aligned to January
+/** <tt>month_grid(3)</tt> is the grid of quarters, <tt>month_grid(12)</tt>
+    the grid of years. */
+class month_grid : public grid_base<month_grid, boost::gregorian::date>
+{
+public:
+    typedef boost::gregorian::date date;
+
+    explicit month_grid(int months_per_cell = 1): _months_per_cell(months_per_cell) {}
+
+    date next_border(const date& x)const
+    {
+        long index = x.year() * 12L + x.month() - 1;
+        return first_of(index - index % _months_per_cell + _months_per_cell);
+    }
+
+    date previous_border(const date& border)const
+    {
+        long index = border.year() * 12L + border.month() - 1;
+        return first_of(index - _months_per_cell);
+    }
+
+private:
+    static date first_of(long month_index)
+    {
+        return date(static_cast<unsigned short>(month_index / 12),
+                    static_cast<unsigned short>(month_index % 12 + 1), 1);
+    }
+
+    long _months_per_cell;
+};
+
+
+/// Grid of ISO weeks, that start on Mondays
+class iso_week_grid : public grid_base<iso_week_grid, boost::gregorian::date>
+{
+public:
+    typedef boost::gregorian::date date;
+
+    date next_border(const date& x)const
+    {
+        int days_since_monday = (x.day_of_week() + 6) % 7;
+        return x + boost::gregorian::days(7 - days_since_monday);
+    }
+
+    date previous_border(const date& border)const
+    { return border - boost::gregorian::weeks(1); }
+};
+
+}} // namespace itl boost
+
+#endif
+
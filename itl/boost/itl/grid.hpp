@@ -0,0 +1,265 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class grid_base, regular_grid, merged_grid; function split_by_grid
+    Lazily generated partitions of a domain
+--------------------------------------------------------------------*/
+#ifndef __itl_grid_JOFA_081030_H__
+#define __itl_grid_JOFA_081030_H__
+
+#include <cmath>
+#include <limits>
+#include <iterator>
+#include <boost/assert.hpp>
+#include <boost/itl/notate.hpp>
+#include <boost/itl/interval.hpp>
+#include <boost/itl/interval_base_set.hpp>
+#include <boost/itl/type_traits/difference.hpp>
+
+namespace boost{namespace itl
+{
+
+/// Base of grids: Partitions of a domain into cells, that are generated lazily
+/**
+    A grid partitions its domain into right open cells
+    <tt>[border_k, border_k+1)</tt>. Grids are not containers: A grid
+    only computes the border that follows a domain value by
+    <tt>DomainT next_border(const DomainT& x)const</tt>, which yields the
+    least border that is greater than \c x. So a grid covers all of its
+    domain without materializing a single cell.
+
+    Grids are derived from grid_base using their own type as
+    \c SubType. Interval containers can be split at the borders of grids
+    by <tt>split_by_grid</tt> or <tt>operator *=</tt>.
+
+    @author Joachim Faulhaber
+*/
+template <class SubType, class DomainT>
+class grid_base
+{
+public:
+    typedef DomainT                domain_type;
+    typedef itl::interval<DomainT> interval_type;
+
+    const SubType& that()const { return *static_cast<const SubType*>(this); }
+
+    /// The cell that contains \c x
+    interval_type cell(const DomainT& x)const
+    {
+        DomainT border = that().next_border(x);
+        return rightopen_interval(that().previous_border(border), border);
+    }
+};
+
+
+namespace Grid
+{
+    /// Counting steps of a regular grid
+    template <class DifferenceT>
+    struct step_traits
+    {
+        /// Number of whole steps in \c distance, rounded towards minus infinity
+        static long count(const DifferenceT& distance, const DifferenceT& step)
+        {
+            if(std::numeric_limits<DifferenceT>::is_integer)
+            {
+                long steps = static_cast<long>(distance / step);
+                return distance < DifferenceT() && steps * step != distance ? steps - 1 : steps;
+            }
+            return static_cast<long>(std::floor(static_cast<double>(distance) / step));
+        }
+
+        static DifferenceT scale(const DifferenceT& step, long count)
+        { return static_cast<DifferenceT>(step * count); }
+    };
+}
+
+
+/// Grid of cells of equal size \c step, one of which starts at \c origin
+template <class DomainT>
+class regular_grid : public grid_base<regular_grid<DomainT>, DomainT>
+{
+public:
+    typedef typename itl::difference<DomainT>::type difference_type;
+    typedef Grid::step_traits<difference_type>      step_traits;
+
+    /// \c step must be positive
+    regular_grid(const DomainT& origin, const difference_type& step)
+        : _origin(origin), _step(step)
+    { BOOST_ASSERT(difference_type() < step); }
+
+    DomainT next_border(const DomainT& x)const
+    { return _origin + step_traits::scale(_step, step_traits::count(x - _origin, _step) + 1); }
+
+    DomainT previous_border(const DomainT& border)const
+    { return border - _step; }
+
+    const DomainT& origin()const { return _origin; }
+    const difference_type& step()const { return _step; }
+
+private:
+    DomainT         _origin;
+    difference_type _step;
+};
+
+
+/// Grid of the borders of two grids
+/** The cells of a merged grid are the intersections of the cells of
+    both grids, e.g. the weeks and parts of weeks within months. */
+template <class LeftGridT, class RightGridT>
+class merged_grid : public grid_base<merged_grid<LeftGridT, RightGridT>, typename LeftGridT::domain_type>
+{
+public:
+    typedef typename LeftGridT::domain_type domain_type;
+
+    merged_grid(const LeftGridT& left, const RightGridT& right): _left(left), _right(right) {}
+
+    domain_type next_border(const domain_type& x)const
+    {
+        domain_type left_border = _left.next_border(x), right_border = _right.next_border(x);
+        return right_border < left_border ? right_border : left_border;
+    }
+
+    domain_type previous_border(const domain_type& border)const
+    {
+        domain_type left_border  = _left.previous_border(_left.next_border(border));
+        domain_type right_border = _right.previous_border(_right.next_border(border));
+        if(!(left_border < border))
+            left_border = _left.previous_border(left_border);
+        if(!(right_border < border))
+            right_border = _right.previous_border(right_border);
+        return left_border < right_border ? right_border : left_border;
+    }
+
+private:
+    LeftGridT  _left;
+    RightGridT _right;
+};
+
+template <class LeftGridT, class RightGridT>
+merged_grid<LeftGridT, RightGridT> merge_grids(const LeftGridT& left, const RightGridT& right)
+{ return merged_grid<LeftGridT, RightGridT>(left, right); }
+
+
+/// Iterator over the cells of a grid within a scope
+/** The cells at the borders of the scope are clipped. Cells are
+    computed when the iterator is advanced. */
+template <class GridT>
+class grid_iterator
+{
+public:
+    typedef std::input_iterator_tag                   iterator_category;
+    typedef typename GridT::interval_type             value_type;
+    typedef std::ptrdiff_t                            difference_type;
+    typedef const value_type*                         pointer;
+    typedef const value_type&                         reference;
+
+    /// The end iterator
+    grid_iterator(): _grid(0) {}
+
+    grid_iterator(const GridT& grid, const value_type& scope)
+        : _grid(&grid), _rest(scope) { advance(); }
+
+    reference operator*()const  { return _cell; }
+    pointer   operator->()const { return &_cell; }
+
+    grid_iterator& operator++() { advance(); return *this; }
+    grid_iterator  operator++(int) { grid_iterator it_ = *this; advance(); return it_; }
+
+    friend bool operator == (const grid_iterator& lhs, const grid_iterator& rhs)
+    { return lhs._grid == rhs._grid && (lhs._grid == 0 || lhs._cell == rhs._cell); }
+    friend bool operator != (const grid_iterator& lhs, const grid_iterator& rhs)
+    { return !(lhs == rhs); }
+
+private:
+    void advance()
+    {
+        if(_rest.empty())
+        {
+            _grid = 0;
+            return;
+        }
+        _rest.intersect(_cell, rightopen_interval(_rest.lower(), _grid->next_border(_rest.lower())));
+        _rest.left_subtract(_cell);
+    }
+
+    const GridT* _grid;
+    value_type   _rest;
+    value_type   _cell;
+};
+
+/// First cell of \c grid within \c scope
+template <class SubType, class DomainT>
+grid_iterator<SubType> grid_begin(const grid_base<SubType, DomainT>& grid,
+                                  const itl::interval<DomainT>& scope)
+{ return grid_iterator<SubType>(grid.that(), scope); }
+
+template <class SubType, class DomainT>
+grid_iterator<SubType> grid_end(const grid_base<SubType, DomainT>&)
+{ return grid_iterator<SubType>(); }
+
+
+/// Add the segments of \c source to \c result, split at the borders of \c grid
+/** The segments are visited once and each piece is appended to \c result
+    using a hint, so this takes linear time, if \c result is empty. Use a
+    split container as \c result to keep the borders of the grid. */
+template <class ResultT, class SourceT, class SubType, class DomainT>
+ResultT& split_by_grid(ResultT& result, const SourceT& source,
+                       const grid_base<SubType, DomainT>& grid)
+{
+    typedef typename SourceT::interval_type interval_type;
+    typename ResultT::iterator prior_ = result.end();
+    interval_type rest, piece;
+    const_FORALL(typename SourceT, segment_, source)
+    {
+        rest = SourceT::key_value(segment_);
+        while(!rest.empty())
+        {
+            rest.intersect(piece, rightopen_interval(rest.lower(), grid.that().next_border(rest.lower())));
+            rest.left_subtract(piece);
+            prior_ = result.add(prior_, ResultT::make_segment(piece, SourceT::codomain_value(segment_)));
+        }
+    }
+    return result;
+}
+
+/// Split the segments of \c object at the borders of \c grid
+template <class ObjectT, class SubType, class DomainT>
+ObjectT& split_by_grid(ObjectT& object, const grid_base<SubType, DomainT>& grid)
+{
+    ObjectT split;
+    split_by_grid(split, object, grid);
+    object.swap(split);
+    return object;
+}
+
+/// Intersection with a grid, that covers all of its domain, splits segments at the grid borders
+/** Interval maps intersect with grids by their member function
+    <tt>add_intersection</tt>, so <tt>operator *=</tt> and \c intersect of
+    interval maps accept grids as well. */
+template
+<
+    class SubType, class DomainT,
+    template<class>class Interval, template<class>class Compare, template<class>class Alloc,
+    class GridT
+>
+interval_base_set<SubType,DomainT,Interval,Compare,Alloc>&
+operator *=
+(
+          interval_base_set<SubType,DomainT,Interval,Compare,Alloc>& object,
+    const grid_base<GridT,DomainT>& grid
+)
+{
+    return split_by_grid(object, grid);
+}
+
+}} // namespace itl boost
+
+#endif
+
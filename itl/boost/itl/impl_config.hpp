@@ -0,0 +1,60 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+Selection of the implementation containers of interval maps
+--------------------------------------------------------------------*/
+#ifndef __itl_impl_config_JOFA_081022_H__
+#define __itl_impl_config_JOFA_081022_H__
+
+/*  Interval maps keep their segments in an implementation container,
+    that is itl::map by default. Interval maps, whose traits are 
+    btree_implemented<Traits>, keep them in an itl::btree_map instead. 
+    Its B+tree is faster for large interval maps that are frequently 
+    updated, because searches touch fewer cache lines. The implementation
+    is a part of the type, so maps of both kinds can be used together.
+
+    B+trees move elements on insertion and erasure. So interval maps of
+    both kinds rewrite the segments that an operation overlaps by one 
+    replace on the implementation container, see interval_rewrite.hpp. */
+
+#include <boost/itl/map.hpp>
+#include <boost/itl/btree_map.hpp>
+
+namespace boost{namespace itl
+{
+
+/// Traits of interval maps, that keep their segments in a btree_map
+template <class Traits = neutron_absorber>
+struct btree_implemented : public Traits {};
+
+template <class Traits>
+struct type_to_string<itl::btree_implemented<Traits> >
+{
+    static std::string apply()
+    { return "btree<" + type_to_string<Traits>::apply() + ">"; }
+};
+
+/// The implementation container of interval maps with traits \c Traits
+template <class KeyT, class DataT, class Traits,
+          template<class>class Compare, template<class>class Alloc>
+struct impl_map
+{
+    typedef itl::map<KeyT,DataT,Traits,Compare,Alloc> type;
+};
+
+template <class KeyT, class DataT, class Traits,
+          template<class>class Compare, template<class>class Alloc>
+struct impl_map<KeyT,DataT,itl::btree_implemented<Traits>,Compare,Alloc>
+{
+    typedef itl::btree_map<KeyT,DataT,Traits,Compare,Alloc> type;
+};
+
+}} // namespace itl boost
+
+#endif // __itl_impl_config_JOFA_081022_H__
@@ -45,6 +45,7 @@ DEALINGS IN THE SOFTWARE.
 #include <boost/itl/type_traits/difference.hpp>
 #include <boost/itl/type_traits/size.hpp>
 #include <boost/itl/type_traits/to_string.hpp>
+#include <boost/itl/type_traits/domain_conversion.hpp>
 
 #undef min
 #undef max
@@ -1139,6 +1140,20 @@ struct exclusive_less {
     { return x1.exclusive_less(x2); }
 };
 
+/// Orders intervals by their lower bounds
+template <class IntervalType>
+struct lower_less {
+    bool operator()(const IntervalType& x1, const IntervalType& x2)const
+    { return x1.lower_less(x2); }
+};
+
+/// Orders intervals by their upper bounds
+template <class IntervalType>
+struct upper_less {
+    bool operator()(const IntervalType& x1, const IntervalType& x2)const
+    { return x1.upper_less(x2); }
+};
+
 
 // ----------------------------------------------------------------------------
 // operators
@@ -1151,6 +1166,19 @@ itl::interval<DataT>& operator *= (      itl::interval<DataT>& section,
     return section;
 }
 
+/// The interval of \c TargetT with the bounds of \c source converted by domain_conversion
+/** Empty intervals are converted to the empty interval of \c TargetT, so
+    their bounds need not be convertible. */
+template <class TargetT, class SourceT>
+itl::interval<TargetT> interval_cast(const itl::interval<SourceT>& source)
+{
+    if(source.empty())
+        return itl::interval<TargetT>();
+    return itl::interval<TargetT>(domain_conversion<TargetT,SourceT>::apply(source.lower()),
+                                  domain_conversion<TargetT,SourceT>::apply(source.upper()),
+                                  source.boundtypes());
+}
+
 template<class CharType, class CharTraits, class DataT>
 std::basic_ostream<CharType, CharTraits> &operator<<
   (std::basic_ostream<CharType, CharTraits> &stream, interval<DataT> const& x)
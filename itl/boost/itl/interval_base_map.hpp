@@ -35,11 +35,16 @@ class interval_base_map
 #define __interval_base_map_h_JOFA_990223__
 
 #include <limits>
+#include <algorithm>
 #include <boost/itl/notate.hpp>
 #include <boost/itl/map.hpp>
+#include <boost/itl/impl_config.hpp>
 #include <boost/itl/interval_base_set.hpp>
 #include <boost/itl/interval_sets.hpp>
+#include <boost/itl/interval_map_algo.hpp>
 #include <boost/itl/interval.hpp>
+#include <boost/itl/interval_notation.hpp>
+#include <boost/itl/operation_stats.hpp>
 
 
 #define const_FOR_IMPLMAP(iter) for(typename ImplMapT::const_iterator iter=_map.begin(); (iter)!=_map.end(); (iter)++)
@@ -48,6 +53,8 @@ class interval_base_map
 namespace boost{namespace itl
 {
 
+template <class SubType, class DomainT> class grid_base;
+
 template<class DomainT, class CodomainT>
 struct base_pair
 {
@@ -169,6 +176,8 @@ public:
     typedef DomainT   domain_type;
     /// Domain type (type of the keys) of the map
     typedef CodomainT codomain_type;
+    /// Combiner of codomain values, that is applied on addition
+    typedef inplace_plus<codomain_type> codomain_combine;
     /// basic value type
     typedef std::pair<domain_type,codomain_type> base_value_type;
     /// Auxiliary type to help the compiler resolve ambiguities when using std::make_pair
@@ -195,8 +204,8 @@ public:
         allocator_type;
 
     /// Container type for the implementation 
-    typedef itl::map<interval_type,codomain_type,Traits,
-                     exclusive_less,Alloc> ImplMapT;
+    typedef typename impl_map<interval_type,codomain_type,Traits,
+                              exclusive_less,Alloc>::type ImplMapT;
 
     /// key type of the implementing container
     typedef typename ImplMapT::key_type   key_type;
@@ -264,6 +273,7 @@ public:
     bool contains(const DomainT& x)const
     { 
         typename ImplMapT::const_iterator it = _map.find(interval_type(x)); 
+        ITL_COUNT(search);
         return it != _map.end(); 
     }
 
@@ -386,6 +396,13 @@ public:
     */
     SubType& add(const value_type& x) 
     { that()->template add_<inplace_plus>(x); return *that(); }
+
+    /// Addition of a value pair using \c prior_ as hint.
+    /** If \c prior_ is the last segment of the map and the interval of \c x 
+        lies right of it without being joined to it, \c x is appended in constant time.
+        Otherwise this is <tt>add(x)</tt>. The result can be used as hint for
+        the next addition, so ascending segments are added in linear time. */
+    iterator add(iterator prior_, const value_type& x);
 //@}
 
 
@@ -560,6 +577,17 @@ public:
     */
     SubType& erase(const interval_base_map& x);
 
+    /// Erase all associated values for keys less than \c x
+    /** Segments that are entirely before \c x are removed by a single range
+        erasure and a segment that contains \c x is clipped. This takes
+        O(log n) plus the number of removed segments, so dropping an expired
+        prefix of a time line is cheap.
+    */
+    SubType& truncate_before(const DomainT& x);
+
+    /// Erase all associated values for keys greater than \c x
+    SubType& truncate_after(const DomainT& x);
+
 //@}
 
 //-----------------------------------------------------------------------------
@@ -639,6 +667,11 @@ public:
             add_intersection(section, *it++);
     }
 
+    /// Intersection with a grid splits the segments at the borders of the grid (see grid.hpp)
+    template<class GridT>
+    void add_intersection(interval_base_map& section, const grid_base<GridT,DomainT>& grid)const
+    { split_by_grid(section, *this, grid); }
+
 
     /// Intersection with an interval map
     /** Compute the intersection of <tt>*this</tt> and the interval map <tt>x</tt>;
@@ -779,9 +812,10 @@ public:
 //@{
     /** Convert the interval map to string (c.f. \ref value)
 
-        This string converter is based on a general converter function <tt>as_string</tt>
-        and the template class \ref value which serves as base for string
-        representation.
+        The segments are appended to the result in the notation of
+        <tt>write_notation</tt>, which can be read by <tt>parse_notation</tt>.
+        Codomain values, that are not numbers, are converted by
+        <tt>to_string</tt>.
     */
     std::string as_string() const;
 //@}
@@ -836,6 +870,9 @@ public:
     static value_type make_domain_element(const domain_type& dom_val, const codomain_type& codom_val)
     { return value_type(interval_type(dom_val), codom_val); }
 
+    static value_type make_segment(const interval_type& itv, const codomain_type& codom_val)
+    { return value_type(itv, codom_val); }
+
 protected:
     sub_type* that() { return static_cast<sub_type*>(this); }
     const sub_type* that()const { return static_cast<const sub_type*>(this); }
@@ -846,6 +883,54 @@ protected:
 
 
 
+template 
+<
+    class SubType, class DomainT, class CodomainT, class Traits, 
+    template<class>class Interval, template<class>class Compare, 
+    template<class>class Alloc
+>
+typename interval_base_map<SubType,DomainT,CodomainT,Traits,
+                           Interval,Compare,Alloc>::iterator 
+interval_base_map<SubType,DomainT,CodomainT,Traits,
+                  Interval,Compare,Alloc>::add(iterator prior_, const value_type& x)
+{
+    const interval_type& x_itv = x.KEY_VALUE;
+    if(x_itv.empty()) 
+        return prior_;
+
+    if(Traits::absorbs_neutrons && x.CONT_VALUE == CodomainT())
+    {
+        ITL_COUNT(absorption);
+        return prior_;
+    }
+
+    if(!_map.empty())
+    {
+        iterator last_ = _map.end();
+        --last_;
+        CodomainT added_val = x.CONT_VALUE;
+        if(Traits::emits_neutrons)
+        {
+            added_val = CodomainT();
+            codomain_combine()(added_val, x.CONT_VALUE);
+        }
+        // Touching segments are joined by joining interval maps, if their values are equal
+        if(prior_ == last_ && (*last_).KEY_VALUE.exclusive_less(x_itv) 
+           && !(is_interval_joiner<SubType>::value && (*last_).KEY_VALUE.touches(x_itv)
+                && (*last_).CONT_VALUE == added_val))
+        {
+            ITL_COUNT(allocation);
+            return _map.insert(last_, value_type(x_itv, added_val));
+        }
+    }
+
+    add(x);
+    iterator post_ = _map.upper_bound(x_itv);
+    ITL_COUNT(search);
+    return post_ == _map.begin() ? post_ : --post_;
+}
+
+
 template 
 <
     class SubType, class DomainT, class CodomainT, class Traits, 
@@ -953,9 +1038,12 @@ void interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>
 
     typename ImplMapT::const_iterator fst_it = _map.lower_bound(sectant_interval);
     typename ImplMapT::const_iterator end_it = _map.upper_bound(sectant_interval);
+    ITL_COUNT(search);
+    ITL_COUNT(search);
 
     for(typename ImplMapT::const_iterator it=fst_it; it != end_it; it++) 
     {
+        ITL_COUNT(visit);
         interval_type common_interval; 
         (*it).KEY_VALUE.intersect(common_interval, sectant_interval);
 
@@ -986,9 +1074,12 @@ void interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>
 
     typename ImplMapT::const_iterator fst_it = _map.lower_bound(sectant_interval);
     typename ImplMapT::const_iterator end_it = _map.upper_bound(sectant_interval);
+    ITL_COUNT(search);
+    ITL_COUNT(search);
 
     for(typename ImplMapT::const_iterator it=fst_it; it != end_it; it++) 
     {
+        ITL_COUNT(visit);
         interval_type common_interval; 
         (*it).KEY_VALUE.intersect(common_interval, sectant_interval);
 
@@ -1036,8 +1127,11 @@ interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>& inte
             joinedInterval.extend((*lst_mem).KEY_VALUE);
             CodomainT value = (*fst_mem).CONT_VALUE; //CodomainT::OP =
             
+            ITL_COUNT(join);
             _map.erase(fst_mem, end_mem);
-            it = _map.insert(value_type(joinedInterval, value)).ITERATOR;
+            std::pair<iterator,bool> insertion = _map.insert(value_type(joinedInterval, value));
+            ITL_COUNT_IF(insertion.WAS_SUCCESSFUL, allocation);
+            it = insertion.ITERATOR;
 
             it++; // go on for the next after the currently inserted
             nxt=it; if(nxt!=_map.end())nxt++;
@@ -1056,15 +1150,7 @@ template
 std::string interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>::as_string()const
 {
     std::string res(""); 
-    const_FOR_IMPLMAP(it) {
-        std::string cur("("); 
-        cur += (*it).KEY_VALUE.as_string();
-        cur += ",";
-        cur += itl::to_string<CodomainT>::apply((*it).CONT_VALUE);
-        cur += ")";
-        res += cur;
-    }
-    return res; 
+    return append_notation(res, *this); 
 }
 
 
@@ -1089,9 +1175,18 @@ template
 >
 void interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>::uniformBounds( typename interval<DomainT>::bound_types bt)
 {
-    // I can do this only, because I am shure that the contents and the
-    // ordering < on interval is invariant wrt. this transformation on bounds
-    FOR_IMPLMAP(it) const_cast<interval_type&>((*it).KEY_VALUE).transformBounds(bt);
+    // Keys of the implementation map can not be altered in place, a
+    // btree_map keeps copies of them in inner nodes. The ordering is
+    // invariant wrt. this transformation, so the transformed segments
+    // are appended in order.
+    ImplMapT transformed;
+    const_FOR_IMPLMAP(it)
+    {
+        interval_type itv = (*it).KEY_VALUE;
+        itv.transform_bounds(bt);
+        transformed.insert(transformed.end(), value_type(itv, (*it).CONT_VALUE));
+    }
+    _map.swap(transformed);
 }
 
 template 
@@ -1101,9 +1196,15 @@ template
 >
 void interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>::closeLeftBounds()
 {
-    // I can do this only, because I am shure that the contents and the
-    // ordering < on interval is invariant wrt. this transformation on bounds
-    FOR_IMPLMAP(it) const_cast<interval_type&>((*it).KEY_VALUE).closeLeftBound();
+    // Keys can not be altered in place, see uniformBounds
+    ImplMapT transformed;
+    const_FOR_IMPLMAP(it)
+    {
+        interval_type itv = (*it).KEY_VALUE;
+        itv.close_left_bound();
+        transformed.insert(transformed.end(), value_type(itv, (*it).CONT_VALUE));
+    }
+    _map.swap(transformed);
 }
 
 
@@ -1118,26 +1219,25 @@ SubType& interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,All
 {
     if(x_itv.empty()) return *that();
     iterator fst_it = _map.lower_bound(x_itv);
+    ITL_COUNT(search);
     if(fst_it==_map.end()) return *that();
     iterator end_it = _map.upper_bound(x_itv);
+    ITL_COUNT(search);
+    if(fst_it==end_it) return *that();
+    iterator lst_it = end_it; lst_it--;
     
-    typename ImplMapT::iterator it=fst_it, nxt_it=fst_it, victim;
     interval_type leftResid;   // left residual from first overlapping interval of *this
-    (*it).KEY_VALUE.left_surplus(leftResid,x_itv);
+    (*fst_it).KEY_VALUE.left_surplus(leftResid,x_itv);
     interval_type rightResid;  // right residual from last overlapping interval of *this
+    (*lst_it).KEY_VALUE.right_surplus(rightResid,x_itv);
     
-    CodomainT leftResid_ContVal = (*it).CONT_VALUE;
-    CodomainT rightResid_ContVal;
+    CodomainT leftResid_ContVal  = (*fst_it).CONT_VALUE;
+    CodomainT rightResid_ContVal = (*lst_it).CONT_VALUE;
     
-    while(it!=end_it)
-    { 
-        if((++nxt_it)==end_it) 
-        {
-            (*it).KEY_VALUE.right_surplus(rightResid,x_itv);
-            rightResid_ContVal = (*it).CONT_VALUE;
-        }
-        victim = it; it++; _map.erase(victim);
-    }
+    for(iterator it = fst_it; it != end_it; it++)
+        ITL_COUNT(visit);
+    // Erasure of the range keeps no iterators, so btree_map can move segments
+    _map.erase(fst_it, end_it);
     
     that()->add_(value_type(leftResid,  leftResid_ContVal));
     that()->add_(value_type(rightResid, rightResid_ContVal));
@@ -1146,6 +1246,65 @@ SubType& interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,All
 }
 
 
+template 
+<
+    class SubType,
+    class DomainT, class CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc
+>
+SubType& interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>
+    ::truncate_before(const DomainT& x)
+{
+    iterator first_ = _map.lower_bound(interval_type(x));
+    ITL_COUNT(search);
+    _map.erase(_map.begin(), first_);
+    // Iterators do not survive erasure on a btree_map
+    first_ = _map.begin();
+    if(first_ == _map.end())
+        return *that();
+
+    // The first remaining segment may still begin before x
+    interval_type clipped;
+    (*first_).KEY_VALUE.intersect(clipped, closed_interval(x, (*first_).KEY_VALUE.upper()));
+    if(!(clipped == (*first_).KEY_VALUE))
+    {
+        value_type residue(clipped, (*first_).CONT_VALUE);
+        _map.erase(first_);
+        if(!clipped.empty())
+            _map.insert(_map.begin(), residue);
+    }
+    return *that();
+}
+
+
+template 
+<
+    class SubType,
+    class DomainT, class CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc
+>
+SubType& interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>
+    ::truncate_after(const DomainT& x)
+{
+    _map.erase(_map.upper_bound(interval_type(x)), _map.end());
+    ITL_COUNT(search);
+    if(_map.empty())
+        return *that();
+
+    // The last remaining segment may still end after x
+    iterator last_ = _map.end();
+    --last_;
+    interval_type clipped;
+    (*last_).KEY_VALUE.intersect(clipped, closed_interval((*last_).KEY_VALUE.lower(), x));
+    if(!(clipped == (*last_).KEY_VALUE))
+    {
+        value_type residue(clipped, (*last_).CONT_VALUE);
+        _map.erase(last_);
+        if(!clipped.empty())
+            _map.insert(_map.end(), residue);
+    }
+    return *that();
+}
+
+
 template 
 <
     class SubType,
@@ -1194,13 +1353,7 @@ template
 inline bool is_protonic_equal(const interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>& lhs,
                               const interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc>& rhs)
 {
-    interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc> lhs0 = lhs;
-    interval_base_map<SubType,DomainT,CodomainT,Traits,Interval,Compare,Alloc> rhs0 = rhs;
-
-    lhs0.absorb_neutrons();
-    rhs0.absorb_neutrons();
-
-    return Set::lexicographical_equal(lhs0, rhs0);
+    return Map::is_protonic_equal(lhs, rhs);
 }
 
 
@@ -38,7 +38,9 @@ class interval_base_set
 #include <boost/itl/interval_set_algo.hpp>
 #include <boost/itl/set.hpp>
 #include <boost/itl/interval.hpp>
+#include <boost/itl/interval_notation.hpp>
 #include <boost/itl/notate.hpp>
+#include <boost/itl/operation_stats.hpp>
 
 #define const_FOR_IMPL(iter) for(typename ImplSetT::const_iterator iter=_set.begin(); (iter)!=_set.end(); (iter)++)
 #define FOR_IMPL(iter) for(typename ImplSetT::iterator iter=_set.begin(); (iter)!=_set.end(); (iter)++)
@@ -257,6 +259,13 @@ public:
     SubType& add(const value_type& x) 
     { that()->add_(x); return *that(); }
 
+    /// Add an interval of elements \c x to the set using \c prior_ as hint
+    /** If \c prior_ is the last interval of the set and \c x lies right of it
+        without being joined to it, \c x is appended in constant time. Otherwise
+        this is <tt>add(x)</tt>. The result can be used as hint for the next
+        addition, so ascending intervals are added in linear time. */
+    iterator add(iterator prior_, const value_type& x);
+
 //@}
 
 //-----------------------------------------------------------------------------
@@ -299,6 +308,12 @@ public:
     /// Erase an interval of element \c x from the set
     SubType& erase(const value_type& x) 
     { return subtract(x); }
+
+    /// Erase all elements less than \c x in O(log n) plus the number of removed intervals
+    SubType& truncate_before(const DomainT& x);
+
+    /// Erase all elements greater than \c x in O(log n) plus the number of removed intervals
+    SubType& truncate_after(const DomainT& x);
 //@}
 
 //-----------------------------------------------------------------------------
@@ -373,7 +388,7 @@ public:
 //@{
     /// Interval-set as string
     const std::string as_string()const
-    { std::string res(""); const_FOR_IMPL(it) res += (*it).as_string(); return res; }
+    { std::string res(""); return append_notation(res, *this); }
 //@}
 
     
@@ -426,6 +441,9 @@ public:
     static value_type make_domain_element(const domain_type& dom_val, const codomain_type& codom_val)
     { return value_type(interval_type(dom_val)); }
 
+    static value_type make_segment(const interval_type& itv, const codomain_type&)
+    { return itv; }
+
 protected:
     sub_type* that() { return static_cast<sub_type*>(this); }
     const sub_type* that()const { return static_cast<const sub_type*>(this); }
@@ -465,6 +483,87 @@ interval_base_set<SubType,DomainT,Interval,Compare,Alloc>::cardinality()const
     */
 }
 
+template
+<
+    class SubType, class DomainT, template<class>class Interval, 
+    template<class>class Compare, template<class>class Alloc
+>
+typename interval_base_set<SubType,DomainT,Interval,Compare,Alloc>::iterator
+interval_base_set<SubType,DomainT,Interval,Compare,Alloc>::add(iterator prior_, const value_type& x)
+{
+    if(x.empty())
+        return prior_;
+
+    if(!_set.empty())
+    {
+        iterator last_ = _set.end();
+        --last_;
+        // Touching intervals are joined by joining interval sets only
+        if(prior_ == last_ && (*last_).exclusive_less(x) 
+           && !(is_interval_joiner<SubType>::value && (*last_).touches(x)))
+        {
+            ITL_COUNT(allocation);
+            return _set.insert(last_, x);
+        }
+    }
+
+    that()->add_(x);
+    iterator post_ = _set.upper_bound(x);
+    ITL_COUNT(search);
+    return post_ == _set.begin() ? post_ : --post_;
+}
+
+template
+<
+    class SubType, class DomainT, template<class>class Interval, 
+    template<class>class Compare, template<class>class Alloc
+>
+SubType& interval_base_set<SubType,DomainT,Interval,Compare,Alloc>::truncate_before(const DomainT& x)
+{
+    iterator first_ = _set.lower_bound(interval_type(x));
+    ITL_COUNT(search);
+    _set.erase(_set.begin(), first_);
+    if(first_ == _set.end())
+        return *that();
+
+    // The first remaining interval may still begin before x
+    interval_type clipped;
+    (*first_).intersect(clipped, closed_interval(x, (*first_).upper()));
+    if(!(clipped == *first_))
+    {
+        _set.erase(first_++);
+        if(!clipped.empty())
+            _set.insert(first_, clipped);
+    }
+    return *that();
+}
+
+template
+<
+    class SubType, class DomainT, template<class>class Interval, 
+    template<class>class Compare, template<class>class Alloc
+>
+SubType& interval_base_set<SubType,DomainT,Interval,Compare,Alloc>::truncate_after(const DomainT& x)
+{
+    _set.erase(_set.upper_bound(interval_type(x)), _set.end());
+    ITL_COUNT(search);
+    if(_set.empty())
+        return *that();
+
+    // The last remaining interval may still end after x
+    iterator last_ = _set.end();
+    --last_;
+    interval_type clipped;
+    (*last_).intersect(clipped, closed_interval((*last_).lower(), x));
+    if(!(clipped == *last_))
+    {
+        _set.erase(last_);
+        if(!clipped.empty())
+            _set.insert(_set.end(), clipped);
+    }
+    return *that();
+}
+
 template
 <
     class SubType, class DomainT, template<class>class Interval, 
@@ -519,9 +618,12 @@ void interval_base_set<SubType,DomainT,Interval,Compare,Alloc>::add_intersection
 
     typename ImplSetT::const_iterator fst_it = _set.lower_bound(x);
     typename ImplSetT::const_iterator end_it = _set.upper_bound(x);
+    ITL_COUNT(search);
+    ITL_COUNT(search);
 
     for(typename ImplSetT::const_iterator it=fst_it; it != end_it; it++) 
     {
+        ITL_COUNT(visit);
         interval_type isec; 
         (*it).intersect(isec, x);
         section.add(isec);
@@ -559,8 +661,11 @@ interval_base_set<SubType,DomainT,Interval,Compare,Alloc>& interval_base_set<Sub
             interval_type joinedInterval(*fst_mem);
             joinedInterval.extend(*lst_mem);
             
+            ITL_COUNT(join);
             _set.erase(fst_mem, end_mem);
-            it = _set.insert(joinedInterval).ITERATOR;
+            std::pair<iterator,bool> insertion = _set.insert(joinedInterval);
+            ITL_COUNT_IF(insertion.WAS_SUCCESSFUL, allocation);
+            it = insertion.ITERATOR;
 
             it++; // go on for the next after the currently inserted
             nxt=it; if(nxt!=_set.end())nxt++;
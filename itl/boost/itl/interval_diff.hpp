@@ -0,0 +1,246 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class segment_change; functions diff, patch
+    Change feeds between two states of an interval container
+--------------------------------------------------------------------*/
+#ifndef __itl_interval_diff_JOFA_081104_H__
+#define __itl_interval_diff_JOFA_081104_H__
+
+#include <utility>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/itl/interval.hpp>
+
+namespace boost{namespace itl
+{
+
+/// A change of an interval container within the interval \c range
+/** Before the change the elements of \c range were covered, if
+    \c was_covered, and associated with \c old_value. After the change they
+    are covered, if \c is_covered, and associated with \c new_value. Values
+    of uncovered states are default constructed. For interval sets the
+    values are \c bool and equal to the coverage. */
+template <class IntervalT, class CodomainT>
+struct segment_change
+{
+    typedef IntervalT interval_type;
+    typedef CodomainT codomain_type;
+
+    segment_change(): was_covered(false), is_covered(false), old_value(), new_value() {}
+
+    segment_change(const IntervalT& itv, bool was, const CodomainT& old_val,
+                                         bool is,  const CodomainT& new_val)
+        : range(itv), was_covered(was), is_covered(is), old_value(old_val), new_value(new_val) {}
+
+    /// Same transition of values, regardless of the range
+    bool same_transition(const segment_change& x2)const
+    {
+        return was_covered == x2.was_covered && is_covered  == x2.is_covered
+            && old_value   == x2.old_value   && new_value   == x2.new_value;
+    }
+
+    bool operator == (const segment_change& x2)const
+    { return range == x2.range && same_transition(x2); }
+
+    IntervalT range;
+    bool      was_covered;
+    bool      is_covered;
+    CodomainT old_value;
+    CodomainT new_value;
+};
+
+
+namespace Diff
+{
+    template <class ContainerT, bool IsSet =
+        is_same<typename ContainerT::value_type, typename ContainerT::interval_type>::value>
+    struct traits;
+
+    template <class ContainerT>
+    struct traits<ContainerT, true>
+    {
+        typedef bool codomain_type;
+        typedef bool value_reference;
+        typedef segment_change<typename ContainerT::interval_type, bool> change_type;
+
+        static const typename ContainerT::interval_type&
+            range(typename ContainerT::const_iterator it_) { return *it_; }
+        static bool value(typename ContainerT::const_iterator) { return true; }
+
+        static void apply(ContainerT& object, const change_type& change)
+        {
+            if(change.is_covered)
+                object.add(change.range);
+            else
+                object.subtract(change.range);
+        }
+    };
+
+    template <class ContainerT>
+    struct traits<ContainerT, false>
+    {
+        typedef typename ContainerT::codomain_type codomain_type;
+        typedef const codomain_type&               value_reference;
+        typedef segment_change<typename ContainerT::interval_type, codomain_type> change_type;
+
+        static const typename ContainerT::interval_type&
+            range(typename ContainerT::const_iterator it_) { return (*it_).KEY_VALUE; }
+        static const codomain_type& value(typename ContainerT::const_iterator it_)
+        { return (*it_).CONT_VALUE; }
+
+        static void apply(ContainerT& object, const change_type& change)
+        {
+            object.erase(change.range);
+            if(change.is_covered)
+                object.insert(std::make_pair(change.range, change.new_value));
+        }
+    };
+
+    /// Collects the pieces of a sweep and coalesces touching pieces of equal transitions
+    template <class ChangeT, class OutputIterator>
+    struct coalescer
+    {
+        coalescer(OutputIterator out): _out(out), _pending(false) {}
+
+        void operator()(const ChangeT& change)
+        {
+            if(_pending && _change.range.touches(change.range)
+                        && _change.same_transition(change))
+            {
+                _change.range.extend(change.range);
+                return;
+            }
+            flush();
+            _change  = change;
+            _pending = true;
+        }
+
+        OutputIterator flush()
+        {
+            if(_pending)
+                *_out++ = _change;
+            _pending = false;
+            return _out;
+        }
+
+        OutputIterator _out;
+        bool           _pending;
+        ChangeT        _change;
+    };
+
+    /// Remaining part of the current segment of one side of the sweep
+    template <class ContainerT>
+    struct cursor
+    {
+        typedef traits<ContainerT>                       traits_type;
+        typedef typename ContainerT::const_iterator      const_iterator;
+        typedef typename ContainerT::interval_type       interval_type;
+        typedef typename traits_type::value_reference    value_reference;
+
+        cursor(const ContainerT& object): _it(object.begin()), _end(object.end()) { load(); }
+
+        bool done()const { return _rest.empty(); }
+        value_reference value()const { return traits_type::value(_it); }
+
+        void consume(const interval_type& piece)
+        {
+            _rest.left_subtract(piece);
+            if(_rest.empty())
+            {
+                ++_it;
+                load();
+            }
+        }
+
+        void load()
+        {
+            if(_it == _end)
+                _rest.clear();
+            else
+                _rest = traits_type::range(_it);
+        }
+
+        const_iterator _it;
+        const_iterator _end;
+        interval_type  _rest;
+    };
+
+} // namespace Diff
+
+
+/// Write the changes from \c old_object to \c new_object to \c out in ascending order
+/** The changes are the maximal intervals, where coverage or values of the
+    two objects differ, with their old and new values. Both objects are
+    swept once, so this takes O(n + m). Joining and splitting do not change
+    the contents of interval containers, so old and new objects may differ
+    in their segmentation, e.g. a split_interval_map may be compared to an
+    interval_map. The output iterator takes values of
+    <tt>Diff::traits<ContainerT>::change_type</tt>. */
+template <class ContainerT, class OtherT, class OutputIterator>
+OutputIterator diff(const ContainerT& old_object, const OtherT& new_object, OutputIterator out)
+{
+    typedef typename Diff::traits<ContainerT>::change_type   change_type;
+    typedef typename Diff::traits<ContainerT>::codomain_type codomain_type;
+    typedef typename ContainerT::interval_type               interval_type;
+
+    Diff::coalescer<change_type, OutputIterator> emit(out);
+    Diff::cursor<ContainerT> left(old_object);
+    Diff::cursor<OtherT>     right(new_object);
+    interval_type piece;
+
+    while(!left.done() || !right.done())
+    {
+        if(right.done() || (!left.done() && left._rest.lower_less(right._rest)))
+        {
+            // Only the old object covers the piece before the next new segment
+            if(right.done() || left._rest.exclusive_less(right._rest))
+                piece = left._rest;
+            else
+                left._rest.left_surplus(piece, right._rest);
+            emit(change_type(piece, true, left.value(), false, codomain_type()));
+            left.consume(piece);
+        }
+        else if(left.done() || right._rest.lower_less(left._rest))
+        {
+            if(left.done() || right._rest.exclusive_less(left._rest))
+                piece = right._rest;
+            else
+                right._rest.left_surplus(piece, left._rest);
+            emit(change_type(piece, false, codomain_type(), true, right.value()));
+            right.consume(piece);
+        }
+        else
+        {
+            left._rest.intersect(piece, right._rest);
+            if(!(left.value() == right.value()))
+                emit(change_type(piece, true, left.value(), true, right.value()));
+            left.consume(piece);
+            right.consume(piece);
+        }
+    }
+    return emit.flush();
+}
+
+/// Apply the changes in <tt>[first, last)</tt> to \c object
+/** The changes are applied one by one, each of them takes O(log n + k)
+    for k segments of \c object within its range. Patching an old object
+    by its diff to a new one yields a new object, that is element equal
+    to it. Joining containers are equal to it. */
+template <class ContainerT, class InputIterator>
+ContainerT& patch(ContainerT& object, InputIterator first, InputIterator last)
+{
+    for(; first != last; ++first)
+        Diff::traits<ContainerT>::apply(object, *first);
+    return object;
+}
+
+}} // namespace itl boost
+
+#endif
+
@@ -0,0 +1,172 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+functions gaps, first_gap, largest_gap
+    Queries for the free intervals of interval containers
+--------------------------------------------------------------------*/
+#ifndef __itl_interval_gaps_JOFA_081029_H__
+#define __itl_interval_gaps_JOFA_081029_H__
+
+#include <utility>
+#include <boost/itl/interval.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Gap
+{
+    template <class DomainT>
+    inline const itl::interval<DomainT>& segment_interval(const itl::interval<DomainT>& segment)
+    { return segment; }
+
+    template <class IntervalT, class CodomainT>
+    inline const IntervalT& segment_interval(const std::pair<IntervalT, CodomainT>& segment)
+    { return segment.first; }
+
+    /// The free interval between the segment intervals \c left and \c right
+    template <class IntervalT>
+    IntervalT between(const IntervalT& left, const IntervalT& right)
+    {
+        IntervalT gap = left.span(right);
+        gap.left_subtract(left);
+        gap.left_surplus(gap, right);
+        return gap;
+    }
+
+    /// Pass the gaps of \c object within \c window to \c visitor in ascending order
+    /** The visitor returns false to stop the walk. */
+    template <class ContainerT, class VisitorT>
+    void walk(const ContainerT& object, const typename ContainerT::interval_type& window,
+              VisitorT& visitor)
+    {
+        typedef typename ContainerT::interval_type  interval_type;
+        typedef typename ContainerT::const_iterator const_iterator;
+
+        if(window.empty())
+            return;
+        const_iterator first_ = object.lower_bound(window);
+        const_iterator past_  = object.upper_bound(window);
+        if(first_ == past_)
+        {
+            visitor(window);
+            return;
+        }
+
+        interval_type gap;
+        window.left_surplus(gap, segment_interval(*first_));
+        if(!gap.empty() && !visitor(gap))
+            return;
+
+        const_iterator pred_ = first_;
+        for(const_iterator it_ = first_; ++it_ != past_; pred_ = it_)
+        {
+            gap = between(segment_interval(*pred_), segment_interval(*it_));
+            if(!gap.empty() && !visitor(gap))
+                return;
+        }
+
+        window.right_surplus(gap, segment_interval(*pred_));
+        if(!gap.empty())
+            visitor(gap);
+    }
+
+    template <class IntervalT, class OutputIterator>
+    struct copy_visitor
+    {
+        copy_visitor(OutputIterator out): _out(out) {}
+        bool operator()(const IntervalT& gap) { *_out++ = gap; return true; }
+        OutputIterator _out;
+    };
+
+    template <class IntervalT>
+    struct first_visitor
+    {
+        typedef typename IntervalT::difference_type difference_type;
+
+        first_visitor(const difference_type& min_length): _min_length(min_length) {}
+        bool operator()(const IntervalT& gap)
+        {
+            if(gap.length() < _min_length)
+                return true;
+            _found = gap;
+            return false;
+        }
+
+        difference_type _min_length;
+        IntervalT       _found;
+    };
+
+    template <class IntervalT>
+    struct largest_visitor
+    {
+        bool operator()(const IntervalT& gap)
+        {
+            if(_largest.empty() || _largest.length() < gap.length())
+                _largest = gap;
+            return true;
+        }
+
+        IntervalT _largest;
+    };
+
+} // namespace Gap
+
+
+/// Write the free intervals of \c object within \c window to \c out in ascending order
+/** Gaps are the maximal intervals of \c window that are not covered by
+    segments of \c object. Gaps at the borders of \c window are clipped.
+    The segments overlapping \c window are visited once, so this takes
+    O(log n + k) for k segments in the window. */
+template <class ContainerT, class OutputIterator>
+OutputIterator gaps(const ContainerT& object, const typename ContainerT::interval_type& window,
+                    OutputIterator out)
+{
+    Gap::copy_visitor<typename ContainerT::interval_type, OutputIterator> visitor(out);
+    Gap::walk(object, window, visitor);
+    return visitor._out;
+}
+
+/// First gap of \c object within \c window that is at least \c min_length long
+/** Yields an empty interval, if there is no such gap. To find the first
+    free slot of length L after t, pass a window from t to a horizon. */
+template <class ContainerT>
+typename ContainerT::interval_type
+    first_gap(const ContainerT& object, const typename ContainerT::interval_type& window,
+              const typename ContainerT::difference_type& min_length)
+{
+    Gap::first_visitor<typename ContainerT::interval_type> visitor(min_length);
+    Gap::walk(object, window, visitor);
+    return visitor._found;
+}
+
+/// Largest gap of \c object within \c window; the first one, if there are several
+template <class ContainerT>
+typename ContainerT::interval_type
+    largest_gap(const ContainerT& object, const typename ContainerT::interval_type& window)
+{
+    Gap::largest_visitor<typename ContainerT::interval_type> visitor;
+    Gap::walk(object, window, visitor);
+    return visitor._largest;
+}
+
+/// Largest gap between the segments of \c object
+template <class ContainerT>
+typename ContainerT::interval_type largest_gap(const ContainerT& object)
+{
+    typedef typename ContainerT::interval_type interval_type;
+    if(object.empty())
+        return interval_type();
+    return largest_gap(object, Gap::segment_interval(*object.begin())
+                                   .span(Gap::segment_interval(*object.rbegin())));
+}
+
+}} // namespace itl boost
+
+#endif
+
@@ -0,0 +1,277 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+function interval_join
+    All overlapping pairs of two interval collections in one sweep
+--------------------------------------------------------------------*/
+#ifndef __itl_interval_join_JOFA_081028_H__
+#define __itl_interval_join_JOFA_081028_H__
+
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <boost/itl/interval.hpp>
+#include <boost/itl/parallel.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Join
+{
+    /// Interval type of the elements of an interval collection
+    template <class ElementT> struct interval_of;
+
+    template <class DomainT>
+    struct interval_of<itl::interval<DomainT> >
+    { typedef itl::interval<DomainT> type; };
+
+    template <class DomainT, class CodomainT>
+    struct interval_of<std::pair<itl::interval<DomainT>, CodomainT> >
+    { typedef itl::interval<DomainT> type; };
+
+    template <class DomainT, class CodomainT>
+    struct interval_of<std::pair<const itl::interval<DomainT>, CodomainT> >
+    { typedef itl::interval<DomainT> type; };
+
+    /// Copyable type of an element: Segments of maps have a const key
+    template <class ElementT>
+    struct element_of
+    { typedef ElementT type; };
+
+    template <class KeyT, class DataT>
+    struct element_of<std::pair<const KeyT, DataT> >
+    { typedef std::pair<KeyT, DataT> type; };
+
+    /// The interval of an element of an interval set or an interval map
+    template <class DomainT>
+    inline const itl::interval<DomainT>& key_interval(const itl::interval<DomainT>& element)
+    { return element; }
+
+    template <class IntervalT, class CodomainT>
+    inline const IntervalT& key_interval(const std::pair<IntervalT, CodomainT>& element)
+    { return element.first; }
+
+    // Removes the active elements that end before \c interv from \c active
+    template <class IteratorT, class IntervalT>
+    void retire(std::vector<IteratorT>& active, const IntervalT& interv)
+    {
+        typename std::vector<IteratorT>::iterator kept_ = active.begin();
+        for(typename std::vector<IteratorT>::iterator it_ = active.begin(); it_ != active.end(); ++it_)
+            if(!key_interval(**it_).exclusive_less(interv))
+                *kept_++ = *it_;
+        active.erase(kept_, active.end());
+    }
+
+    /// Pass all overlapping pairs of [left_, left_past) and [right_, right_past) to \c callback
+    /** Both ranges are sorted by the lower bounds of their intervals. The
+        intervals of a range may overlap each other. Elements are visited
+        in the order of their lower bounds. An element becomes active when
+        it is visited and overlaps the active elements of the other range
+        that have not ended before it. */
+    template <class LeftIteratorT, class RightIteratorT, class CallbackT>
+    void sweep(LeftIteratorT left_, LeftIteratorT left_past,
+               RightIteratorT right_, RightIteratorT right_past, CallbackT& callback)
+    {
+        typedef typename std::iterator_traits<LeftIteratorT>::value_type left_type;
+        typedef typename interval_of<left_type>::type                    interval_type;
+
+        std::vector<LeftIteratorT>  left_active;
+        std::vector<RightIteratorT> right_active;
+        interval_type overlap;
+
+        while(left_ != left_past || right_ != right_past)
+        {
+            if(right_ == right_past || (left_ != left_past
+                                        && !key_interval(*right_).lower_less(key_interval(*left_))))
+            {
+                interval_type left_interval = key_interval(*left_);
+                retire(right_active, left_interval);
+                if(right_ == right_past && right_active.empty())
+                    return; // Nothing left to overlap with
+
+                for(typename std::vector<RightIteratorT>::const_iterator active_ = right_active.begin();
+                    active_ != right_active.end(); ++active_)
+                {
+                    left_interval.intersect(overlap, key_interval(**active_));
+                    if(!overlap.empty())
+                        callback(*left_, **active_, overlap);
+                }
+                left_active.push_back(left_);
+                ++left_;
+            }
+            else
+            {
+                interval_type right_interval = key_interval(*right_);
+                retire(left_active, right_interval);
+                if(left_ == left_past && left_active.empty())
+                    return;
+
+                for(typename std::vector<LeftIteratorT>::const_iterator active_ = left_active.begin();
+                    active_ != left_active.end(); ++active_)
+                {
+                    key_interval(**active_).intersect(overlap, right_interval);
+                    if(!overlap.empty())
+                        callback(**active_, *right_, overlap);
+                }
+                right_active.push_back(right_);
+                ++right_;
+            }
+        }
+    }
+
+    template <class LeftIteratorT, class RightIteratorT, class CallbackT>
+    struct partition_task
+    {
+        partition_task(const std::vector<LeftIteratorT>& left_borders,
+                       const std::vector<RightIteratorT>& right_starts,
+                       RightIteratorT right_past, std::vector<CallbackT>& callbacks)
+            : _left_borders(&left_borders), _right_starts(&right_starts),
+              _right_past(right_past), _callbacks(&callbacks) {}
+
+        void operator()(unsigned part)const
+        {
+            sweep((*_left_borders)[part], (*_left_borders)[part+1],
+                  (*_right_starts)[part], _right_past, (*_callbacks)[part]);
+        }
+
+        const std::vector<LeftIteratorT>*  _left_borders;
+        const std::vector<RightIteratorT>* _right_starts;
+        RightIteratorT                     _right_past;
+        std::vector<CallbackT>*            _callbacks;
+    };
+
+} // namespace Join
+
+
+/// Element of an interval join: Two overlapping elements and their overlap
+template <class LeftT, class RightT>
+struct join_triple
+{
+    typedef typename Join::interval_of<LeftT>::type interval_type;
+
+    join_triple(){}
+    join_triple(const LeftT& left_, const RightT& right_, const interval_type& overlap_)
+        : left(left_), right(right_), overlap(overlap_) {}
+
+    LeftT         left;
+    RightT        right;
+    interval_type overlap;
+};
+
+namespace Join
+{
+    /// Callback that writes the joined triples to an output iterator
+    template <class OutputIterator>
+    struct writer
+    {
+        writer(OutputIterator out): _out(out) {}
+
+        template <class LeftT, class RightT, class IntervalT>
+        void operator()(const LeftT& left, const RightT& right, const IntervalT& overlap)
+        {
+            *_out++ = join_triple<typename element_of<LeftT>::type,
+                                  typename element_of<RightT>::type>(left, right, overlap);
+        }
+
+        OutputIterator _out;
+    };
+}
+
+/// Callback for interval_join that writes join_triple objects to \c out
+template <class OutputIterator>
+Join::writer<OutputIterator> join_writer(OutputIterator out)
+{ return Join::writer<OutputIterator>(out); }
+
+
+/// Pass all pairs of overlapping elements of two interval collections to \c callback
+/** [left_first, left_past) and [right_first, right_past) are ranges of
+    intervals or of interval value pairs that are sorted by the lower bounds
+    of their intervals. The ranges of interval containers are sorted.
+    For every pair of overlapping elements
+    <tt>callback(left, right, overlap)</tt> is called, where \c overlap is
+    the intersection of their intervals. Nothing is copied: A single sweep
+    visits the elements in the order of their lower bounds, so joining
+    collections of n and m elements takes O(n + m + k) for k overlapping
+    pairs, if few elements of a range overlap each other.
+
+    \code
+    std::vector<join_triple<interval<int>, std::pair<interval<int>,int> > > triples;
+    interval_join(bookings.begin(), bookings.end(), tariffs.begin(), tariffs.end(),
+                  join_writer(std::back_inserter(triples)));
+    \endcode
+*/
+template <class LeftIteratorT, class RightIteratorT, class CallbackT>
+CallbackT interval_join(LeftIteratorT left_first, LeftIteratorT left_past,
+                        RightIteratorT right_first, RightIteratorT right_past,
+                        CallbackT callback)
+{
+    Join::sweep(left_first, left_past, right_first, right_past, callback);
+    return callback;
+}
+
+/// Pass all pairs of overlapping elements of interval containers \c left and \c right to \c callback
+template <class LeftT, class RightT, class CallbackT>
+CallbackT interval_join(const LeftT& left, const RightT& right, CallbackT callback)
+{
+    return interval_join(left.begin(), left.end(), right.begin(), right.end(), callback);
+}
+
+
+/// Join two interval collections in partitions that are processed concurrently
+/** The left range is split into <tt>callbacks.size()</tt> parts of equal
+    size. Pairs with left elements of part \c p are passed to
+    <tt>callbacks[p]</tt>, so callbacks need not be synchronized. The parts
+    are joined in threads of their own, if ITL_USE_BOOST_THREAD is defined
+    (see parallel.hpp). The elements of the right range that end before a
+    part are skipped by a sequential pass beforehand. */
+template <class LeftIteratorT, class RightIteratorT, class CallbackT>
+void partitioned_interval_join(LeftIteratorT left_first, LeftIteratorT left_past,
+                               RightIteratorT right_first, RightIteratorT right_past,
+                               std::vector<CallbackT>& callbacks)
+{
+    unsigned parts = static_cast<unsigned>(callbacks.size());
+    std::size_t size = std::distance(left_first, left_past);
+
+    std::vector<LeftIteratorT>  left_borders;
+    std::vector<RightIteratorT> right_starts;
+    LeftIteratorT  left_  = left_first;
+    RightIteratorT right_ = right_first;
+    std::size_t position = 0;
+    for(unsigned part = 0; part < parts; part++)
+    {
+        std::size_t border = Parallel::part_border(size, part, parts);
+        std::advance(left_, border - position);
+        position = border;
+        left_borders.push_back(left_);
+
+        // Right elements that end before the first left element of the part
+        // cannot overlap elements of this part or the following ones
+        if(left_ != left_past)
+            while(right_ != right_past
+                  && Join::key_interval(*right_).exclusive_less(Join::key_interval(*left_)))
+                ++right_;
+        right_starts.push_back(right_);
+    }
+    left_borders.push_back(left_past);
+
+    Parallel::run(Join::partition_task<LeftIteratorT,RightIteratorT,CallbackT>
+                      (left_borders, right_starts, right_past, callbacks), parts);
+}
+
+/// Join interval containers \c left and \c right in <tt>callbacks.size()</tt> partitions
+template <class LeftT, class RightT, class CallbackT>
+void partitioned_interval_join(const LeftT& left, const RightT& right, std::vector<CallbackT>& callbacks)
+{
+    partitioned_interval_join(left.begin(), left.end(), right.begin(), right.end(), callbacks);
+}
+
+}} // namespace itl boost
+
+#endif
+
@@ -15,6 +15,7 @@ class interval_map
 #include <boost/assert.hpp>
 #include <boost/itl/interval_set.hpp>
 #include <boost/itl/interval_base_map.hpp>
+#include <boost/itl/interval_rewrite.hpp>
 #include <boost/itl/interval_maps.hpp>
 
 namespace boost{namespace itl
@@ -205,35 +206,6 @@ private:
         return !value.KEY_VALUE.empty() 
             && !(Traits::absorbs_neutrons && value.CONT_VALUE == CodomainT()); 
     }
-
-    bool join_left(iterator& it);
-    bool join_right(iterator& it);
-    void join_neighbours(iterator& it){ join_left(it); join_right(it); };
-    bool joinable(const iterator& some, const iterator& next)const;
-    iterator joint_insert(iterator& some, const iterator& next);
-
-    template<template<class>class Combinator>
-    iterator fill_gap_join_left(const value_type&);
-
-    template<template<class>class Combinator>
-    iterator fill_gap_join_both(const value_type&);
-
-    iterator fill_join_left(const value_type&);
-    iterator fill_join_both(const value_type&);
-
-    template<template<class>class Combinator>
-    void add_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it);
-
-    template<template<class>class Combinator>
-    void add_rear(const interval_type& x_itv, const CodomainT& x_val, iterator& it);
-
-    template<template<class>class Combinator>
-    void subtract_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it);
-
-    void insert_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it);
-    void insert_rear(const interval_type& x_itv, const CodomainT& x_val, iterator& it);
-
-    void erase_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it);
 } ;
 
 
@@ -279,188 +251,6 @@ void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>::getResiduals
 }
 
 
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-bool interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::joinable(const iterator& some, const iterator& next)const
-{
-    // assert: next != end && some++ == next
-    return some->KEY_VALUE.touches(next->KEY_VALUE) 
-        && some->CONT_VALUE == next->CONT_VALUE; 
-}
-
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-typename interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>::iterator 
-    interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::joint_insert(iterator& left_it, const iterator& right_it)
-{
-    // both left and right are in the set and they are neighbours
-    BOOST_ASSERT(right_it != _map.end());
-    BOOST_ASSERT(left_it->KEY_VALUE.exclusive_less(right_it->KEY_VALUE));
-    BOOST_ASSERT(left_it->KEY_VALUE.touches(right_it->KEY_VALUE));
-
-    interval_type interval    = left_it->KEY_VALUE;
-    //It has to be a copy, because is location will be erased 
-    //JODO: Try optimizing inplace.
-    CodomainT value = left_it->CONT_VALUE;
-    interval.extend(right_it->KEY_VALUE);
-
-    this->_map.erase(left_it);
-    this->_map.erase(right_it);
-    
-    std::pair<iterator,bool> insertion = this->_map.insert(make_pair(interval, value));
-    iterator new_it = insertion.ITERATOR;
-    BOOST_ASSERT(insertion.WAS_SUCCESSFUL);
-    BOOST_ASSERT(new_it!=this->_map.end());
-    left_it = new_it;
-    return new_it;
-}
-
-
-
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-bool interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::join_left(iterator& it)
-{
-    if(it == this->_map.begin())
-        return false;
-
-    // there is a predecessor
-    iterator it_pred = it; it_pred-- ;
-
-    if(joinable(it_pred, it)) 
-    {
-        iterator it_leftExtended = joint_insert(it_pred, it);
-        //CAUTION: it is now invalidated
-        it = it_leftExtended;
-        return true;
-    }
-
-    return false;
-}
-
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-bool interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::join_right(iterator& it)
-{
-    if(it == this->_map.end())
-        return false;
-
-    // there is a successor
-    iterator it_succ = it; it_succ++ ;
-
-    if(it_succ != this->_map.end() && joinable(it, it_succ)) 
-    {
-        joint_insert(it, it_succ);
-        return true;
-    }
-
-    return false;
-}
-
-
-
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-typename interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>::iterator
-interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::fill_join_left(const value_type& value)
-{
-    //collision free insert is asserted
-    if(value.KEY_VALUE.empty())
-        return this->_map.end();
-    if(Traits::absorbs_neutrons && value.CONT_VALUE == CodomainT())
-        return this->_map.end();
-
-    std::pair<iterator,bool> insertion = this->_map.insert(value);
-
-    join_left(insertion.ITERATOR);
-
-    return insertion.ITERATOR; //JODO return value currently unused
-}
-
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-typename interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>::iterator
-interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::fill_join_both(const value_type& value)
-{
-    //collision free insert is asserted
-    if(value.KEY_VALUE.empty())
-        return this->_map.end();
-    if(Traits::absorbs_neutrons && value.CONT_VALUE == CodomainT())
-        return this->_map.end();
-
-    std::pair<iterator,bool> insertion = this->_map.insert(value);
-
-    join_neighbours(insertion.ITERATOR);
-
-    return insertion.ITERATOR;
-}
-
-//-----------------------------------------------------------------------------
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-typename interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>::iterator
-interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::fill_gap_join_left(const value_type& value)
-{
-    static Combinator<CodomainT> combine;
-    //collision free insert is asserted
-    if(value.KEY_VALUE.empty())
-        return this->_map.end();
-    if(Traits::absorbs_neutrons && value.CONT_VALUE == CodomainT())
-        return this->_map.end();
-
-    std::pair<iterator,bool> insertion;
-    if(Traits::emits_neutrons)
-    {
-        CodomainT added_val = CodomainT();
-        combine(added_val, value.CONT_VALUE);
-        insertion = this->_map.insert(value_type(value.KEY_VALUE, added_val));
-    }
-    else
-        insertion = this->_map.insert(value);
-
-    join_left(insertion.ITERATOR);
-
-    return insertion.ITERATOR; //JODO return value currently unused
-}
-
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-typename interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>::iterator
-interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::fill_gap_join_both(const value_type& value)
-{
-    static Combinator<CodomainT> combine;
-    //collision free insert is asserted
-    if(value.KEY_VALUE.empty())
-        return this->_map.end();
-    if(Traits::absorbs_neutrons && value.CONT_VALUE == CodomainT())
-        return this->_map.end();
-
-    std::pair<iterator,bool> insertion;
-    if(Traits::emits_neutrons)
-    {
-        CodomainT added_val = CodomainT();
-        combine(added_val, value.CONT_VALUE);
-        insertion = this->_map.insert(value_type(value.KEY_VALUE, added_val));
-    }
-    else
-        insertion = this->_map.insert(value);
-
-    join_neighbours(insertion.ITERATOR);
-
-    return insertion.ITERATOR;
-}
-
-
 //-----------------------------------------------------------------------------
 // add<Combinator>(pair(interval,value)):
 //-----------------------------------------------------------------------------
@@ -469,178 +259,9 @@ template <typename DomainT, typename CodomainT, class Traits, template<class>cla
 void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
     ::add_(const value_type& x)
 {
-    static Combinator<CodomainT> combine;
-
-    const interval_type& x_itv = x.KEY_VALUE;
-    if(x_itv.empty()) 
-        return;
-
-    const CodomainT& x_val = x.CONT_VALUE;
-    if(Traits::absorbs_neutrons && x_val==CodomainT()) 
-        return;
-
-    std::pair<iterator,bool> insertion;
-    if(Traits::emits_neutrons)
-    {
-        CodomainT added_val = CodomainT();
-        combine(added_val, x_val);
-        insertion = this->_map.insert(value_type(x_itv, added_val));
-    }
-    else
-        insertion = this->_map.insert(x);
-
-    if(insertion.WAS_SUCCESSFUL)
-        join_neighbours(insertion.ITERATOR);
-    else
-    {
-        // Detect the first and the end iterator of the collision sequence
-        iterator fst_it = this->_map.lower_bound(x_itv);
-        iterator end_it = insertion.ITERATOR;
-        if(end_it != this->_map.end())
-            end_it++; 
-        //assert(end_it == this->_map.upper_bound(x_itv));
-
-        interval_type fst_itv = (*fst_it).KEY_VALUE;
-        CodomainT cur_val     = (*fst_it).CONT_VALUE;
-
-
-        interval_type leadGap; x_itv.left_surplus(leadGap, fst_itv);
-        // this is a new Interval that is a gap in the current map
-        //The first collision interval may grow by joining neighbours after insertion
-
-        // only for the first there can be a leftResid: a part of *it left of x
-        interval_type leftResid;  
-        fst_itv.left_surplus(leftResid, x_itv);
-
-        // handle special case for first
-
-        interval_type interSec;
-        fst_itv.intersect(interSec, x_itv);
-
-        CodomainT cmb_val = cur_val;
-        combine(cmb_val, x_val);
-
-        iterator snd_it = fst_it; snd_it++; 
-
-        if(snd_it == end_it) 
-        {
-            // first == last
-
-            interval_type endGap; x_itv.right_surplus(endGap, fst_itv);
-            // this is a new Interval that is a gap in the current map
-
-            // only for the last there can be a rightResid: a part of *it right of x
-            interval_type rightResid;  (*fst_it).KEY_VALUE.right_surplus(rightResid, x_itv);
-
-            this->_map.erase(fst_it);
-            fill_join_left(value_type(leftResid,  cur_val));
-
-            if(endGap.empty() && rightResid.empty())
-                fill_join_both(value_type(interSec,   cmb_val));
-            else
-                fill_join_left(value_type(interSec,   cmb_val));
-
-            if(!leadGap.empty())
-                fill_gap_join_both<Combinator>(value_type(leadGap, x_val));
-            if(!endGap.empty())
-                fill_gap_join_both<Combinator>(value_type(endGap, x_val));
-            else
-                fill_join_left(value_type(rightResid, cur_val));
-        }
-        else
-        {
-            this->_map.erase(fst_it);
-            fill_join_left(value_type(leftResid, cur_val));
-            fill_join_left(value_type(interSec,  cmb_val));
-
-            if(!leadGap.empty())
-                fill_gap_join_both<Combinator>(value_type(leadGap, x_val));
-
-            // shrink interval
-            interval_type x_rest(x_itv);
-            x_rest.left_subtract(fst_itv);
-
-            add_rest<Combinator>(x_rest, x_val, snd_it, end_it);
-        }
-    }
-}
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::add_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it)
-{
-    static Combinator<CodomainT> combine;
-
-    iterator nxt_it = it; nxt_it++;
-    interval_type x_rest = x_itv, left_gap, common, cur_itv;
-
-    while(nxt_it!=end_it)
-    {
-        cur_itv = (*it).KEY_VALUE ;            
-        x_rest.left_surplus(left_gap, cur_itv);
-
-        combine(it->CONT_VALUE, x_val);
-        fill_gap_join_left<Combinator>(value_type(left_gap, x_val)); //A posteriori
-
-        if(Traits::absorbs_neutrons && it->CONT_VALUE == CodomainT())
-            this->_map.erase(it++);
-        else
-        {
-            // after filling that gap there may be another joining opportunity
-            join_left(it);
-            it++;
-        }
-
-        // shrink interval
-        x_rest.left_subtract(cur_itv);
-        nxt_it++;
-    }
-
-    add_rear<Combinator>(x_rest, x_val, it);
+    Rewrite::add<Combinator>(this->_map, x.KEY_VALUE, x.CONT_VALUE, true);
 }
 
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::add_rear(const interval_type& x_rest, const CodomainT& x_val, iterator& it)
-{
-    static Combinator<CodomainT> combine;
-
-    interval_type cur_itv = (*it).KEY_VALUE ;
-    CodomainT     cur_val = (*it).CONT_VALUE ;
-
-    interval_type lead_gap;
-    x_rest.left_surplus(lead_gap, cur_itv);
-
-    interval_type common;
-    cur_itv.intersect(common, x_rest);
-
-    CodomainT cmb_val = cur_val;
-    combine(cmb_val, x_val);
-
-    interval_type end_gap; 
-    x_rest.right_surplus(end_gap, cur_itv);
-    
-    // only for the last there can be a rightResid: a part of *it right of x
-    interval_type right_resid;  
-    cur_itv.right_surplus(right_resid, x_rest);
-
-    this->_map.erase(it);
-    if(end_gap.empty() && right_resid.empty())
-        fill_join_both(value_type(common,   cmb_val));
-    else
-        fill_join_left(value_type(common,   cmb_val));
-
-    if(!lead_gap.empty())
-        fill_gap_join_both<Combinator>(value_type(lead_gap, x_val));
-    if(!end_gap.empty())
-        fill_gap_join_both<Combinator>(value_type(end_gap, x_val));
-    else
-        fill_join_left(value_type(right_resid, cur_val));
-}
-
-
 //-----------------------------------------------------------------------------
 // subtract<Combinator>(pair(interval,value)):
 //-----------------------------------------------------------------------------
@@ -649,136 +270,7 @@ template <typename DomainT, typename CodomainT, class Traits, template<class>cla
 void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
     ::subtract_(const value_type& x)
 {
-    static Combinator<CodomainT> combine;
-    const interval_type& x_itv = x.KEY_VALUE;
-
-    if(x_itv.empty()) 
-        return;
-
-    const CodomainT& x_val = x.CONT_VALUE;
-    if(Traits::absorbs_neutrons && x_val==CodomainT()) 
-        return;
-
-    iterator fst_it = this->_map.lower_bound(x_itv);
-    if(fst_it==this->_map.end()) return;
-    iterator end_it = this->_map.upper_bound(x_itv);
-    if(fst_it==end_it) return;
-
-    interval_type fst_itv = (*fst_it).KEY_VALUE ;
-    // must be copies because fst_it will be erased
-    CodomainT fst_val = (*fst_it).CONT_VALUE ;
-
-    // only for the first there can be a leftResid: a part of *it left of x
-    interval_type leftResid;  
-    fst_itv.left_surplus(leftResid, x_itv);
-
-    // handle special case for first
-
-    interval_type interSec;
-    fst_itv.intersect(interSec, x_itv);
-
-    CodomainT cmb_val = fst_val;
-    combine(cmb_val, x_val);
-
-    iterator snd_it = fst_it; snd_it++;
-    if(snd_it == end_it) 
-    {
-        // only for the last there can be a rightResid: a part of *it right of x
-        interval_type rightResid;  (*fst_it).KEY_VALUE.right_surplus(rightResid, x_itv);
-
-        this->_map.erase(fst_it);
-        fill_join_left(value_type(leftResid, fst_val));
-
-        if(rightResid.empty())
-            fill_join_both(value_type(interSec,   cmb_val));
-        else
-            fill_join_left(value_type(interSec,   cmb_val));
-
-        fill_join_both(value_type(rightResid, fst_val));
-    }
-    else
-    {
-        // first AND NOT last
-        this->_map.erase(fst_it);
-        
-        fill_join_left(value_type(leftResid, fst_val));
-        fill_join_left(value_type(interSec,  cmb_val));
-
-        // shrink interval
-        interval_type x_rest(x_itv);
-        x_rest.left_subtract(fst_itv);
-
-        subtract_rest<Combinator>(x_rest, x_val, snd_it, end_it);
-    }
-}
-
-
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::subtract_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it)
-{
-    static Combinator<CodomainT> combine;
-    iterator nxt_it=it; nxt_it++;
-
-    while(nxt_it!=end_it)
-    {
-        CodomainT& cur_val = (*it).CONT_VALUE ;
-        combine(cur_val, x_val);
-
-        if(Traits::absorbs_neutrons && cur_val==CodomainT())
-            this->_map.erase(it++); 
-        else
-        {
-            join_left(it);
-            it++;
-        }
-
-        nxt_it=it; nxt_it++;
-    }
-
-    // it refers the last overlaying intervals of x_itv
-    const interval_type& cur_itv = (*it).KEY_VALUE ;
-
-    interval_type rightResid; 
-    cur_itv.right_surplus(rightResid, x_itv);
-
-    if(rightResid.empty())
-    {
-        CodomainT& cur_val = (*it).CONT_VALUE ;
-        combine(cur_val, x_val);
-        if(Traits::absorbs_neutrons && cur_val==CodomainT())
-            this->_map.erase(it);
-        else
-        {
-            join_left(it);
-            // cur_val is the last -= modified value. There may be an
-            // adjoint right neighbour that is now joinable.
-            if(it != this->_map.end())
-            {
-                iterator out_it = it; out_it++;
-                if(out_it != this->_map.end() && joinable(it, out_it))
-                    joint_insert(it,out_it);
-            }
-        }
-    }
-    else
-    {
-        CodomainT cur_val = (*it).CONT_VALUE ;
-        CodomainT cmb_val = cur_val ;
-        combine(cmb_val, x_val);
-        interval_type interSec; 
-        cur_itv.intersect(interSec, x_itv);
-
-        this->_map.erase(it);
-        if(rightResid.empty())
-            fill_join_both(value_type(interSec, cmb_val));
-        else
-            fill_join_left(value_type(interSec, cmb_val));
-
-        fill_join_both(value_type(rightResid, cur_val));
-    }
+    Rewrite::subtract<Combinator>(this->_map, x.KEY_VALUE, x.CONT_VALUE, true);
 }
 
 
@@ -791,119 +283,7 @@ template <typename DomainT, typename CodomainT, class Traits, template<class>cla
 void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
     ::insert_(const value_type& x)
 {
-    const interval_type& x_itv = x.KEY_VALUE;
-    if(x_itv.empty()) 
-        return;
-
-    const CodomainT& x_val = x.CONT_VALUE;
-    if(Traits::absorbs_neutrons && x_val==CodomainT()) 
-        return;
-
-    std::pair<typename ImplMapT::iterator,bool> 
-        insertion = this->_map.insert(x);
-
-    if(insertion.WAS_SUCCESSFUL)
-        join_neighbours(insertion.ITERATOR);
-    else
-    {
-        // Detect the first and the end iterator of the collision sequence
-        iterator fst_it = this->_map.lower_bound(x_itv);
-        iterator end_it = insertion.ITERATOR;
-        if(end_it != this->_map.end())
-            end_it++; 
-        //assert(end_it == this->_map.upper_bound(x_itv));
-
-        interval_type fst_itv = (*fst_it).KEY_VALUE ;
-        interval_type leadGap; x_itv.left_surplus(leadGap, fst_itv);
-        // this is a new Interval that is a gap in the current map
-
-        // only for the first there can be a leftResid: a part of *it left of x
-        interval_type leftResid;  fst_itv.left_surplus(leftResid, x_itv);
-
-        // handle special case for first
-
-        interval_type interSec;
-        fst_itv.intersect(interSec, x_itv);
-
-        iterator snd_it = fst_it; snd_it++;
-        if(snd_it == end_it) 
-        {
-            //Fill gap after iterator compare bcause iterators are modified by joining
-            if(!leadGap.empty())
-                fill_join_both(value_type(leadGap, x_val));
-
-            interval_type endGap; x_itv.right_surplus(endGap, fst_itv);
-            // this is a new Interval that is a gap in the current map
-            fill_join_both(value_type(endGap, x_val));
-        }
-        else
-        {
-            if(!leadGap.empty())
-                fill_join_both(value_type(leadGap, x_val));
-
-            // shrink interval
-            interval_type x_rest(x_itv);
-            x_rest.left_subtract(fst_itv);
-
-            insert_rest(x_rest, x_val, snd_it, end_it);
-        }
-    }
-}
-
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, 
-          template<class>class Compare, template<class>class Alloc>
-void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::insert_rest(const interval_type& x_itv, const CodomainT& x_val, 
-                  iterator& it, iterator& end_it)
-{
-    iterator nxt_it = it; nxt_it++;
-    interval_type x_rest = x_itv, gap, common, cur_itv;
-
-    for(; nxt_it!=end_it; ++it, ++nxt_it)
-    {
-        cur_itv = (*it).KEY_VALUE ;            
-        x_rest.left_surplus(gap, cur_itv);
-
-        if(!gap.empty())
-        {
-            fill_join_left(value_type(gap, x_val));
-            // after filling that gap there may be another joining opportunity
-            join_left(it);
-        }
-
-        // shrink interval
-        x_rest.left_subtract(cur_itv);
-    }
-
-    insert_rear(x_rest, x_val, it);
-}
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, 
-          template<class>class Compare, template<class>class Alloc>
-void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::insert_rear(const interval_type& x_rest, const CodomainT& x_val, 
-                  iterator& it)
-{
-    interval_type cur_itv = (*it).KEY_VALUE ;
-
-    interval_type left_gap;
-    x_rest.left_surplus(left_gap, cur_itv);
-
-    if(!left_gap.empty())
-    {
-        fill_join_left(value_type(left_gap, x_val));
-        // after filling that gap there may be another joining opportunity
-        join_left(it);
-    }
-
-    interval_type common;
-    cur_itv.intersect(common, x_rest);
-
-    interval_type end_gap; 
-    x_rest.right_surplus(end_gap, cur_itv);
-
-    fill_join_both(value_type(end_gap, x_val));
+    Rewrite::insert(this->_map, x.KEY_VALUE, x.CONT_VALUE, true);
 }
 
 
@@ -914,103 +294,7 @@ template <typename DomainT, typename CodomainT, class Traits, template<class>cla
 void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
     ::erase_(const value_type& x)
 {
-    const interval_type& x_itv = x.KEY_VALUE;
-    if(x_itv.empty()) 
-        return;
-
-    const CodomainT& x_val = x.CONT_VALUE;
-    if(Traits::absorbs_neutrons && x_val==CodomainT()) 
-        return;
-
-    iterator fst_it = this->_map.lower_bound(x_itv);
-    if(fst_it==this->_map.end()) return;
-    iterator end_it = this->_map.upper_bound(x_itv);
-    if(fst_it==end_it) return;
-
-    interval_type fst_itv = (*fst_it).KEY_VALUE ;
-    // must be copies because fst_it will be erased
-    CodomainT fst_val = (*fst_it).CONT_VALUE ;
-
-    // only for the first there can be a leftResid: a part of *it left of x
-    interval_type leftResid;  
-    fst_itv.left_surplus(leftResid, x_itv);
-
-    // handle special case for first
-
-    interval_type interSec;
-    fst_itv.intersect(interSec, x_itv);
-
-    iterator snd_it = fst_it; snd_it++;
-    if(snd_it == end_it) 
-    {
-        // only for the last there can be a rightResid: a part of *it right of x
-        interval_type rightResid;  (*fst_it).KEY_VALUE.right_surplus(rightResid, x_itv);
-
-        if(!interSec.empty() && fst_val == x_val)
-        {
-            this->_map.erase(fst_it);
-            insert_(value_type(leftResid,  fst_val));
-            // erased: insert(value_type(interSec,  cmb_val));
-            insert_(value_type(rightResid, fst_val));
-        }
-    }
-    else
-    {
-        // first AND NOT last
-        if(!interSec.empty() && fst_val == x_val)
-        {
-            this->_map.erase(fst_it);
-            insert_(value_type(leftResid, fst_val));
-            // erased: insert(value_type(interSec,  cmb_val));
-        }
-
-        erase_rest(x_itv, x_val, snd_it, end_it);
-    }
-}
-
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-void interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::erase_rest(const interval_type& x_itv, const CodomainT& x_val, 
-                 iterator& it, iterator& end_it)
-{
-    iterator nxt_it=it; nxt_it++;
-
-    // For all intervals within loop: it->KEY_VALUE are contained_in x_itv
-    while(nxt_it!=end_it)
-    {
-        if((*it).CONT_VALUE == x_val)
-            this->_map.erase(it++); 
-        else it++;
-
-        nxt_it=it; nxt_it++;
-    }
-
-    // it refers the last overlaying intervals of x_itv
-    interval_type cur_itv = (*it).KEY_VALUE ;
-    // Has to be a copy, cause 'it' will be erased
-    CodomainT cur_val = (*it).CONT_VALUE;
-
-    interval_type rightResid; 
-    cur_itv.right_surplus(rightResid, x_itv);
-
-    if(rightResid.empty())
-    {
-        if(cur_val == x_val)
-            this->_map.erase(it);
-    }
-    else
-    {
-        interval_type interSec; 
-        cur_itv.intersect(interSec, x_itv);
-
-        if(!interSec.empty() && cur_val == x_val)
-        {
-            this->_map.erase(it);
-            //erased: insert(value_type(interSec, cmb_val));
-            insert_(value_type(rightResid, cur_val));
-        }
-    }
+    Rewrite::erase(this->_map, x.KEY_VALUE, x.CONT_VALUE, true);
 }
 
 
@@ -1030,6 +314,10 @@ template <class KeyT, class DataT, class Traits>
 struct is_interval_splitter<itl::interval_map<KeyT,DataT,Traits> >
 { enum{value = true}; };
 
+template <class KeyT, class DataT, class Traits>
+struct is_interval_joiner<itl::interval_map<KeyT,DataT,Traits> >
+{ enum{value = true}; };
+
 template <class KeyT, class DataT, class Traits>
 struct is_neutron_absorber<itl::interval_map<KeyT,DataT,Traits> >
 { enum{value = Traits::absorbs_neutrons}; };
@@ -138,6 +138,34 @@ bool is_element_equal(const LeftT& left, const RightT& right)
     return step.result();
 }
 
+/// Are \c left and \c right equal, if segments with neutral values are ignored?
+/** Segments are compared pairwise, skipping the ones associated with
+    <tt>codomain_type()</tt> on both sides. So this equals comparing
+    copies of both maps after <tt>absorb_neutrons()</tt>, without the
+    copies. */
+template<class MapT>
+bool is_protonic_equal(const MapT& left, const MapT& right)
+{
+    typedef typename MapT::const_iterator const_iterator;
+    typedef typename MapT::codomain_type  codomain_type;
+
+    const_iterator left_ = left.begin(), right_ = right.begin();
+    for(;;)
+    {
+        while(left_ != left.end() && (*left_).CONT_VALUE == codomain_type())
+            ++left_;
+        while(right_ != right.end() && (*right_).CONT_VALUE == codomain_type())
+            ++right_;
+
+        if(left_ == left.end() || right_ == right.end())
+            return left_ == left.end() && right_ == right.end();
+        if(!((*left_).KEY_VALUE == (*right_).KEY_VALUE && (*left_).CONT_VALUE == (*right_).CONT_VALUE))
+            return false;
+        ++left_;
+        ++right_;
+    }
+}
+
 } //Map
     
 }} // namespace itl boost
@@ -28,9 +28,16 @@ DEALINGS IN THE SOFTWARE.
 #ifndef __itl_interval_morphism_H_JOFA_080315__
 #define __itl_interval_morphism_H_JOFA_080315__
 
+#include <iterator>
 #include <boost/itl/notate.hpp>
+#include <boost/itl/type_traits/is_set.hpp>
+#include <boost/itl/type_traits/is_continuous.hpp>
+#include <boost/itl/type_traits/is_interval_joiner.hpp>
+#include <boost/itl/type_traits/succ_pred.hpp>
 namespace boost{namespace itl
 {
+    template <typename DomainT> class bitmap_interval_set;
+
     namespace Interval
     {
         template <typename ElementContainerT, typename IntervalContainerT>
@@ -48,18 +55,136 @@ namespace boost{namespace itl
             }
         }
 
+        /** Runs of consecutive elements with equal data are added as one
+            interval. Since elements are visited in ascending order, each
+            interval is appended using the previous one as hint. */
         template <typename IntervalContainerT, typename ElementContainerT>
         void cluster(IntervalContainerT& result, const ElementContainerT& src)
         {
-            const_FORALL(typename ElementContainerT, element_, src)
+            typedef typename ElementContainerT::key_type     key_type;
+            typedef typename ElementContainerT::data_type    data_type;
+            typedef typename IntervalContainerT::interval_type interval_type;
+
+            // Containers that do not join touching intervals, get an interval per element
+            const bool joins_runs = is_interval_joiner<IntervalContainerT>::value
+                                 && !is_continuous<key_type>::value;
+
+            typename IntervalContainerT::iterator prior_ = result.end();
+            typename ElementContainerT::const_iterator element_ = src.begin(), next_;
+            while(element_ != src.end())
             {
-                const typename ElementContainerT::key_type&  key  = ElementContainerT::key_value(element_);
-                const typename ElementContainerT::data_type& data = ElementContainerT::data_value(element_);
+                const key_type&  first = ElementContainerT::key_value(element_);
+                const data_type& data  = ElementContainerT::data_value(element_);
+                key_type last = first;
 
-                result += IntervalContainerT::make_domain_element(key, data);
+                for(next_ = element_, ++next_; joins_runs && next_ != src.end(); ++next_)
+                {
+                    if(!(pred(ElementContainerT::key_value(next_)) == last)
+                        || !(is_set<ElementContainerT>::value || ElementContainerT::data_value(next_) == data))
+                        break;
+                    last = ElementContainerT::key_value(next_);
+                }
+
+                prior_ = result.add(prior_, IntervalContainerT::make_segment(
+                                                interval_type(first, last, interval_type::CLOSED), data));
+                element_ = next_;
             }
         }
 
+        /// A bitmap_interval_set is atomized by a pass over its chunks
+        template <typename ElementContainerT, typename DomainT>
+        void atomize(ElementContainerT& result, const bitmap_interval_set<DomainT>& src)
+        {
+            src.atomize(result);
+        }
+
+        /// Ordered elements are clustered into the chunks of a bitmap_interval_set directly
+        template <typename DomainT, typename ElementContainerT>
+        void cluster(bitmap_interval_set<DomainT>& result, const ElementContainerT& src)
+        {
+            result.cluster(src);
+        }
+
+        /// Iterator over the elements of an interval container
+        /** element_iterator visits the elements of an interval container in
+            ascending order and yields them as the values of its atomized_type,
+            like <tt>atomize</tt> inserts them. So elements can be streamed
+            without building an element container. */
+        template <typename IntervalContainerT>
+        class element_iterator
+        {
+        public:
+            typedef typename IntervalContainerT::atomized_type  atomized_type;
+            typedef typename IntervalContainerT::domain_type    domain_type;
+            typedef typename IntervalContainerT::const_iterator segment_iterator;
+
+            typedef std::input_iterator_tag           iterator_category;
+            typedef typename atomized_type::value_type value_type;
+            typedef std::ptrdiff_t                    difference_type;
+            typedef const value_type*                 pointer;
+            typedef value_type                        reference;
+
+            element_iterator(){}
+            element_iterator(const segment_iterator& segment_, const segment_iterator& end_)
+                : _segment(segment_), _end(end_) { first_element(); }
+
+            /// The segment that contains the current element
+            const segment_iterator& segment()const { return _segment; }
+
+            value_type operator*()const
+            {
+                segment_iterator segment_ = _segment;
+                return atomized_type::make_element(_element, IntervalContainerT::codomain_value(segment_));
+            }
+
+            element_iterator& operator++()
+            {
+                segment_iterator segment_ = _segment;
+                if(_element == IntervalContainerT::key_value(segment_).last())
+                {
+                    ++_segment;
+                    first_element();
+                }
+                else
+                    ++_element;
+                return *this;
+            }
+
+            element_iterator operator++(int)
+            { element_iterator it_ = *this; ++*this; return it_; }
+
+            bool operator == (const element_iterator& rhs)const
+            { return _segment == rhs._segment && (_segment == _end || _element == rhs._element); }
+            bool operator != (const element_iterator& rhs)const { return !(*this == rhs); }
+
+        private:
+            void first_element()
+            {
+                for(; _segment != _end; ++_segment)
+                {
+                    segment_iterator segment_ = _segment;
+                    if(!IntervalContainerT::key_value(segment_).empty())
+                    {
+                        _element = IntervalContainerT::key_value(segment_).first();
+                        return;
+                    }
+                }
+            }
+
+        private:
+            segment_iterator _segment;
+            segment_iterator _end;
+            domain_type      _element;
+        };
+
+        template <typename IntervalContainerT>
+        element_iterator<IntervalContainerT> elements_begin(const IntervalContainerT& object)
+        { return element_iterator<IntervalContainerT>(object.begin(), object.end()); }
+
+        template <typename IntervalContainerT>
+        element_iterator<IntervalContainerT> elements_end(const IntervalContainerT& object)
+        { return element_iterator<IntervalContainerT>(object.end(), object.end()); }
+
         template <typename AtomizedType, typename ClusteredType>
         struct Atomize
         {
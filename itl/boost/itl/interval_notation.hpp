@@ -0,0 +1,396 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+functions write_notation, parse_notation
+    Streaming writer and parser of the string notation of interval containers
+--------------------------------------------------------------------*/
+#ifndef __itl_interval_notation_JOFA_081102_H__
+#define __itl_interval_notation_JOFA_081102_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <ostream>
+#include <limits>
+#include <utility>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/itl/interval.hpp>
+#include <boost/itl/type_traits/to_string.hpp>
+
+namespace boost{namespace itl
+{
+
+/** \file interval_notation.hpp
+
+    The notation of \c as_string: Interval sets are written as sequences of
+    intervals <tt>[1,3)[5,7]</tt>, interval maps as sequences of segments
+    <tt>([1,3),2)([5,7],1)</tt>. Bounds are written by <tt>[</tt> and
+    <tt>]</tt> for closed and <tt>(</tt> and <tt>)</tt> for open ones.
+
+    Numbers are written and read directly from and into the characters of
+    the text. Floating point numbers are written with enough digits to be
+    read back exactly, integers out of the range of their type are not
+    read. Values of other types are converted by \c to_string and read
+    by <tt>operator >></tt> from the characters up to the next delimiter.
+
+    A parser, that reads large texts with several threads, is in
+    parallel_notation.hpp.
+*/
+namespace Notation
+{
+    //--------------------------------------------------------------------------
+    // Sinks take the characters of the writer
+
+    class string_sink
+    {
+    public:
+        explicit string_sink(std::string& text): _text(text) {}
+        void put(char character) { _text += character; }
+        void put(const char* characters, std::size_t count) { _text.append(characters, count); }
+    private:
+        std::string& _text;
+    };
+
+    class stream_sink
+    {
+    public:
+        explicit stream_sink(std::ostream& stream): _stream(stream) {}
+        void put(char character) { _stream.put(character); }
+        void put(const char* characters, std::size_t count)
+        { _stream.write(characters, static_cast<std::streamsize>(count)); }
+    private:
+        std::ostream& _stream;
+    };
+
+    /// Writes as many characters as fit into a buffer and counts all of them
+    class buffer_sink
+    {
+    public:
+        buffer_sink(char* buffer, std::size_t size): _buffer(buffer), _size(size), _length(0) {}
+
+        void put(char character)
+        {
+            if(_length < _size)
+                _buffer[_length] = character;
+            ++_length;
+        }
+
+        void put(const char* characters, std::size_t count)
+        {
+            if(_length < _size)
+                std::memcpy(_buffer + _length, characters, (std::min)(count, _size - _length));
+            _length += count;
+        }
+
+        std::size_t length()const { return _length; }
+
+    private:
+        char*       _buffer;
+        std::size_t _size;
+        std::size_t _length;
+    };
+
+    //--------------------------------------------------------------------------
+    template <class SinkT, class IntegralT>
+    void put_integral(SinkT& sink, IntegralT value)
+    {
+        char digits[3 * sizeof(IntegralT) + 2];
+        char* first = digits + sizeof(digits);
+        // Negative values are not negated, so the least one is written as well
+        if(std::numeric_limits<IntegralT>::is_signed && value < 0)
+        {
+            do { *--first = static_cast<char>('0' - value % 10); value /= 10; } while(value != 0);
+            *--first = '-';
+        }
+        else
+            do { *--first = static_cast<char>('0' + value % 10); value /= 10; } while(value != 0);
+        sink.put(first, digits + sizeof(digits) - first);
+    }
+
+    template <class SinkT> void put_value(SinkT& sink, short value)          { put_integral(sink, value); }
+    template <class SinkT> void put_value(SinkT& sink, int value)            { put_integral(sink, value); }
+    template <class SinkT> void put_value(SinkT& sink, long value)           { put_integral(sink, value); }
+    template <class SinkT> void put_value(SinkT& sink, unsigned short value) { put_integral(sink, value); }
+    template <class SinkT> void put_value(SinkT& sink, unsigned int value)   { put_integral(sink, value); }
+    template <class SinkT> void put_value(SinkT& sink, unsigned long value)  { put_integral(sink, value); }
+
+    // Floating point numbers are written with as many digits as are needed
+    // to read them back exactly
+    template <class SinkT> void put_floating(SinkT& sink, const char* format, double value)
+    {
+        char characters[32];
+        int count = sprintf(characters, format, value);
+        sink.put(characters, static_cast<std::size_t>(count));
+    }
+
+    template <class SinkT> void put_value(SinkT& sink, double value) { put_floating(sink, "%.17g", value); }
+    template <class SinkT> void put_value(SinkT& sink, float value)  { put_floating(sink, "%.9g", value); }
+
+    template <class SinkT, class Type> void put_value(SinkT& sink, const Type& value)
+    {
+        std::string representation = itl::to_string<Type>::apply(value);
+        sink.put(representation.data(), representation.size());
+    }
+
+    template <class SinkT, class DomainT>
+    void put_segment(SinkT& sink, const itl::interval<DomainT>& itv)
+    {
+        sink.put(itv.leftbound_open() ? '(' : '[');
+        put_value(sink, itv.lower());
+        sink.put(',');
+        put_value(sink, itv.upper());
+        sink.put(itv.rightbound_open() ? ')' : ']');
+    }
+
+    template <class SinkT, class IntervalT, class CodomainT>
+    void put_segment(SinkT& sink, const std::pair<IntervalT, CodomainT>& segment)
+    {
+        sink.put('(');
+        put_segment(sink, segment.first);
+        sink.put(',');
+        put_value(sink, segment.second);
+        sink.put(')');
+    }
+
+    template <class SinkT, class IteratorT>
+    void put_segments(SinkT& sink, IteratorT first, IteratorT last)
+    {
+        for(; first != last; ++first)
+            put_segment(sink, *first);
+    }
+
+    //--------------------------------------------------------------------------
+    inline const char* skip_space(const char* pos, const char* last)
+    {
+        while(pos != last && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r'))
+            ++pos;
+        return pos;
+    }
+
+    inline bool is_delimiter(char character)
+    { return character == ',' || character == ')' || character == ']'; }
+
+    /// The characters of a value: Up to the next delimiter without trailing space
+    inline const char* token_end(const char* pos, const char* last)
+    {
+        while(pos != last && !is_delimiter(*pos))
+            ++pos;
+        while(pos != last && (pos[-1] == ' ' || pos[-1] == '\t' || pos[-1] == '\n' || pos[-1] == '\r'))
+            --pos;
+        return pos;
+    }
+
+    template <class IntegralT>
+    bool get_integral(const char*& pos, const char* last, IntegralT& value)
+    {
+        const char* cur = pos;
+        bool negative = cur != last && *cur == '-';
+        if(negative || (cur != last && *cur == '+'))
+            ++cur;
+        if(cur == last || *cur < '0' || '9' < *cur
+           || (negative && !std::numeric_limits<IntegralT>::is_signed))
+            return false;
+        // Values are accumulated negatively for signed types, so the least one is read.
+        // Values out of the range of IntegralT are rejected like malformed ones.
+        const IntegralT limit = negative ? (std::numeric_limits<IntegralT>::min)()
+                                         : (std::numeric_limits<IntegralT>::max)();
+        IntegralT result = 0;
+        for(; cur != last && '0' <= *cur && *cur <= '9'; ++cur)
+        {
+            int digit = *cur - '0';
+            if(negative ? result < (limit + digit) / 10 : result > (limit - digit) / 10)
+                return false;
+            result = static_cast<IntegralT>(result * 10 + (negative ? -digit : digit));
+        }
+        value = result;
+        pos = cur;
+        return true;
+    }
+
+    inline bool get_value(const char*& pos, const char* last, short& value)          { return get_integral(pos, last, value); }
+    inline bool get_value(const char*& pos, const char* last, int& value)            { return get_integral(pos, last, value); }
+    inline bool get_value(const char*& pos, const char* last, long& value)           { return get_integral(pos, last, value); }
+    inline bool get_value(const char*& pos, const char* last, unsigned short& value) { return get_integral(pos, last, value); }
+    inline bool get_value(const char*& pos, const char* last, unsigned int& value)   { return get_integral(pos, last, value); }
+    inline bool get_value(const char*& pos, const char* last, unsigned long& value)  { return get_integral(pos, last, value); }
+
+    inline bool get_value(const char*& pos, const char* last, double& value)
+    {
+        char characters[64];
+        std::size_t count = token_end(pos, last) - pos;
+        if(count == 0 || sizeof(characters) <= count)
+            return false;
+        std::memcpy(characters, pos, count);
+        characters[count] = 0;
+        char* end = 0;
+        value = strtod(characters, &end);
+        if(end != characters + count)
+            return false;
+        pos += count;
+        return true;
+    }
+
+    inline bool get_value(const char*& pos, const char* last, float& value)
+    {
+        double number;
+        if(!get_value(pos, last, number))
+            return false;
+        value = static_cast<float>(number);
+        return true;
+    }
+
+    template <class Type>
+    bool get_value(const char*& pos, const char* last, Type& value)
+    {
+        const char* end = token_end(pos, last);
+        std::istringstream stream(std::string(pos, end));
+        if(pos == end || !(stream >> value) || stream.rdbuf()->in_avail() != 0)
+            return false;
+        pos = end;
+        return true;
+    }
+
+    /// Read a value that may be preceded by space
+    template <class Type>
+    bool get_field(const char*& pos, const char* last, Type& value)
+    {
+        pos = skip_space(pos, last);
+        return get_value(pos, last, value);
+    }
+
+    inline bool get_char(const char*& pos, const char* last, char expected)
+    {
+        pos = skip_space(pos, last);
+        if(pos == last || *pos != expected)
+            return false;
+        ++pos;
+        return true;
+    }
+
+    template <class DomainT>
+    bool get_segment(const char*& pos, const char* last, itl::interval<DomainT>& itv)
+    {
+        pos = skip_space(pos, last);
+        if(pos == last || (*pos != '[' && *pos != '('))
+            return false;
+        bool left_open = *pos++ == '(';
+
+        DomainT lower, upper;
+        if(!get_field(pos, last, lower) || !get_char(pos, last, ',') || !get_field(pos, last, upper))
+            return false;
+
+        pos = skip_space(pos, last);
+        if(pos == last || (*pos != ']' && *pos != ')'))
+            return false;
+        bool right_open = *pos++ == ')';
+
+        typedef itl::interval<DomainT> interval_type;
+        itv = interval_type(lower, upper,
+                  left_open ? (right_open ? interval_type::OPEN       : interval_type::LEFT_OPEN)
+                            : (right_open ? interval_type::RIGHT_OPEN : interval_type::CLOSED));
+        return true;
+    }
+
+    template <class IntervalT, class CodomainT>
+    bool get_segment(const char*& pos, const char* last, std::pair<IntervalT, CodomainT>& segment)
+    {
+        return get_char(pos, last, '(') && get_segment(pos, last, segment.first)
+            && get_char(pos, last, ',') && get_field(pos, last, segment.second)
+            && get_char(pos, last, ')');
+    }
+
+    //--------------------------------------------------------------------------
+    /// The segments that are read for a \c ContainerT
+    template <class ContainerT,
+              bool IsSet = boost::is_same<typename ContainerT::value_type,
+                                          typename ContainerT::interval_type>::value>
+    struct segment_of
+    { typedef typename ContainerT::interval_type type; };
+
+    template <class ContainerT>
+    struct segment_of<ContainerT, false>
+    {
+        typedef std::pair<typename ContainerT::interval_type,
+                          typename ContainerT::codomain_type> type;
+    };
+
+} // namespace Notation
+
+
+/// Write \c object to \c stream in the notation of \c as_string
+/** Segments are written one by one, without building strings for them. */
+template <class ContainerT>
+std::ostream& write_notation(std::ostream& stream, const ContainerT& object)
+{
+    Notation::stream_sink sink(stream);
+    Notation::put_segments(sink, object.begin(), object.end());
+    return stream;
+}
+
+/// Write \c object to the \c buffer of \c size characters like \c snprintf
+/** Returns the length of the notation of \c object. The notation is
+    terminated by 0, if it is shorter than \c size, and truncated
+    otherwise. */
+template <class ContainerT>
+std::size_t write_notation(char* buffer, std::size_t size, const ContainerT& object)
+{
+    Notation::buffer_sink sink(buffer, size);
+    Notation::put_segments(sink, object.begin(), object.end());
+    if(sink.length() < size)
+        buffer[sink.length()] = 0;
+    return sink.length();
+}
+
+/// Append the notation of \c object to \c text
+template <class ContainerT>
+std::string& append_notation(std::string& text, const ContainerT& object)
+{
+    Notation::string_sink sink(text);
+    Notation::put_segments(sink, object.begin(), object.end());
+    return text;
+}
+
+
+/// Add the segments written in [first, last) to \c object
+/** Returns \c last, if the text is read completely, and the start of the
+    segment, that could not be read, otherwise. The segments before are
+    added. Segments in ascending order are appended in constant time, so
+    loading a container from its notation takes linear time. */
+template <class ContainerT>
+const char* parse_notation(const char* first, const char* last, ContainerT& object)
+{
+    typedef typename Notation::segment_of<ContainerT>::type segment_type;
+    typename ContainerT::iterator prior_ = object.end();
+    segment_type segment;
+    for(first = Notation::skip_space(first, last); first != last; first = Notation::skip_space(first, last))
+    {
+        const char* start = first;
+        if(!Notation::get_segment(first, last, segment))
+            return start;
+        prior_ = object.add(prior_, segment);
+    }
+    return last;
+}
+
+template <class ContainerT>
+bool parse_notation(const std::string& text, ContainerT& object)
+{
+    const char* first = text.data();
+    return parse_notation(first, first + text.size(), object) == first + text.size();
+}
+
+}} // namespace itl boost
+
+#endif
+
+
@@ -0,0 +1,277 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+namespace Rewrite
+    Updates of interval maps, that replace all segments overlapped by an
+    operand at once
+--------------------------------------------------------------------*/
+#ifndef __itl_interval_rewrite_JOFA_081108_H__
+#define __itl_interval_rewrite_JOFA_081108_H__
+
+#include <vector>
+#include <utility>
+#include <boost/itl/notate.hpp>
+#include <boost/itl/functors.hpp>
+#include <boost/itl/operation_stats.hpp>
+
+namespace boost{namespace itl
+{
+
+/** Updates of interval maps on their implementation maps.
+
+    An update computes the segments, that replace the window of segments
+    overlapped by the operand, and the window is rewritten by one call of
+    <tt>replace</tt> on the implementation map. Interval maps on itl::map
+    and on itl::btree_map share these algorithms. A btree_map overwrites
+    the segments of the window in place leaf by leaf and inserts or erases
+    only the surplus, so splitting and joining do not reorganize the tree.
+*/
+namespace Rewrite
+{
+    template <class IntervalT>
+    inline const IntervalT& key_interval(const IntervalT& segment)
+    { return segment; }
+
+    template <class IntervalT, class CodomainT>
+    inline const IntervalT& key_interval(const std::pair<const IntervalT, CodomainT>& segment)
+    { return segment.KEY_VALUE; }
+
+    /// Determine the window [first_, past_) of the segments of \c impl, that overlap \c x_itv
+    /** If there are none, false is returned and first_ == past_ is the
+        position, where \c x_itv belongs. */
+    template <class ImplT>
+    bool overlapped(ImplT& impl, const typename ImplT::key_type& x_itv,
+                    typename ImplT::iterator& first_, typename ImplT::iterator& past_)
+    {
+        first_ = impl.lower_bound(x_itv);
+        ITL_COUNT(search);
+        if(first_ == impl.end() || x_itv.exclusive_less(key_interval(*first_)))
+        {
+            past_ = first_;
+            return false;
+        }
+        past_ = impl.upper_bound(x_itv);
+        ITL_COUNT(search);
+        return true;
+    }
+
+
+    //--------------------------------------------------------------------------
+    // Interval maps
+    //--------------------------------------------------------------------------
+    /// How the overlapped segments of an interval map are updated
+    enum segment_update
+    {
+        combine_segments, ///< Overlapped parts are combined with the value of the operand
+        keep_segments,    ///< Overlapped segments are kept
+        erase_segments    ///< Overlapped parts of segments that have the value of the operand are erased
+    };
+
+    /// The segments, that replace a window of an interval map
+    template <class ImplMapT>
+    class map_segments
+    {
+    public:
+        typedef typename ImplMapT::key_type  interval_type;
+        typedef typename ImplMapT::data_type codomain_type;
+        typedef typename ImplMapT::traits    traits;
+        typedef typename ImplMapT::iterator  iterator;
+        typedef std::pair<interval_type, codomain_type> segment_type;
+
+        explicit map_segments(bool joins): _joins(joins) {}
+
+        /// Append the segment of \c itv, that takes over \c value
+        /** Empty intervals and absorbed neutrons are skipped. Segments of
+            joining maps extend the last segment, if they touch it and have
+            an equal value. \c allocates tells, if the segment is new rather
+            than a segment of the window. */
+        void append(const interval_type& itv, codomain_type& value, bool allocates)
+        {
+            if(itv.empty())
+                return;
+            if(traits::absorbs_neutrons && value == codomain_type())
+            {
+                ITL_COUNT(absorption);
+                return;
+            }
+            if(_joins && !_segments.empty() && joinable(_segments.back(), itv, value))
+            {
+                ITL_COUNT(join);
+                ITL_COUNT(allocation);
+                _segments.back().KEY_VALUE.extend(itv);
+                return;
+            }
+            ITL_COUNT_IF(allocates, allocation);
+            _segments.push_back(segment_type(itv, codomain_type()));
+            using std::swap;
+            swap(_segments.back().CONT_VALUE, value);
+        }
+
+        /// Replace the window [first_, past_) of \c impl by the segments
+        /** Segments of joining maps take over touching neighbours of the
+            window, that have equal values. */
+        void replace(ImplMapT& impl, iterator first_, iterator past_)
+        {
+            if(_joins && !_segments.empty())
+            {
+                if(first_ != impl.begin())
+                {
+                    iterator pred_ = first_;
+                    --pred_;
+                    segment_type& front = _segments.front();
+                    if((*pred_).KEY_VALUE.touches(front.KEY_VALUE) && (*pred_).CONT_VALUE == front.CONT_VALUE)
+                    {
+                        ITL_COUNT(join);
+                        ITL_COUNT(allocation);
+                        interval_type joint = (*pred_).KEY_VALUE;
+                        front.KEY_VALUE = joint.extend(front.KEY_VALUE);
+                        first_ = pred_;
+                    }
+                }
+                segment_type& back = _segments.back();
+                if(past_ != impl.end() && joinable(back, (*past_).KEY_VALUE, (*past_).CONT_VALUE))
+                {
+                    ITL_COUNT(join);
+                    ITL_COUNT(allocation);
+                    back.KEY_VALUE.extend((*past_).KEY_VALUE);
+                    ++past_;
+                }
+            }
+            impl.replace(first_, past_, _segments);
+        }
+
+    private:
+        static bool joinable(const segment_type& left, const interval_type& itv, const codomain_type& value)
+        { return left.KEY_VALUE.touches(itv) && left.CONT_VALUE == value; }
+
+    private:
+        std::vector<segment_type> _segments;
+        bool                      _joins;
+    };
+
+    /// Rewrite the segments of \c impl, that overlap \c x_itv
+    /** Overlapped segments are updated with \c x_val as \c update tells.
+        If \c fills_gaps, the parts of \c x_itv, that are not overlapped,
+        are added with \c x_val. Joining maps join touching segments of
+        equal values. */
+    template <template<class>class Combinator, class ImplMapT>
+    void rewrite(ImplMapT& impl, const typename ImplMapT::key_type& x_itv,
+                 const typename ImplMapT::data_type& x_val,
+                 segment_update update, bool fills_gaps, bool joins)
+    {
+        typedef typename ImplMapT::key_type  interval_type;
+        typedef typename ImplMapT::data_type codomain_type;
+        typedef typename ImplMapT::traits    traits;
+        typedef typename ImplMapT::iterator  iterator;
+        static Combinator<codomain_type> combine;
+
+        if(x_itv.empty())
+            return;
+        if(traits::absorbs_neutrons && x_val == codomain_type())
+        {
+            ITL_COUNT(absorption);
+            return;
+        }
+
+        iterator first_, past_;
+        if(!overlapped(impl, x_itv, first_, past_) && !fills_gaps)
+            return;
+
+        codomain_type gap_val = x_val;
+        if(update == combine_segments && traits::emits_neutrons)
+        {
+            gap_val = codomain_type();
+            combine(gap_val, x_val);
+        }
+
+        map_segments<ImplMapT> segments(joins);
+        interval_type x_rest = x_itv, gap, left_resid, common, right_resid;
+        for(iterator it_ = first_; it_ != past_; ++it_)
+        {
+            ITL_COUNT(visit);
+            const interval_type& cur_itv = (*it_).KEY_VALUE;
+            // The window is overwritten, so values are moved out of it
+            codomain_type cur_val = codomain_type();
+            using std::swap;
+            swap(cur_val, (*it_).CONT_VALUE);
+
+            if(fills_gaps)
+            {
+                x_rest.left_surplus(gap, cur_itv);
+                codomain_type gap_fill = gap_val;
+                segments.append(gap, gap_fill, true);
+            }
+            x_rest.left_subtract(cur_itv);
+
+            cur_itv.intersect(common, x_itv);
+            if(update == keep_segments
+               || (update == erase_segments && (common.empty() || !(cur_val == x_val))))
+            {
+                segments.append(cur_itv, cur_val, false);
+                continue;
+            }
+
+            cur_itv.left_surplus(left_resid, x_itv);
+            cur_itv.right_surplus(right_resid, x_itv);
+            ITL_COUNT_IF(!left_resid.empty(),  split);
+            ITL_COUNT_IF(!right_resid.empty(), split);
+            bool splits = !left_resid.empty() || !right_resid.empty();
+
+            if(!left_resid.empty())
+            {
+                codomain_type resid_val = cur_val;
+                segments.append(left_resid, resid_val, true);
+            }
+            if(update == combine_segments)
+            {
+                // cur_val has to be copied only, if it is kept for a residue
+                codomain_type cmb_val = codomain_type();
+                if(right_resid.empty())
+                    swap(cmb_val, cur_val);
+                else
+                    cmb_val = cur_val;
+                combine(cmb_val, x_val);
+                segments.append(common, cmb_val, splits);
+            }
+            segments.append(right_resid, cur_val, true);
+        }
+
+        if(fills_gaps)
+        {
+            codomain_type gap_fill = gap_val;
+            segments.append(x_rest, gap_fill, true);
+        }
+        segments.replace(impl, first_, past_);
+    }
+
+    template <template<class>class Combinator, class ImplMapT>
+    void add(ImplMapT& impl, const typename ImplMapT::key_type& x_itv,
+             const typename ImplMapT::data_type& x_val, bool joins)
+    { rewrite<Combinator>(impl, x_itv, x_val, combine_segments, true, joins); }
+
+    template <template<class>class Combinator, class ImplMapT>
+    void subtract(ImplMapT& impl, const typename ImplMapT::key_type& x_itv,
+                  const typename ImplMapT::data_type& x_val, bool joins)
+    { rewrite<Combinator>(impl, x_itv, x_val, combine_segments, false, joins); }
+
+    template <class ImplMapT>
+    void insert(ImplMapT& impl, const typename ImplMapT::key_type& x_itv,
+                const typename ImplMapT::data_type& x_val, bool joins)
+    { rewrite<inplace_plus>(impl, x_itv, x_val, keep_segments, true, joins); }
+
+    template <class ImplMapT>
+    void erase(ImplMapT& impl, const typename ImplMapT::key_type& x_itv,
+               const typename ImplMapT::data_type& x_val, bool joins)
+    { rewrite<inplace_plus>(impl, x_itv, x_val, erase_segments, false, joins); }
+
+} // namespace Rewrite
+
+}} // namespace itl boost
+
+#endif
@@ -149,7 +149,7 @@ public:
     typedef typename itl::set<DomainT,Compare,Alloc> atomized_type;
 
     /// Container type for the implementation 
-    typedef typename itl::set<interval_type,exclusive_less,Alloc> ImplSetT;
+    typedef typename base_type::ImplSetT ImplSetT;
 
     /// key type of the implementing container
     typedef typename ImplSetT::key_type   key_type;
@@ -235,6 +235,7 @@ bool interval_set<DomainT,Interval,Compare,Alloc>::contains_(const interval_type
         return false;
     {
         typename ImplSetT::const_iterator it = this->_set.find(x);
+        ITL_COUNT(search);
         if(it == this->_set.end())
             return false;
         else
@@ -296,10 +297,13 @@ typename interval_set<DomainT,Interval,Compare,Alloc>::iterator
     interval_type curItv = (*left_it);
     curItv.extend(*right_it);
 
+    ITL_COUNT(join);
     this->_set.erase(left_it);
     this->_set.erase(right_it);
     
-    iterator new_it = this->_set.insert(curItv).ITERATOR;
+    std::pair<iterator,bool> insertion = this->_set.insert(curItv);
+    ITL_COUNT_IF(insertion.WAS_SUCCESSFUL, allocation);
+    iterator new_it = insertion.ITERATOR;
     BOOST_ASSERT(new_it!=this->_set.end());
     return new_it;
 }
@@ -311,13 +315,19 @@ void interval_set<DomainT,Interval,Compare,Alloc>::add_(const value_type& x)
     if(x.empty()) return;
 
     std::pair<typename ImplSetT::iterator,bool> insertion = this->_set.insert(x);
+    ITL_COUNT(search);
 
     if(insertion.WAS_SUCCESSFUL)
+    {
+        ITL_COUNT(allocation);
         handle_neighbours(insertion.ITERATOR);
+    }
     else
     {
         typename ImplSetT::iterator fst_it = this->_set.lower_bound(x);
         typename ImplSetT::iterator end_it = this->_set.upper_bound(x);
+        ITL_COUNT(search);
+        ITL_COUNT(search);
 
         typename ImplSetT::iterator it=fst_it, nxt_it=fst_it, victim;
         Interval<DomainT> leftResid;  (*it).left_surplus(leftResid,x);
@@ -325,6 +335,7 @@ void interval_set<DomainT,Interval,Compare,Alloc>::add_(const value_type& x)
 
         while(it!=end_it)
         { 
+            ITL_COUNT(visit);
             if((++nxt_it)==end_it) 
                 (*it).right_surplus(rightResid,x);
             victim = it; it++; this->_set.erase(victim);
@@ -343,8 +354,10 @@ void interval_set<DomainT,Interval,Compare,Alloc>::subtract_(const value_type& x
 {
     if(x.empty()) return;
     typename ImplSetT::iterator fst_it = this->_set.lower_bound(x);
+    ITL_COUNT(search);
     if(fst_it==this->_set.end()) return;
     typename ImplSetT::iterator end_it = this->_set.upper_bound(x);
+    ITL_COUNT(search);
 
     typename ImplSetT::iterator it=fst_it, nxt_it=fst_it, victim;
     interval_type leftResid; (*it).left_surplus(leftResid,x);
@@ -352,9 +365,12 @@ void interval_set<DomainT,Interval,Compare,Alloc>::subtract_(const value_type& x
 
     while(it!=end_it)
     { 
+        ITL_COUNT(visit);
         if((++nxt_it)==end_it) (*it).right_surplus(rightResid,x);
         victim = it; it++; this->_set.erase(victim);
     }
+    ITL_COUNT_IF(!leftResid.empty(),  split);
+    ITL_COUNT_IF(!rightResid.empty(), split);
 
     add(leftResid);
     add(rightResid);
@@ -384,6 +400,10 @@ template <class Type>
 struct is_interval_splitter<itl::interval_set<Type> >
 { enum{value = false}; };
 
+template <class Type>
+struct is_interval_joiner<itl::interval_set<Type> >
+{ enum{value = true}; };
+
 template <class Type>
 struct is_neutron_absorber<itl::interval_set<Type> >
 { enum{value = false}; };
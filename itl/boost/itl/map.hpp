@@ -34,6 +34,7 @@ class itl::map
 #define __itl_map_h_JOFA_070519__
 
 #include <string>
+#include <algorithm>
 #include <boost/itl/notate.hpp>
 #include <boost/itl/type_traits/to_string.hpp>
 #include <boost/itl/functors.hpp>
@@ -211,6 +212,42 @@ namespace boost{namespace itl
                 return base_type::insert(value_pair);
         }
 
+        /** Insert \c value_pair using \c prior_ as hint. Neutrons are absorbed
+            like by <tt>insert(value_pair)</tt>, \c prior_ is returned then. */
+        iterator insert(iterator prior_, const value_type& value_pair)
+        {
+            if(Traits::absorbs_neutrons && value_pair.CONT_VALUE == DataT()) 
+                return prior_;
+            else
+                return base_type::insert(prior_, value_pair);
+        }
+
+        /** Insert \c key with the value of \c data, that is swapped into the
+            map: \c data gets a neutron, if it is inserted. So heavy values
+            are inserted without being copied. */
+        std::pair<iterator,bool> insert_moved(const KeyT& key, DataT& data)
+        {
+            if(Traits::absorbs_neutrons && data == DataT()) 
+                return std::pair<iterator,bool>(end(),true);
+            std::pair<iterator,bool> insertion = base_type::insert(value_type(key, DataT()));
+            if(insertion.WAS_SUCCESSFUL)
+            {
+                using std::swap;
+                swap((*insertion.ITERATOR).CONT_VALUE, data);
+            }
+            return insertion;
+        }
+
+        /** Replace the elements of [first, past) by the elements of \c segments.
+            The keys of \c segments must be ascending and ordered between the
+            elements in front of \c first and the elements from \c past on.
+            Elements are overwritten in place, surplus elements are erased and
+            missing ones are inserted in front of \c past. Data of \c segments
+            are swapped into the map. \c SegmentsT is a vector of pairs of a 
+            key and its data. */
+        template <class SegmentsT>
+        void replace(iterator first, iterator past, SegmentsT& segments);
+
         /** \c add inserts \c value_pair into the map if it's key does 
             not exist in the map.    
             If \c value_pairs's key value exists in the map, it's data
@@ -220,12 +257,26 @@ namespace boost{namespace itl
         template<template<class>class Combinator>
         iterator add(const value_type& value_pair);
 
+        /** Add \c value_pair using \c prior_ as hint: Adding is done in constant
+            time, if \c value_pair's key is found at \c prior_ or is to be inserted 
+            right before \c prior_. The result is a hint for the next greater key. */
+        iterator add(iterator prior_, const value_type& value_pair) 
+        { return add<inplace_plus>(prior_, value_pair); }
+
+        template<template<class>class Combinator>
+        iterator add(iterator prior_, const value_type& value_pair);
+
         iterator operator += (const value_type& value_pair) { return add(value_pair); }
 
         /** If the \c value_pair's key value is in the map, it's data value is
             subtraced from the data value stored in the map. */
         iterator subtract(const value_type& value_pair);
 
+        /** Subtract \c value_pair's data value from the element that \c it_ 
+            refers to, which must have \c value_pair's key. Returns the position
+            behind the subtraction. */
+        iterator subtract(iterator it_, const value_type& value_pair);
+
         /** Add a map \c x2 to this map. If an element of \c x2 already exists
             in \c *this, add up the contents using <tt>operator +=</tt>. */
         map& operator += (const map& x2) { Set::add(*this, x2); return *this; }
@@ -311,6 +362,12 @@ namespace boost{namespace itl
     };
 
 
+    /** Swap the contents of two maps in constant time */
+    template <typename KeyT, typename DataT, class Traits, template<class>class Compare, template<class>class Alloc>
+    inline void swap(itl::map<KeyT,DataT,Traits,Compare,Alloc>& lhs,
+                     itl::map<KeyT,DataT,Traits,Compare,Alloc>& rhs)
+    { lhs.swap(rhs); }
+
     /** Standard equality, which is lexicographical equality of the sets
         as sequences, that are given by their Compare order. */
     template <typename KeyT, typename DataT, class Traits, template<class>class Compare, template<class>class Alloc>
@@ -398,6 +455,38 @@ namespace boost{namespace itl
         }
     }
 
+    template <typename KeyT, typename DataT, class Traits, template<class>class Compare, template<class>class Alloc>
+        template <template<class>class Combinator>
+    typename map<KeyT,DataT,Traits,Compare,Alloc>::iterator
+        map<KeyT,DataT,Traits,Compare,Alloc>::add(iterator prior_, const value_type& val)
+    {
+        if(Traits::absorbs_neutrons && val.CONT_VALUE == DataT())
+            return prior_;
+
+        iterator it_;
+        size_type size_before = size();
+        if(Traits::emits_neutrons)
+        {
+            DataT added_val = DataT();
+            Combinator<DataT>()(added_val, val.CONT_VALUE);
+            it_ = base_type::insert(prior_, value_type(val.KEY_VALUE, added_val));
+        }
+        else // Existential case
+            it_ = base_type::insert(prior_, val);
+
+        if(size() != size_before)
+            return it_;
+        else
+        {
+            Combinator<DataT>()((*it_).CONT_VALUE, val.CONT_VALUE);
+
+            if(Traits::absorbs_neutrons && (*it_).CONT_VALUE == DataT())
+                erase(it_++);
+
+            return it_;
+        }
+    }
+
     template <typename KeyT, typename DataT, class Traits, template<class>class Compare, template<class>class Alloc>
     typename map<KeyT,DataT,Traits,Compare,Alloc>::size_type 
         map<KeyT,DataT,Traits,Compare,Alloc>
@@ -443,6 +532,43 @@ namespace boost{namespace itl
         }
     }
 
+    template <typename KeyT, typename DataT, class Traits, template<class>class Compare, template<class>class Alloc>
+    typename map<KeyT,DataT,Traits,Compare,Alloc>::iterator
+        map<KeyT,DataT,Traits,Compare,Alloc>::subtract(iterator it_, const value_type& val)
+    {
+        (*it_).CONT_VALUE -= val.CONT_VALUE;
+
+        if(Traits::absorbs_neutrons && (*it_).CONT_VALUE == DataT())
+            erase(it_++);
+
+        return it_;
+    }
+
+    template <typename KeyT, typename DataT, class Traits, template<class>class Compare, template<class>class Alloc>
+        template <class SegmentsT>
+    void map<KeyT,DataT,Traits,Compare,Alloc>::replace(iterator first, iterator past, SegmentsT& segments)
+    {
+        using std::swap;
+        typename SegmentsT::size_type seg = 0;
+        for(; seg < segments.size() && first != past; ++seg, ++first)
+        {
+            // The element is built aside, so *first is unchanged, if copying the key throws.
+            // The ordering of keys is invariant, so the key is swapped in place.
+            value_type value(segments[seg].KEY_VALUE, DataT());
+            swap(value.CONT_VALUE, segments[seg].CONT_VALUE);
+            swap(const_cast<KeyT&>((*first).KEY_VALUE), const_cast<KeyT&>(value.KEY_VALUE));
+            swap((*first).CONT_VALUE, value.CONT_VALUE);
+        }
+
+        erase(first, past);
+
+        for(; seg < segments.size(); ++seg)
+        {
+            iterator inserted = base_type::insert(past, value_type(segments[seg].KEY_VALUE, DataT()));
+            swap((*inserted).CONT_VALUE, segments[seg].CONT_VALUE);
+        }
+    }
+
 
     template <typename KeyT, typename DataT, class Traits, template<class>class Compare, template<class>class Alloc>
     std::string map<KeyT,DataT,Traits,Compare,Alloc>::as_string()const
@@ -50,11 +50,13 @@ namespace boost{namespace itl
             if(!Set::common_range(common_lwb_, common_upb_, sub, super))
                 return false;
 
-            typename MapType::const_iterator sub_ = sub.begin(), super_;
+            int probes = Set::seek_depth(super.size());
+            typename MapType::key_compare key_less;
+            typename MapType::const_iterator sub_ = sub.begin(), super_ = super.begin();
             while(sub_ != sub.end())
             {
-                super_ = super.find((*sub_).KEY_VALUE);
-                if(super_ == super.end()) 
+                Set::seek(super, super_, (*sub_).KEY_VALUE, probes);
+                if(super_ == super.end() || key_less((*sub_).KEY_VALUE, (*super_).KEY_VALUE)) 
                     return false;
                 else if(!(sub_->CONT_VALUE == super_->CONT_VALUE))
                     return false;
@@ -96,18 +98,24 @@ namespace boost{namespace itl
             if(!Set::common_range(common_lwb_, common_upb_, x1, x2))
                 return;
 
-            typename MapType::const_iterator x1_ = common_lwb_, x2_;
+            int probes = Set::seek_depth(x2.size());
+            typename MapType::key_compare key_less;
+            typename MapType::const_iterator x1_ = common_lwb_, x2_ = x2.begin();
+            typename MapType::iterator result_;
 
             while(x1_ != common_upb_)
             {
-                x2_ = x2.find((*x1_).KEY_VALUE);
-                if(x2_ != x2.end())
+                Set::seek(x2, x2_, (*x1_).KEY_VALUE, probes);
+                if(x2_ == x2.end())
+                    return;
+                if(!key_less((*x1_).KEY_VALUE, (*x2_).KEY_VALUE))
                 {
-                    result.insert(*x1_);
+                    // Common keys are ascending: Append them with an end hint
+                    result_ = result.insert(result.end(), *x1_);
                     if(is_set<typename MapType::data_type>::value)
-                        result.template add<inplace_star>(*x2_); //MEMO template cast for gcc
+                        result.template add<inplace_star>(result_, *x2_); //MEMO template cast for gcc
                     else
-                        result.template add<inplace_plus>(*x2_);
+                        result.template add<inplace_plus>(result_, *x2_);
                         //result.template add<inplace_identity>(*x2_);
                 }
                 x1_++;
@@ -134,14 +142,18 @@ namespace boost{namespace itl
             if(!Set::common_range(common_lwb_, common_upb_, x1, x2))
                 return;
 
+            int probes = Set::seek_depth(x2.size());
+            typename MapType::key_compare key_less;
             typename MapType::const_iterator x1_ = common_lwb_;
-            typename SetType::const_iterator common_;
+            typename SetType::const_iterator common_ = x2.begin();
 
             while(x1_ != common_upb_)
             {
-                common_ = x2.find((*x1_).KEY_VALUE);
-                if(common_ != x2.end())
-                    result.insert(*x1_);
+                Set::seek(x2, common_, (*x1_).KEY_VALUE, probes);
+                if(common_ == x2.end())
+                    return;
+                if(!key_less((*x1_).KEY_VALUE, *common_))
+                    result.insert(result.end(), *x1_);
 
                 x1_++;
             }
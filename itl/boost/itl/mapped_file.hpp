@@ -0,0 +1,69 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class mapped_file
+    A file that is mapped into memory for reading
+--------------------------------------------------------------------*/
+#ifndef __itl_mapped_file_JOFA_081101_H__
+#define __itl_mapped_file_JOFA_081101_H__
+
+#include <cstddef>
+#include <exception>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+namespace boost{namespace itl
+{
+
+/// A read only memory mapping of a whole file
+/** The pages of the file are loaded on demand and are shared by all
+    processes that map the file. Use it with snapshot_view to query
+    snapshots without reading them.
+
+    The mapping is a boost::iostreams::mapped_file_source, so programs
+    link Boost.Iostreams. Failures are reported by results instead of
+    exceptions like in the other itl classes. */
+class mapped_file
+{
+public:
+    mapped_file() {}
+    explicit mapped_file(const char* path) { open(path); }
+
+    /// Map the file at \c path; false, if it can not be mapped
+    bool open(const char* path)
+    {
+        close();
+        try
+        {
+            _source.open(path);
+        }
+        catch(const std::exception&)
+        {
+            return false;
+        }
+        return is_open();
+    }
+
+    void close() { if(_source.is_open()) _source.close(); }
+
+    bool is_open()const { return _source.is_open(); }
+
+    const void* data()const { return is_open() ? _source.data() : 0; }
+    std::size_t size()const { return is_open() ? _source.size() : 0; }
+
+private:
+    // Mappings are not copied
+    mapped_file(const mapped_file&);
+    mapped_file& operator = (const mapped_file&);
+
+    boost::iostreams::mapped_file_source _source;
+};
+
+}} // namespace itl boost
+
+#endif
@@ -0,0 +1,162 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+Operation counters and tracing hooks for interval containers
+--------------------------------------------------------------------*/
+#ifndef __itl_operation_stats_JOFA_081021_H__
+#define __itl_operation_stats_JOFA_081021_H__
+
+#include <string>
+#include <sstream>
+#include <boost/current_function.hpp>
+
+namespace boost{namespace itl
+{
+
+/// Events in the hot paths of interval containers that are counted
+enum operation_event
+{
+    search_event,     ///< Search in the implementing tree (find, lower_bound, upper_bound, insert)
+    visit_event,      ///< Segment visited while walking the segments that overlap an operand
+    split_event,      ///< Segment that is cut at a border of an operand
+    join_event,       ///< Two touching segments joined into one
+    allocation_event, ///< Node inserted into the implementing tree
+    absorption_event, ///< Neutral value absorbed: Nothing inserted or a segment erased
+    operation_event_count
+};
+
+/// Counters of events in interval container operations
+/** Counting is compiled into the interval containers only, if
+    ITL_OPERATION_STATS is defined. Otherwise all counting statements
+    expand to nothing and operation_counter() stays zero. Conditions of
+    ITL_COUNT_IF are then only named in an unevaluated sizeof, so
+    variables that merely feed a counter are still used.
+
+    Counters are global and not synchronized: Use them for profiling
+    single threaded code.
+
+    \code
+    itl::operation_stats_scope scope;
+    my_map += make_pair(itv, 1);
+    cout << scope.stats().as_string() << endl;
+    \endcode
+*/
+class operation_stats
+{
+public:
+    operation_stats(){ reset(); }
+
+    void reset()
+    {
+        for(int idx = 0; idx < operation_event_count; idx++)
+            _count[idx] = 0;
+    }
+
+    void add(operation_event event){ ++_count[event]; }
+
+    long count(operation_event event)const { return _count[event]; }
+
+    long searches()const    { return _count[search_event]; }
+    long visits()const      { return _count[visit_event]; }
+    long splits()const      { return _count[split_event]; }
+    long joins()const       { return _count[join_event]; }
+    long allocations()const { return _count[allocation_event]; }
+    long absorptions()const { return _count[absorption_event]; }
+
+    operation_stats& operator += (const operation_stats& rhs)
+    {
+        for(int idx = 0; idx < operation_event_count; idx++)
+            _count[idx] += rhs._count[idx];
+        return *this;
+    }
+
+    operation_stats& operator -= (const operation_stats& rhs)
+    {
+        for(int idx = 0; idx < operation_event_count; idx++)
+            _count[idx] -= rhs._count[idx];
+        return *this;
+    }
+
+    std::string as_string()const
+    {
+        std::stringstream repr;
+        repr << "searches="     << searches()
+             << " visits="      << visits()
+             << " splits="      << splits()
+             << " joins="       << joins()
+             << " allocations=" << allocations()
+             << " absorptions=" << absorptions();
+        return repr.str();
+    }
+
+private:
+    long _count[operation_event_count];
+};
+
+inline operation_stats operator - (operation_stats lhs, const operation_stats& rhs)
+{ return lhs -= rhs; }
+
+
+/// A tracer is called for every counted event with the function it occurred in
+typedef void (*operation_tracer)(operation_event event, const char* location);
+
+/// The global counters of events
+inline operation_stats& operation_counter()
+{
+    static operation_stats stats;
+    return stats;
+}
+
+inline operation_tracer& operation_trace_hook()
+{
+    static operation_tracer tracer = 0;
+    return tracer;
+}
+
+/// Install a tracer. Pass 0 to remove it.
+inline void set_operation_tracer(operation_tracer tracer)
+{ operation_trace_hook() = tracer; }
+
+inline void count_operation(operation_event event, const char* location)
+{
+    operation_counter().add(event);
+    if(operation_trace_hook() != 0)
+        operation_trace_hook()(event, location);
+}
+
+
+/// The events counted during the lifetime of an operation_stats_scope
+class operation_stats_scope
+{
+public:
+    operation_stats_scope(): _start(operation_counter()) {}
+
+    operation_stats stats()const { return operation_counter() - _start; }
+
+    void restart(){ _start = operation_counter(); }
+
+private:
+    operation_stats _start;
+};
+
+}} // namespace itl boost
+
+
+#ifdef ITL_OPERATION_STATS
+#define ITL_COUNT(event) \
+    ::boost::itl::count_operation(::boost::itl::event##_event, BOOST_CURRENT_FUNCTION)
+#define ITL_COUNT_IF(condition, event) \
+    if(condition) ITL_COUNT(event); else (void)0
+#else
+#define ITL_COUNT(event) ((void)0)
+#define ITL_COUNT_IF(condition, event) ((void)sizeof(condition))
+#endif
+
+#endif // __itl_operation_stats_JOFA_081021_H__
+
@@ -0,0 +1,237 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class overlap_statistics, function sweep_overlaps
+    Overlap depths of a batch of intervals by a sweep line
+--------------------------------------------------------------------*/
+#ifndef __itl_overlap_sweep_JOFA_081027_H__
+#define __itl_overlap_sweep_JOFA_081027_H__
+
+#include <vector>
+#include <iterator>
+#include <boost/itl/interval.hpp>
+#include <boost/itl/type_traits/is_interval_joiner.hpp>
+#include <boost/itl/parallel.hpp>
+
+namespace boost{namespace itl
+{
+
+/// Statistics on the overlap depths of a collection of intervals
+/** The depth of an element is the number of intervals that contain it.
+    The statistics refer to segments: maximal intervals of constant,
+    nonzero depth. These are the segments of an
+    <tt>interval_map<DomainT,int></tt> that counts overlaps.
+*/
+template <class IntervalT>
+class overlap_statistics
+{
+public:
+    typedef IntervalT                             interval_type;
+    typedef typename IntervalT::difference_type   difference_type;
+    typedef std::vector<interval_type>            interval_vector;
+
+    overlap_statistics(): _max_depth(0), _segment_count(0) {}
+
+    /// Greatest number of intervals that overlap
+    std::size_t max_depth()const { return _max_depth; }
+
+    /// Segments of the maximal depth in ascending order
+    const interval_vector& max_depth_segments()const { return _max_depth_segments; }
+
+    /// Number of segments of constant, nonzero depth
+    std::size_t segment_count()const { return _segment_count; }
+
+    /// Number of segments of depth \c depth
+    std::size_t segment_count(std::size_t depth)const
+    { return depth < _histogram.size() ? _histogram[depth] : 0; }
+
+    /// Length of the domain that is covered by exactly \c depth intervals
+    difference_type coverage(std::size_t depth)const
+    { return depth < _coverage.size() ? _coverage[depth] : difference_type(); }
+
+    /// Numbers of segments indexed by depth
+    const std::vector<std::size_t>& depth_histogram()const { return _histogram; }
+
+    /// Covered lengths indexed by depth
+    const std::vector<difference_type>& depth_coverage()const { return _coverage; }
+
+    /// Count the segment \c segment of depth \c depth that follows all segments counted so far
+    void add(const interval_type& segment, std::size_t depth)
+    {
+        if(depth >= _histogram.size())
+        {
+            _histogram.resize(depth+1, 0);
+            _coverage.resize(depth+1, difference_type());
+        }
+        ++_histogram[depth];
+        ++_segment_count;
+        _coverage[depth] += segment.length();
+
+        if(depth > _max_depth)
+        {
+            _max_depth = depth;
+            _max_depth_segments.clear();
+        }
+        if(depth == _max_depth)
+            _max_depth_segments.push_back(segment);
+    }
+
+private:
+    std::size_t                  _max_depth;
+    std::size_t                  _segment_count;
+    interval_vector              _max_depth_segments;
+    std::vector<std::size_t>     _histogram;
+    std::vector<difference_type> _coverage;
+};
+
+
+namespace Sweep
+{
+    template <class IntervalT>
+    struct no_output
+    {
+        void elementary(const IntervalT&, std::size_t){}
+        void segment(const IntervalT&, std::size_t){}
+    };
+
+    template <class IntervalMapT>
+    struct map_output
+    {
+        typedef typename IntervalMapT::interval_type interval_type;
+        typedef typename IntervalMapT::codomain_type codomain_type;
+        typedef typename IntervalMapT::value_type    value_type;
+
+        map_output(IntervalMapT& overlaps): _overlaps(&overlaps), _prior(overlaps.end()) {}
+
+        // Joining maps receive the segments, splitting maps keep all borders
+        void elementary(const interval_type& elementary, std::size_t depth)
+        {
+            if(!is_interval_joiner<IntervalMapT>::value)
+                add(elementary, depth);
+        }
+
+        void segment(const interval_type& segment, std::size_t depth)
+        {
+            if(is_interval_joiner<IntervalMapT>::value)
+                add(segment, depth);
+        }
+
+        void add(const interval_type& segment, std::size_t depth)
+        { _prior = _overlaps->add(_prior, value_type(segment, static_cast<codomain_type>(depth))); }
+
+        IntervalMapT*                     _overlaps;
+        typename IntervalMapT::iterator   _prior;
+    };
+
+    /// Sweep the intervals of [first, past) and pass elementary intervals and segments to \c output
+    template <class IteratorT, class OutputT>
+    overlap_statistics<typename std::iterator_traits<IteratorT>::value_type>
+        sweep(IteratorT first, IteratorT past, OutputT output, unsigned threads)
+    {
+        typedef typename std::iterator_traits<IteratorT>::value_type interval_type;
+
+        // Sequences of the intervals ordered by lower and by upper bounds
+        std::vector<interval_type> starts, ends;
+        for(; first != past; ++first)
+            if(!(*first).empty())
+                starts.push_back(*first);
+        ends = starts;
+        Parallel::sort(starts.begin(), starts.end(), itl::lower_less<interval_type>(), threads);
+        Parallel::sort(ends.begin(),   ends.end(),   itl::upper_less<interval_type>(), threads);
+
+        // Intervals starts[0..started) have been entered, ends[0..ended) left.
+        // The window spans from the sweep position to the farthest upper bound
+        // of the entered intervals.
+        overlap_statistics<interval_type> statistics;
+        std::size_t count = starts.size(), started = 0, ended = 0;
+        interval_type window, segment, elementary;
+        std::size_t segment_depth = 0;
+
+        while(ended < count)
+        {
+            if(started == ended)
+                window = starts[started];
+            while(started < count && starts[started].lower_less_equal(window))
+                window.extend(starts[started++]);
+
+            // The elementary interval ends with the first interval to end or
+            // before the next one to start
+            elementary = window.span(ends[ended]);
+            if(started < count && !elementary.exclusive_less(starts[started]))
+                elementary.left_surplus(elementary, starts[started]);
+            std::size_t depth = started - ended;
+            output.elementary(elementary, depth);
+
+            // Elementary intervals that touch with equal depth form a segment
+            if(segment_depth == depth && segment.touches(elementary))
+                segment.extend(elementary);
+            else
+            {
+                if(segment_depth > 0)
+                {
+                    statistics.add(segment, segment_depth);
+                    output.segment(segment, segment_depth);
+                }
+                segment = elementary;
+                segment_depth = depth;
+            }
+
+            window.left_subtract(elementary);
+            while(ended < count && ends[ended].upper_equal(elementary))
+                ++ended;
+        }
+        if(segment_depth > 0)
+        {
+            statistics.add(segment, segment_depth);
+            output.segment(segment, segment_depth);
+        }
+        return statistics;
+    }
+
+} // namespace Sweep
+
+
+/// Overlap statistics of the intervals in [first, past)
+/** The intervals need not be sorted. They are sorted by their bounds,
+    using up to \c threads threads (see parallel.hpp), and swept once. This
+    takes O(n log n) for n intervals, like building an overlap counting
+    interval_map does, but only needs two vectors of intervals instead of
+    the nodes of the map.
+
+    \code
+    std::vector<interval<int> > bookings;
+    ...
+    overlap_statistics<interval<int> > stats = sweep_overlaps(bookings.begin(), bookings.end());
+    stats.max_depth(); stats.max_depth_segments(); stats.coverage(2);
+    \endcode
+*/
+template <class IteratorT>
+overlap_statistics<typename std::iterator_traits<IteratorT>::value_type>
+    sweep_overlaps(IteratorT first, IteratorT past, unsigned threads = 1)
+{
+    typedef typename std::iterator_traits<IteratorT>::value_type interval_type;
+    return Sweep::sweep(first, past, Sweep::no_output<interval_type>(), threads);
+}
+
+/// Overlap statistics of the intervals in [first, past), that also fills an overlap counter
+/** Afterwards \c overlaps is the same as if <tt>(itv, 1)</tt> had been
+    added to it for every interval \c itv of the range. The segments are
+    appended using hints, so filling an empty map takes linear time after
+    sorting. */
+template <class IntervalMapT, class IteratorT>
+overlap_statistics<typename std::iterator_traits<IteratorT>::value_type>
+    sweep_overlaps(IntervalMapT& overlaps, IteratorT first, IteratorT past, unsigned threads = 1)
+{
+    return Sweep::sweep(first, past, Sweep::map_output<IntervalMapT>(overlaps), threads);
+}
+
+}} // namespace itl boost
+
+#endif
+
@@ -0,0 +1,161 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+namespace Parallel
+    Helpers that split work on ranges among threads
+--------------------------------------------------------------------*/
+#ifndef __itl_parallel_JOFA_081027_H__
+#define __itl_parallel_JOFA_081027_H__
+
+/*  Algorithms of the itl that offer a parallel version take the number
+    of threads to use. Threads are only started, if ITL_USE_BOOST_THREAD
+    is defined, in which case programs have to be linked with
+    Boost.Thread. Otherwise the parallel versions work sequentially and
+    yield the same results. */
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#ifdef ITL_USE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#endif
+
+namespace boost{namespace itl
+{
+
+namespace Parallel
+{
+    /// Number of threads that run concurrently on this machine
+    inline unsigned hardware_threads()
+    {
+#ifdef ITL_USE_BOOST_THREAD
+        unsigned count = boost::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+#else
+        return 1;
+#endif
+    }
+
+#ifdef ITL_USE_BOOST_THREAD
+    typedef boost::mutex mutex;
+#else
+    /// Mutex of sequential programs, that does nothing
+    class mutex
+    {
+    public:
+        void lock()   {}
+        void unlock() {}
+    };
+#endif
+
+    template <class TaskT>
+    struct bind_part
+    {
+        bind_part(const TaskT& task, unsigned part): _task(task), _part(part) {}
+        void operator()() { _task(_part); }
+        TaskT    _task;
+        unsigned _part;
+    };
+
+    /// Run task(0), ..., task(count-1), each one in a thread of its own
+    /** The calling thread runs task(0) itself and waits for the others.
+        Tasks must not throw. */
+    template <class TaskT>
+    void run(TaskT task, unsigned count)
+    {
+#ifdef ITL_USE_BOOST_THREAD
+        boost::thread_group workers;
+        for(unsigned part = 1; part < count; part++)
+            workers.create_thread(bind_part<TaskT>(task, part));
+        if(count > 0)
+            task(0);
+        workers.join_all();
+#else
+        for(unsigned part = 0; part < count; part++)
+            task(part);
+#endif
+    }
+
+    /// Border of part \c part, if a range of \c size is split into \c count parts
+    inline std::size_t part_border(std::size_t size, unsigned part, unsigned count)
+    { return static_cast<std::size_t>((static_cast<double>(size) * part) / count); }
+
+    template <class RandomIterator, class Compare>
+    struct sort_part
+    {
+        sort_part(RandomIterator first, std::size_t size, unsigned count, Compare compare)
+            : _first(first), _size(size), _count(count), _compare(compare) {}
+
+        void operator()(unsigned part)const
+        {
+            std::sort(_first + part_border(_size, part,   _count),
+                      _first + part_border(_size, part+1, _count), _compare);
+        }
+
+        RandomIterator _first;
+        std::size_t    _size;
+        unsigned       _count;
+        Compare        _compare;
+    };
+
+    template <class RandomIterator, class Compare>
+    struct merge_parts
+    {
+        merge_parts(RandomIterator first, std::size_t size, unsigned count,
+                    unsigned width, Compare compare)
+            : _first(first), _size(size), _count(count), _width(width), _compare(compare) {}
+
+        // Merges the sorted parts [2*part*width, (2*part+1)*width) and
+        // [(2*part+1)*width, (2*part+2)*width)
+        void operator()(unsigned part)const
+        {
+            unsigned middle = (std::min)(_count, (2*part+1) * _width);
+            unsigned last   = (std::min)(_count, (2*part+2) * _width);
+            std::inplace_merge(_first + part_border(_size, 2*part*_width, _count),
+                               _first + part_border(_size, middle, _count),
+                               _first + part_border(_size, last,   _count), _compare);
+        }
+
+        RandomIterator _first;
+        std::size_t    _size;
+        unsigned       _count;
+        unsigned       _width;
+        Compare        _compare;
+    };
+
+    /// Sort [first, last) using up to \c threads threads
+    /** The range is split into parts that are sorted concurrently and then
+        merged in rounds of pairwise merges. Small ranges are sorted by the
+        calling thread. */
+    template <class RandomIterator, class Compare>
+    void sort(RandomIterator first, RandomIterator last, Compare compare, unsigned threads)
+    {
+        std::size_t size = std::distance(first, last);
+        unsigned count = threads;
+        if(size / 4096 < count)
+            count = static_cast<unsigned>(size / 4096);
+        if(count <= 1)
+        {
+            std::sort(first, last, compare);
+            return;
+        }
+
+        run(sort_part<RandomIterator,Compare>(first, size, count, compare), count);
+        for(unsigned width = 1; width < count; width *= 2)
+            run(merge_parts<RandomIterator,Compare>(first, size, count, width, compare),
+                (count + 2*width - 1) / (2*width));
+    }
+
+} // namespace Parallel
+
+}} // namespace itl boost
+
+#endif
+
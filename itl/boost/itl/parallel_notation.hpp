@@ -0,0 +1,133 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+function parse_notation
+    Parser of the string notation of interval containers, that reads
+    parts of a text concurrently
+--------------------------------------------------------------------*/
+#ifndef __itl_parallel_notation_JOFA_081102_H__
+#define __itl_parallel_notation_JOFA_081102_H__
+
+#include <vector>
+#include <algorithm>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/itl/interval_notation.hpp>
+#include <boost/itl/parallel.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Notation
+{
+    /// Start of the first segment in [pos, last)
+    /** Values do not contain brackets or parentheses. So every one of them
+        opens an interval, and segments of maps start with a parenthesis,
+        that precedes the one of their interval. */
+    inline const char* segment_start(const char* pos, const char* last, bool is_map)
+    {
+        for(; pos != last; ++pos)
+        {
+            if(*pos != '(' && *pos != '[')
+                continue;
+            if(!is_map)
+                return pos;
+            const char* next = skip_space(pos + 1, last);
+            if(*pos == '(' && next != last && (*next == '(' || *next == '['))
+                return pos;
+        }
+        return last;
+    }
+
+    /// Parse segments and append them to \c segments; the position where parsing stopped
+    template <class SegmentT>
+    const char* get_segments(const char* pos, const char* last, std::vector<SegmentT>& segments)
+    {
+        SegmentT segment;
+        for(pos = skip_space(pos, last); pos != last; pos = skip_space(pos, last))
+        {
+            const char* start = pos;
+            if(!get_segment(pos, last, segment))
+                return start;
+            segments.push_back(segment);
+        }
+        return pos;
+    }
+
+    template <class SegmentT>
+    struct parse_part
+    {
+        parse_part(const std::vector<const char*>& borders, std::vector<std::vector<SegmentT> >& parts,
+                   std::vector<const char*>& stops)
+            : _borders(&borders), _parts(&parts), _stops(&stops) {}
+
+        void operator()(unsigned part)const
+        {
+            (*_stops)[part] = get_segments((*_borders)[part], (*_borders)[part+1], (*_parts)[part]);
+        }
+
+        const std::vector<const char*>*       _borders;
+        std::vector<std::vector<SegmentT> >* _parts;
+        std::vector<const char*>*            _stops;
+    };
+
+} // namespace Notation
+
+
+/// Add the segments written in [first, last) to \c object, parsing with up to \c threads threads
+/** The text is split into parts at starts of segments. The parts are
+    parsed concurrently and their segments are added to \c object in one
+    final pass. Returns true, if the text is read completely; otherwise
+    \c object is not changed. */
+template <class ContainerT>
+bool parse_notation(const char* first, const char* last, ContainerT& object, unsigned threads)
+{
+    typedef typename Notation::segment_of<ContainerT>::type segment_type;
+    bool is_map = !boost::is_same<segment_type, typename ContainerT::interval_type>::value;
+
+    std::size_t size = last - first;
+    unsigned count = threads;
+    if(size / 65536 < count)
+        count = static_cast<unsigned>(size / 65536);
+    if(count <= 1)
+    {
+        ContainerT parsed;
+        if(parse_notation(first, last, parsed) != last)
+            return false;
+        if(object.empty())
+            object.swap(parsed);
+        else
+            object += parsed;
+        return true;
+    }
+
+    std::vector<const char*> borders(count + 1, last);
+    borders[0] = first;
+    for(unsigned part = 1; part < count; part++)
+        borders[part] = Notation::segment_start(
+            (std::max)(borders[part-1], first + Parallel::part_border(size, part, count)), last, is_map);
+
+    std::vector<std::vector<segment_type> > parts(count);
+    std::vector<const char*> stops(count);
+    Parallel::run(Notation::parse_part<segment_type>(borders, parts, stops), count);
+    for(unsigned part = 0; part < count; part++)
+        if(stops[part] != borders[part+1])
+            return false;
+
+    typename ContainerT::iterator prior_ = object.end();
+    for(unsigned part = 0; part < count; part++)
+        for(typename std::vector<segment_type>::const_iterator it_ = parts[part].begin();
+            it_ != parts[part].end(); ++it_)
+            prior_ = object.add(prior_, *it_);
+    return true;
+}
+
+}} // namespace itl boost
+
+#endif
+
@@ -77,7 +77,7 @@ namespace boost{namespace itl
     {
     public:
         bool operator() (const Type& x)const 
-        { return x.second == Type::second_type(); }
+        { return x.second == typename Type::second_type(); }
     } ;
 
 
@@ -114,7 +114,7 @@ public:
     typedef typename itl::set<DomainT,Compare,Alloc> atomized_type;
 
     /// Container type for the implementation 
-    typedef typename itl::set<interval_type,exclusive_less,Alloc> ImplSetT;
+    typedef typename base_type::ImplSetT ImplSetT;
 
     /// key type of the implementing container
     typedef typename ImplSetT::key_type   key_type;
@@ -198,13 +198,19 @@ void separate_interval_set<DomainT,Interval,Compare,Alloc>::add_(const value_typ
     if(x.empty()) return;
 
     std::pair<typename ImplSetT::iterator,bool> insertion = this->_set.insert(x);
+    ITL_COUNT(search);
 
     if(insertion.WAS_SUCCESSFUL)
+    {
+        ITL_COUNT(allocation);
         handle_neighbours(insertion.ITERATOR);
+    }
     else
     {
         typename ImplSetT::iterator fst_it = this->_set.lower_bound(x);
         typename ImplSetT::iterator end_it = this->_set.upper_bound(x);
+        ITL_COUNT(search);
+        ITL_COUNT(search);
 
         typename ImplSetT::iterator it=fst_it, nxt_it=fst_it, victim;
         Interval<DomainT> leftResid;  (*it).left_surplus(leftResid,x);
@@ -212,6 +218,7 @@ void separate_interval_set<DomainT,Interval,Compare,Alloc>::add_(const value_typ
 
         while(it!=end_it)
         { 
+            ITL_COUNT(visit);
             if((++nxt_it)==end_it) 
                 (*it).right_surplus(rightResid,x);
             victim = it; it++; this->_set.erase(victim);
@@ -230,8 +237,10 @@ void separate_interval_set<DomainT,Interval,Compare,Alloc>::subtract_(const valu
 {
     if(x.empty()) return;
     typename ImplSetT::iterator fst_it = this->_set.lower_bound(x);
+    ITL_COUNT(search);
     if(fst_it==this->_set.end()) return;
     typename ImplSetT::iterator end_it = this->_set.upper_bound(x);
+    ITL_COUNT(search);
 
     typename ImplSetT::iterator it=fst_it, nxt_it=fst_it, victim;
     interval_type leftResid; (*it).left_surplus(leftResid,x);
@@ -239,9 +248,12 @@ void separate_interval_set<DomainT,Interval,Compare,Alloc>::subtract_(const valu
 
     while(it!=end_it)
     { 
+        ITL_COUNT(visit);
         if((++nxt_it)==end_it) (*it).right_surplus(rightResid,x);
         victim = it; it++; this->_set.erase(victim);
     }
+    ITL_COUNT_IF(!leftResid.empty(),  split);
+    ITL_COUNT_IF(!rightResid.empty(), split);
 
     add_(leftResid);
     add_(rightResid);
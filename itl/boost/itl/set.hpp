@@ -41,6 +41,7 @@ for concepts InplaceAddable and InplaceSubtractable
 #include <boost/itl/type_traits/is_set.hpp>
 #include <boost/itl/type_traits/is_interval_container.hpp>
 #include <boost/itl/type_traits/is_interval_splitter.hpp>
+#include <boost/itl/type_traits/is_interval_joiner.hpp>
 #include <boost/itl/type_traits/is_neutron_absorber.hpp>
 #include <boost/itl/type_traits/is_neutron_emitter.hpp>
 #include <boost/itl/set_algo.hpp>
@@ -154,10 +155,19 @@ namespace boost{namespace itl
         bool disjoint(const set& x2)const { return disjoint(*this, x2); }
 
         iterator add(const value_type& vp) { return insert(vp).ITERATOR; } 
+
+        /** Add \c vp using \c prior_ as hint: Adding is done in constant time,
+            if \c vp is placed right before \c prior_. */
+        iterator add(iterator prior_, const value_type& vp) { return insert(prior_, vp); } 
+
         set& operator += (const value_type& vp) { insert(vp); return *this; } 
 
         // Default subtract-function using -= on CodomTV
         iterator subtract(const value_type& vp);
+
+        /** Subtract \c vp from the element that \c it_ refers to, which must 
+            be equal to \c vp. Returns the position behind the subtraction. */
+        iterator subtract(iterator it_, const value_type&) { erase(it_++); return it_; }
         set& operator -= (const value_type& vp) { subtract(vp); return *this; } 
 
         /// Add a set \c x2 to this set.
@@ -211,6 +221,11 @@ namespace boost{namespace itl
     };
 
 
+    /** Swap the contents of two sets in constant time */
+    template <typename KeyT, template<class>class Compare, template<class>class Alloc>
+    inline void swap(itl::set<KeyT,Compare,Alloc>& lhs, itl::set<KeyT,Compare,Alloc>& rhs)
+    { lhs.swap(rhs); }
+
     /** Standard equality, which is lexicographical equality of the sets
         as sequences, that are given by their Compare order. */
     template <typename KeyT, template<class>class Compare, template<class>class Alloc>
@@ -30,6 +30,7 @@ DEALINGS IN THE SOFTWARE.
 #ifndef __itl_set_algo_H_JOFA_990225__
 #define __itl_set_algo_H_JOFA_990225__
 
+#include <cstddef>
 #include <boost/itl/notate.hpp>
 #include <boost/itl/predicates.hpp>
 #include <boost/itl/functors.hpp>
@@ -82,15 +83,61 @@ namespace boost{namespace itl
         //JODO where to put common algorithms? namespace Collector, Ordered, Sorted, SortedObject
 
 
+        /** The number of successors that \c seek probes in a container of
+            \c size elements, before it searches the tree: The depth of the tree. */
+        inline int seek_depth(std::size_t size)
+        {
+            int depth = 1;
+            for(; size > 1; size >>= 1)
+                ++depth;
+            return depth;
+        }
+
+        /** Function template <tt>seek</tt> moves \c it_ forward to the first element
+            of \c object whose key is not less than \c key. The next \c probes
+            successors of \c it_ are visited one by one. If the key is further away
+            it is searched in the tree.
+
+            Merge walks over two sorted containers use \c seek to advance
+            the cursor of one container to the key of the other. If both containers
+            have similar sizes, gaps are small and the walk is linear. If the sizes
+            are skewed, large gaps are bridged by tree searches, so a walk never
+            costs more than searching every element of the smaller container in
+            the larger one. */
+        template<class ObjectT, class IteratorT>
+        void seek(ObjectT& object, IteratorT& it_, 
+                  const typename ObjectT::key_type& key, int probes)
+        {
+            typename ObjectT::key_compare key_less;
+            for(; probes > 0; --probes)
+            {
+                if(it_ == object.end() || !key_less(ObjectT::key_value(it_), key))
+                    return;
+                ++it_;
+            }
+
+            if(it_ != object.end() && key_less(ObjectT::key_value(it_), key))
+                it_ = object.lower_bound(key);
+        }
+
+
+        /** Add \c x2 to \c result. The elements of \c x2 are added in ascending
+            order, each one using the position of its key in \c result as hint. */
         template<class ObjectT>
         ObjectT& add(ObjectT& result, const ObjectT& x2)
         {
             if(&result == &x2)
                 return result;
 
+            int probes = seek_depth(result.size());
+            typename ObjectT::iterator prior_ = result.begin();
+
             typedef typename ObjectT::const_iterator Object_const_iterator;
             for(Object_const_iterator x2_ = x2.begin(); x2_ != x2.end(); x2_++)
-                result += *x2_;
+            {
+                seek(result, prior_, ObjectT::key_value(x2_), probes);
+                prior_ = result.add(prior_, *x2_);
+            }
 
             return result;
         }
@@ -108,11 +155,18 @@ namespace boost{namespace itl
             if(!common_range(common_lwb_, common_upb_, x2, result))
                 return result;
 
-            typename CoObjectT::const_iterator x2_ = common_lwb_;
-            typename ObjectT::iterator common_;
+            int probes = seek_depth(result.size());
+            typename ObjectT::key_compare key_less;
+            typename ObjectT::iterator common_ = result.begin();
 
-            while(x2_ != common_upb_)
-                result.subtract(*x2_++);
+            for(typename CoObjectT::const_iterator x2_ = common_lwb_; x2_ != common_upb_; ++x2_)
+            {
+                seek(result, common_, CoObjectT::key_value(x2_), probes);
+                if(common_ == result.end())
+                    break;
+                if(!key_less(CoObjectT::key_value(x2_), ObjectT::key_value(common_)))
+                    common_ = result.subtract(common_, *x2_);
+            }
 
             return result;
         }
@@ -125,11 +179,18 @@ namespace boost{namespace itl
             if(!common_range(common_lwb_, common_upb_, x2, result))
                 return result;
 
-            typename CoObjectT::const_iterator x2_ = common_lwb_;
-            typename ObjectT::iterator common_;
+            int probes = seek_depth(result.size());
+            typename ObjectT::key_compare key_less;
+            typename ObjectT::iterator common_ = result.begin();
 
-            while(x2_ != common_upb_)
-                result.erase(*x2_++);
+            for(typename CoObjectT::const_iterator x2_ = common_lwb_; x2_ != common_upb_; ++x2_)
+            {
+                seek(result, common_, CoObjectT::key_value(x2_), probes);
+                if(common_ == result.end())
+                    break;
+                if(!key_less(CoObjectT::key_value(x2_), ObjectT::key_value(common_)))
+                    result.erase(common_++);
+            }
 
             return result;
         }
@@ -151,11 +212,14 @@ namespace boost{namespace itl
             if(!common_range(common_lwb_, common_upb_, sub, super))
                 return false;
 
-            typename SetType::const_iterator sub_ = common_lwb_, super_;
-            while(sub_ != common_upb_)
+            int probes = seek_depth(super.size());
+            typename SetType::key_compare key_less;
+            typename SetType::const_iterator super_ = super.begin();
+
+            for(typename SetType::const_iterator sub_ = common_lwb_; sub_ != common_upb_; ++sub_)
             {
-                super_ = super.find(*sub_++);
-                if(super_ == super.end()) 
+                seek(super, super_, SetType::key_value(sub_), probes);
+                if(super_ == super.end() || key_less(SetType::key_value(sub_), SetType::key_value(super_)))
                     return false;
             }
             return true;
@@ -186,24 +250,33 @@ namespace boost{namespace itl
         }
 
 
-        /** */
+        /** Intersection of \c x1 and \c x2. The smaller set is walked, its
+            elements are sought in the larger one. Common elements are appended
+            to \c result with an end hint. */
         template<class SetType>
         void intersect(SetType& result, const SetType& x1, const SetType& x2)
         {
+            const SetType& walked = x1.size() <= x2.size() ? x1 : x2;
+            const SetType& sought = x1.size() <= x2.size() ? x2 : x1;
+
             typename SetType::const_iterator common_lwb_;
             typename SetType::const_iterator common_upb_;
 
             result.clear();
-            if(!common_range(common_lwb_, common_upb_, x1, x2))
+            if(!common_range(common_lwb_, common_upb_, walked, sought))
                 return;
 
-            typename SetType::const_iterator x1_ = common_lwb_, x2_;
+            int probes = seek_depth(sought.size());
+            typename SetType::key_compare key_less;
+            typename SetType::const_iterator sought_ = sought.begin();
 
-            while(x1_ != common_upb_)
+            for(typename SetType::const_iterator walked_ = common_lwb_; walked_ != common_upb_; ++walked_)
             {
-                x2_ = x2.find(*x1_++);
-                if(x2_ != x2.end())
-                    result.insert(*x2_);
+                seek(sought, sought_, SetType::key_value(walked_), probes);
+                if(sought_ == sought.end())
+                    return;
+                if(!key_less(SetType::key_value(walked_), SetType::key_value(sought_)))
+                    result.insert(result.end(), *sought_);
             }
         }
 
@@ -226,12 +299,17 @@ namespace boost{namespace itl
             if(!common_range(common_lwb_, common_upb_, x1, x2))
                 return true;
 
-            typename SetType::const_iterator x1_ = common_lwb_, x2_;
+            int probes = seek_depth(x2.size());
+            typename SetType::key_compare key_less;
+            typename SetType::const_iterator x2_ = x2.begin();
 
-            while(x1_ != common_upb_)
+            for(typename SetType::const_iterator x1_ = common_lwb_; x1_ != common_upb_; ++x1_)
             {
-                x2_ = x2.find(*x1_++);
-                if(x2_ != x2.end()) return false; // found a common element
+                seek(x2, x2_, SetType::key_value(x1_), probes);
+                if(x2_ == x2.end())
+                    return true;
+                if(!key_less(SetType::key_value(x1_), SetType::key_value(x2_)))
+                    return false; // found a common element
             }
             // found no common element
             return true;    
@@ -241,14 +319,17 @@ namespace boost{namespace itl
         void subtract(SetType& result, const SetType& x1, const SetType& x2)
         {
             SetType temp;
-            typename SetType::const_iterator x1_ = x1.begin(), x2_;
+            typename SetType::const_iterator x1_ = x1.begin();
+            typename SetType::const_iterator x2_ = x2.begin();
+            typename SetType::key_compare key_less;
+            int probes = seek_depth(x2.size());
 
             if(&x1 != &x2)
                 while(x1_ != x1.end())
                 {
-                    x2_ = x2.find(*x1_);
-                    if(x2_ == x2.end())
-                        temp.insert(*x1_);
+                    seek(x2, x2_, SetType::key_value(x1_), probes);
+                    if(x2_ == x2.end() || key_less(SetType::key_value(x1_), SetType::key_value(x2_)))
+                        temp.insert(temp.end(), *x1_);
                     ++x1_;
                 }
                 temp.swap(result);
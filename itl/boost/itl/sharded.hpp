@@ -0,0 +1,266 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class sharded
+    Interval maps, that are split into shards of their domain, which
+    are locked separately
+--------------------------------------------------------------------*/
+#ifndef __itl_sharded_JOFA_081104_H__
+#define __itl_sharded_JOFA_081104_H__
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <boost/thread/mutex.hpp>
+#include <boost/itl/interval.hpp>
+
+namespace boost{namespace itl
+{
+
+namespace Shard
+{
+    struct adder
+    {
+        template <class MapT, class OperandT>
+        void operator()(MapT& object, const OperandT& x)const { object.add(x); }
+    };
+
+    struct subtracter
+    {
+        template <class MapT, class OperandT>
+        void operator()(MapT& object, const OperandT& x)const { object.subtract(x); }
+    };
+
+    struct inserter
+    {
+        template <class MapT, class OperandT>
+        void operator()(MapT& object, const OperandT& x)const { object.insert(x); }
+    };
+
+    struct eraser
+    {
+        template <class MapT, class OperandT>
+        void operator()(MapT& object, const OperandT& x)const { object.erase(x); }
+    };
+
+    /// The part of an operand within \c piece
+    /** Interval operands are the region they are clipped to, so their
+        parts are the pieces. */
+    template <class IntervalT>
+    inline const IntervalT& clip(const IntervalT&, const IntervalT& piece) { return piece; }
+
+    template <class DomainT>
+    inline const DomainT& clip(const DomainT& x, const itl::interval<DomainT>&) { return x; }
+
+    template <class KeyT, class CodomainT, class IntervalT>
+    inline std::pair<IntervalT, CodomainT>
+        clip(const std::pair<KeyT, CodomainT>& x, const IntervalT& piece)
+    { return std::pair<IntervalT, CodomainT>(piece, x.second); }
+
+} // namespace Shard
+
+
+/// An interval map for concurrent writers, that is split into shards of its domain
+/**
+    A <b>sharded</b> map partitions its domain at ascending borders
+    <tt>b_1, ..., b_k</tt> into the shards <tt>(-inf, b_1)</tt>,
+    <tt>[b_1, b_2)</tt>, ..., <tt>[b_k, inf)</tt>. Every shard is an
+    interval map with a mutex of its own, so writers, that update different
+    shards, do not wait for each other.
+
+    An update is clipped to the shards that it overlaps and applied to each
+    of them. It locks its shards in ascending order and keeps them locked
+    until all its pieces are applied, so updates are atomic and free of
+    deadlocks. Whole map reads lock all shards in the same order and see a
+    consistent state. Segments of neighbouring shards are joined, when they
+    are collected by <tt>snapshot</tt>.
+
+    Mutexes are those of Boost.Thread, so programs using sharded maps
+    link boost_thread.
+
+    @author Joachim Faulhaber
+*/
+template <class MapT>
+class sharded
+{
+public:
+    typedef MapT                                        container_type;
+    typedef typename MapT::domain_type                  domain_type;
+    typedef typename MapT::interval_type                interval_type;
+    typedef typename MapT::value_type                   value_type;
+
+    /// A map with one shard
+    sharded() { _shards.push_back(new shard); }
+
+    /// A map with shards between the ascending borders in <tt>[first, last)</tt>
+    template <class InputIterator>
+    sharded(InputIterator first, InputIterator last)
+        : _borders(first, last)
+    {
+        for(std::size_t idx = 0; idx <= _borders.size(); idx++)
+            _shards.push_back(new shard);
+    }
+
+    ~sharded()
+    {
+        for(std::size_t idx = 0; idx < _shards.size(); idx++)
+            delete _shards[idx];
+    }
+
+    std::size_t shard_count()const { return _shards.size(); }
+
+    /// Index of the shard that contains \c x
+    std::size_t shard_of(const domain_type& x)const
+    { return std::upper_bound(_borders.begin(), _borders.end(), x) - _borders.begin(); }
+
+    /** @name Updates, that lock the shards they overlap */
+    //@{
+    template <class OperandT>
+    sharded& add(const OperandT& x) { update(x, Shard::adder()); return *this; }
+
+    template <class OperandT>
+    sharded& subtract(const OperandT& x) { update(x, Shard::subtracter()); return *this; }
+
+    template <class OperandT>
+    sharded& insert(const OperandT& x) { update(x, Shard::inserter()); return *this; }
+
+    template <class OperandT>
+    sharded& erase(const OperandT& x) { update(x, Shard::eraser()); return *this; }
+
+    template <class OperandT>
+    sharded& operator += (const OperandT& x) { return add(x); }
+
+    template <class OperandT>
+    sharded& operator -= (const OperandT& x) { return subtract(x); }
+    //@}
+
+    /** @name Reads */
+    //@{
+    /// Does the map contain the element \c x? Locks the shard of \c x only.
+    bool contains(const domain_type& x)const
+    {
+        std::size_t idx = shard_of(x);
+        shard_lock guard(_shards, idx, idx + 1);
+        return _shards[idx]->_object.contains(x);
+    }
+
+    /// A consistent copy of the whole map, in which the shards are joined
+    MapT snapshot()const
+    {
+        MapT result;
+        shard_lock guard(_shards, 0, _shards.size());
+        typename MapT::iterator prior_ = result.end();
+        for(std::size_t idx = 0; idx < _shards.size(); idx++)
+        {
+            const MapT& object = _shards[idx]->_object;
+            for(typename MapT::const_iterator it_ = object.begin(); it_ != object.end(); ++it_)
+                prior_ = result.add(prior_, *it_);
+        }
+        return result;
+    }
+
+    /// Remove all segments
+    void clear()
+    {
+        shard_lock guard(_shards, 0, _shards.size());
+        for(std::size_t idx = 0; idx < _shards.size(); idx++)
+            _shards[idx]->_object.clear();
+    }
+    //@}
+
+private:
+    struct shard
+    {
+        MapT              _object;
+        boost::mutex      _mutex;
+    };
+
+    // Locks the shards in [first, past) in ascending order, so lockers never
+    // wait for each other in a cycle. They are unlocked on destruction, also
+    // if an update throws.
+    class shard_lock
+    {
+    public:
+        shard_lock(const std::vector<shard*>& shards, std::size_t first, std::size_t past)
+            : _shards(shards), _first(first), _past(first)
+        {
+            for(; _past < past; _past++)
+                _shards[_past]->_mutex.lock();
+        }
+
+        ~shard_lock()
+        {
+            for(std::size_t idx = _past; idx > _first; idx--)
+                _shards[idx-1]->_mutex.unlock();
+        }
+
+    private:
+        shard_lock(const shard_lock&);
+        shard_lock& operator = (const shard_lock&);
+
+    private:
+        const std::vector<shard*>& _shards;
+        std::size_t                _first;
+        std::size_t                _past;
+    };
+
+    // Shards and their mutexes are not copied
+    sharded(const sharded&);
+    sharded& operator = (const sharded&);
+
+    static interval_type region_of(const domain_type& x) { return interval_type(x); }
+    static interval_type region_of(const interval_type& x) { return x; }
+
+    template <class IntervalT, class CodomainT>
+    static interval_type region_of(const std::pair<IntervalT, CodomainT>& x) { return x.first; }
+
+    template <class OperandT, class OperationT>
+    void update(const OperandT& x, const OperationT& operation)
+    {
+        interval_type region = region_of(x);
+        if(region.empty())
+            return;
+
+        std::size_t first = shard_of(region.lower()), past = shard_of(region.upper()) + 1;
+        shard_lock guard(_shards, first, past);
+        if(first + 1 == past)
+        {
+            // Operands within one shard are applied unclipped
+            operation(_shards[first]->_object, x);
+            return;
+        }
+
+        for(std::size_t idx = first; idx < past; idx++)
+        {
+            interval_type piece = shard_part(region, idx);
+            if(!piece.empty())
+                operation(_shards[idx]->_object, Shard::clip(x, piece));
+        }
+    }
+
+    // The part of \c region within shard \c idx
+    interval_type shard_part(const interval_type& region, std::size_t idx)const
+    {
+        interval_type piece = region;
+        if(idx > 0)
+            piece.intersect(piece, closed_interval(_borders[idx-1], piece.upper()));
+        if(idx < _borders.size())
+            piece.intersect(piece, rightopen_interval(piece.lower(), _borders[idx]));
+        return piece;
+    }
+
+private:
+    std::vector<domain_type> _borders;
+    std::vector<shard*>      _shards;
+};
+
+}} // namespace itl boost
+
+#endif
+
@@ -0,0 +1,559 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class small_interval_set
+    an interval_set that keeps a few intervals inline, without allocation
+--------------------------------------------------------------------*/
+#ifndef __itl_small_interval_set_JOFA_081023_H__
+#define __itl_small_interval_set_JOFA_081023_H__
+
+#include <string>
+#include <algorithm>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/operation_stats.hpp>
+
+namespace boost{namespace itl
+{
+
+/// Interval set that stores up to InlineCapacity intervals without allocation
+/**
+    <b>small_interval_set</b> has the semantics of an <b>interval_set</b>:
+    Touching or overlapping intervals are joined. As long as there are no more
+    than <tt>InlineCapacity</tt> intervals, they are kept in an array inside
+    the object and all operations are linear scans on that array. If the set
+    grows beyond <tt>InlineCapacity</tt> intervals it spills to an allocated
+    <b>interval_set</b>. It returns to inline storage when it has shrunken to
+    half the inline capacity.
+
+    Most sets of intervals that are attached to the segments of an
+    interval_map are tiny. Using a small_interval_set as \c CodomainT of
+    an interval_map saves allocations on every segment split:
+
+    <tt>interval_map<int, small_interval_set<int> > blocks;</tt>
+*/
+template
+<
+    typename             DomainT,
+    int                  InlineCapacity = 4,
+    template<class>class Interval = itl::interval,
+    template<class>class Compare  = std::less,
+    template<class>class Alloc    = std::allocator
+>
+class small_interval_set
+{
+public:
+    typedef small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc> type;
+
+    /// The interval set that takes over, if there are more than InlineCapacity intervals
+    typedef itl::interval_set<DomainT,Interval,Compare,Alloc> spill_type;
+
+    /// The domain type of the set
+    typedef DomainT   domain_type;
+    /// The codomaintype is the same as domain_type
+    typedef DomainT   codomain_type;
+
+    /// The interval type of the set
+    typedef Interval<DomainT> interval_type;
+    /// Comparison functor for intervals
+    typedef exclusive_less<interval_type> key_compare;
+
+    typedef interval_type key_type;
+    typedef interval_type data_type;
+    typedef interval_type value_type;
+
+    /// The corresponding atomized type representing this interval container of elements
+    typedef typename itl::set<DomainT,Compare,Alloc> atomized_type;
+
+    typedef std::size_t size_type;
+
+    /// const_iterator for iteration over intervals
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef interval_type                   value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef const interval_type*            pointer;
+        typedef const interval_type&            reference;
+
+        const_iterator(): _inline(0), _is_spilled(false) {}
+        const_iterator(const interval_type* inline_): _inline(inline_), _is_spilled(false) {}
+        const_iterator(typename spill_type::const_iterator spilled_)
+            : _inline(0), _spilled(spilled_), _is_spilled(true) {}
+
+        reference operator*()const  { return _is_spilled ? *_spilled : *_inline; }
+        pointer   operator->()const { return &**this; }
+
+        const_iterator& operator++() { if(_is_spilled) ++_spilled; else ++_inline; return *this; }
+        const_iterator  operator++(int) { const_iterator it_ = *this; ++*this; return it_; }
+        const_iterator& operator--() { if(_is_spilled) --_spilled; else --_inline; return *this; }
+        const_iterator  operator--(int) { const_iterator it_ = *this; --*this; return it_; }
+
+        bool operator == (const const_iterator& rhs)const
+        { return _is_spilled ? _spilled == rhs._spilled : _inline == rhs._inline; }
+        bool operator != (const const_iterator& rhs)const { return !(*this == rhs); }
+
+    private:
+        const interval_type*                _inline;
+        typename spill_type::const_iterator _spilled;
+        bool                                _is_spilled;
+    };
+
+    typedef const_iterator iterator;
+
+public:
+    /// Default constructor for the empty set
+    small_interval_set(): _size(0), _spill(0) {}
+
+    /// Constructor for a single element
+    explicit small_interval_set(const domain_type& value): _size(0), _spill(0)
+    { add_(interval_type(value)); }
+
+    /// Constructor for a single interval
+    explicit small_interval_set(const interval_type& itv): _size(0), _spill(0)
+    { add_(itv); }
+
+    small_interval_set(const small_interval_set& src): _size(0), _spill(0)
+    { assign(src); }
+
+    small_interval_set& operator = (const small_interval_set& src)
+    {
+        if(this != &src)
+        {
+            small_interval_set copy(src);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    ~small_interval_set() { release(); }
+
+    void swap(small_interval_set& src)
+    {
+        for(int idx = 0; idx < InlineCapacity; idx++)
+            std::swap(_inline[idx], src._inline[idx]);
+        std::swap(_size,  src._size);
+        std::swap(_spill, src._spill);
+    }
+
+    /// sets the container empty
+    void clear() { release(); _size = 0; }
+
+    /// is the container empty
+    bool empty()const { return _spill == 0 ? _size == 0 : _spill->empty(); }
+
+    /// Have the intervals been moved to an allocated interval_set?
+    bool spilled()const { return _spill != 0; }
+
+    /// number of intervals
+    std::size_t interval_count()const { return iterative_size(); }
+    std::size_t iterative_size()const
+    { return _spill == 0 ? static_cast<std::size_t>(_size) : _spill->iterative_size(); }
+
+    /// lower bound of all intervals in the set
+    DomainT lower()const
+    { return empty()? interval_type().lower() : (*begin()).lower(); }
+    /// upper bound of all intervals in the set
+    DomainT upper()const
+    { return empty()? interval_type().upper() : (*--end()).upper(); }
+
+    /// Does the container contain the element \c x
+    bool contains(const DomainT& x)const { return contains(interval_type(x)); }
+
+    /// Does the container contain the interval x
+    bool contains(const interval_type& x)const
+    {
+        if(x.empty())
+            return true;
+        if(_spill != 0)
+            return _spill->contains(x);
+        for(int idx = 0; idx < _size; idx++)
+            if(x.contained_in(_inline[idx]))
+                return true;
+        return false;
+    }
+
+    const_iterator begin()const
+    { return _spill == 0 ? const_iterator(_inline) : const_iterator(_spill->begin()); }
+    const_iterator end()const
+    { return _spill == 0 ? const_iterator(_inline + _size) : const_iterator(_spill->end()); }
+
+    /// Add a single element \c x to the set
+    small_interval_set& add(const DomainT& x) { add_(interval_type(x)); return *this; }
+    /// Add an interval of elements \c x to the set
+    small_interval_set& add(const interval_type& x) { add_(x); return *this; }
+
+    /// Add an interval of elements \c x; linear scans need no hint
+    iterator add(iterator, const interval_type& x) { add_(x); return end(); }
+
+    /// Subtract a single element \c x from the set
+    small_interval_set& subtract(const DomainT& x) { subtract_(interval_type(x)); return *this; }
+    /// Subtract an interval of elements \c x from the set
+    small_interval_set& subtract(const interval_type& x) { subtract_(x); return *this; }
+
+    small_interval_set& operator += (const DomainT& x)       { return add(x); }
+    small_interval_set& operator += (const interval_type& x) { return add(x); }
+    small_interval_set& operator += (const small_interval_set& x2)
+    {
+        if(this != &x2)
+            for(const_iterator it_ = x2.begin(); it_ != x2.end(); ++it_)
+                add_(*it_);
+        return *this;
+    }
+
+    small_interval_set& operator -= (const DomainT& x)       { return subtract(x); }
+    small_interval_set& operator -= (const interval_type& x) { return subtract(x); }
+    small_interval_set& operator -= (const small_interval_set& x2)
+    {
+        if(this == &x2)
+            clear();
+        else
+            for(const_iterator it_ = x2.begin(); it_ != x2.end(); ++it_)
+                subtract_(*it_);
+        return *this;
+    }
+
+    small_interval_set& operator *= (const DomainT& x) { return *this *= interval_type(x); }
+    small_interval_set& operator *= (const interval_type& x);
+    small_interval_set& operator *= (const small_interval_set& x2);
+
+    const std::string as_string()const
+    {
+        std::string res("");
+        for(const_iterator it_ = begin(); it_ != end(); ++it_)
+            res += (*it_).as_string();
+        return res;
+    }
+
+    template<typename IteratorT>
+    static const key_type& key_value(IteratorT& value_){ return (*value_); }
+
+    template<typename IteratorT>
+    static codomain_type codomain_value(IteratorT& value_)
+    { return (*value_).empty()? codomain_type() : (*value_).first(); }
+
+    static value_type make_domain_element(const domain_type& dom_val, const codomain_type&)
+    { return value_type(interval_type(dom_val)); }
+
+    static value_type make_segment(const interval_type& itv, const codomain_type&)
+    { return itv; }
+
+private:
+    void add_(const interval_type& x);
+    void subtract_(const interval_type& x);
+
+    // Replace the inline intervals [first,past) by [replacement,replacement_end)
+    void replace(int first, int past, const interval_type* replacement, const interval_type* replacement_end);
+
+    void assign(const small_interval_set& src);
+    void spill();
+    void unspill();
+    void release();
+
+private:
+    interval_type _inline[InlineCapacity];
+    int           _size;
+    spill_type*   _spill;
+};
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+void small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>
+    ::add_(const interval_type& x)
+{
+    if(x.empty())
+        return;
+    if(_spill != 0)
+    {
+        _spill->add(x);
+        return;
+    }
+
+    // [first,past) are the intervals that overlap or touch x
+    int first = 0;
+    while(first < _size && _inline[first].exclusive_less(x) && !_inline[first].touches(x))
+        first++;
+    int past = first;
+    interval_type joined = x;
+    while(past < _size && !(x.exclusive_less(_inline[past]) && !x.touches(_inline[past])))
+        joined.extend(_inline[past++]);
+
+    if(first == past && _size == InlineCapacity)
+    {
+        spill();
+        _spill->add(x);
+    }
+    else
+        replace(first, past, &joined, &joined + 1);
+}
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+void small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>
+    ::subtract_(const interval_type& x)
+{
+    if(x.empty())
+        return;
+    if(_spill != 0)
+    {
+        _spill->subtract(x);
+        unspill();
+        return;
+    }
+
+    // [first,past) are the intervals that overlap x
+    int first = 0;
+    while(first < _size && _inline[first].exclusive_less(x))
+        first++;
+    int past = first;
+    while(past < _size && !x.exclusive_less(_inline[past]))
+        past++;
+    if(first == past)
+        return;
+
+    interval_type rest[2];
+    int rest_count = 0;
+    _inline[first].left_surplus(rest[rest_count], x);
+    if(!rest[rest_count].empty())
+        rest_count++;
+    _inline[past-1].right_surplus(rest[rest_count], x);
+    if(!rest[rest_count].empty())
+        rest_count++;
+
+    if(_size - (past - first) + rest_count > InlineCapacity)
+    {
+        spill();
+        _spill->subtract(x);
+    }
+    else
+        replace(first, past, rest, rest + rest_count);
+}
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>&
+    small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>
+    ::operator *= (const interval_type& x)
+{
+    if(_spill != 0)
+    {
+        spill_type section;
+        _spill->add_intersection(section, x);
+        _spill->swap(section);
+        unspill();
+        return *this;
+    }
+
+    int size = 0;
+    for(int idx = 0; idx < _size; idx++)
+    {
+        interval_type common;
+        _inline[idx].intersect(common, x);
+        if(!common.empty())
+            _inline[size++] = common;
+    }
+    for(int idx = size; idx < _size; idx++)
+        _inline[idx] = interval_type();
+    _size = size;
+    return *this;
+}
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>&
+    small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>
+    ::operator *= (const small_interval_set& x2)
+{
+    if(this == &x2)
+        return *this;
+
+    // Intersections of intervals of both sets, ordered and disjoint
+    small_interval_set section;
+    const_iterator it_ = begin(), x2_ = x2.begin();
+    while(it_ != end() && x2_ != x2.end())
+    {
+        interval_type common;
+        (*it_).intersect(common, *x2_);
+        if(!common.empty())
+            section.add_(common);
+
+        if((*it_).upper_less(*x2_))
+            ++it_;
+        else
+            ++x2_;
+    }
+    swap(section);
+    return *this;
+}
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+void small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>
+    ::replace(int first, int past, const interval_type* replacement, const interval_type* replacement_end)
+{
+    int count = static_cast<int>(replacement_end - replacement);
+    int size  = _size - (past - first) + count;
+    BOOST_ASSERT(size <= InlineCapacity);
+
+    if(count > past - first)
+        for(int idx = _size - 1; idx >= past; idx--)
+            _inline[idx + count - (past - first)] = _inline[idx];
+    else if(count < past - first)
+        for(int idx = past; idx < _size; idx++)
+            _inline[idx + count - (past - first)] = _inline[idx];
+
+    for(int idx = 0; idx < count; idx++)
+        _inline[first + idx] = replacement[idx];
+    for(int idx = size; idx < _size; idx++)
+        _inline[idx] = interval_type();
+    _size = size;
+}
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+void small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>
+    ::assign(const small_interval_set& src)
+{
+    clear();
+    if(src._spill != 0)
+    {
+        spill();
+        *_spill = *src._spill;
+    }
+    else
+    {
+        for(int idx = 0; idx < src._size; idx++)
+            _inline[idx] = src._inline[idx];
+        _size = src._size;
+    }
+}
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+void small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>::spill()
+{
+    BOOST_ASSERT(_spill == 0);
+    spill_type* spilled = Alloc<spill_type>().allocate(1);
+    new(spilled) spill_type();
+    ITL_COUNT(allocation);
+    for(int idx = 0; idx < _size; idx++)
+    {
+        spilled->add(_inline[idx]);
+        _inline[idx] = interval_type();
+    }
+    _size  = 0;
+    _spill = spilled;
+}
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+void small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>::unspill()
+{
+    // Returning to inline storage at half the capacity avoids spilling
+    // again on the next insertion
+    if(_spill == 0 || static_cast<int>(_spill->iterative_size()) > InlineCapacity/2)
+        return;
+
+    int size = 0;
+    for(typename spill_type::const_iterator it_ = _spill->begin(); it_ != _spill->end(); ++it_)
+        _inline[size++] = *it_;
+    release();
+    _size = size;
+}
+
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+void small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>::release()
+{
+    if(_spill != 0)
+    {
+        _spill->~spill_type();
+        Alloc<spill_type>().deallocate(_spill, 1);
+        _spill = 0;
+    }
+    for(int idx = 0; idx < _size; idx++)
+        _inline[idx] = interval_type();
+}
+
+
+//-----------------------------------------------------------------------------
+// equality and ordering
+//-----------------------------------------------------------------------------
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+inline bool operator == (const small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>& lhs,
+                         const small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>& rhs)
+{
+    return lhs.iterative_size() == rhs.iterative_size()
+        && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+inline bool operator < (const small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>& lhs,
+                        const small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>& rhs)
+{
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), Compare<Interval<DomainT> >());
+}
+
+template <typename DomainT, int InlineCapacity, template<class>class Interval,
+          template<class>class Compare, template<class>class Alloc>
+inline bool operator <= (const small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>& lhs,
+                         const small_interval_set<DomainT,InlineCapacity,Interval,Compare,Alloc>& rhs)
+{
+    return lhs < rhs || lhs == rhs;
+}
+
+
+template <class Type, int InlineCapacity>
+struct is_set<itl::small_interval_set<Type,InlineCapacity> >
+{ enum{value = true}; };
+
+template <class Type, int InlineCapacity>
+struct is_interval_container<itl::small_interval_set<Type,InlineCapacity> >
+{ enum{value = true}; };
+
+template <class Type, int InlineCapacity>
+struct is_interval_splitter<itl::small_interval_set<Type,InlineCapacity> >
+{ enum{value = false}; };
+
+template <class Type, int InlineCapacity>
+struct is_interval_joiner<itl::small_interval_set<Type,InlineCapacity> >
+{ enum{value = true}; };
+
+template <class Type, int InlineCapacity>
+struct is_neutron_absorber<itl::small_interval_set<Type,InlineCapacity> >
+{ enum{value = false}; };
+
+template <class Type, int InlineCapacity>
+struct is_neutron_emitter<itl::small_interval_set<Type,InlineCapacity> >
+{ enum{value = false}; };
+
+template <class Type, int InlineCapacity>
+struct type_to_string<itl::small_interval_set<Type,InlineCapacity> >
+{
+    static std::string apply()
+    { return "small_interval_set<"+ type_to_string<Type>::apply() +">"; }
+};
+
+}} // namespace itl boost
+
+#endif
+
+
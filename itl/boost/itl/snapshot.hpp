@@ -0,0 +1,391 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+functions write_snapshot, read_snapshot; class snapshot_view
+    Versioned binary snapshots of containers of plain old data
+--------------------------------------------------------------------*/
+#ifndef __itl_snapshot_JOFA_081101_H__
+#define __itl_snapshot_JOFA_081101_H__
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/itl/notate.hpp>
+#include <boost/itl/interval.hpp>
+
+namespace boost{namespace itl
+{
+
+/** \file snapshot.hpp
+
+    A snapshot is a header followed by an array of fixed size records, one
+    record per segment of an interval container or per element of an
+    itl::set or itl::map:
+
+    <pre>
+    magic "ITLS", version, byte order mark, kind of container,
+    sizes of domain, codomain and record, number of records
+    record ... record
+    </pre>
+
+    Records are memory images of the domain and codomain values, so these
+    have to be plain old data, that are ordered by <tt>std::less</tt>.
+    Snapshots can be read on machines with the same byte order and the same
+    sizes of the value types only, which read_snapshot and snapshot_view
+    check. Kinds of containers are interval sets, interval maps, element
+    sets and element maps. A snapshot of a split_interval_map can be read
+    into an interval_map, which joins the segments again.
+*/
+namespace Snapshot
+{
+    enum { current_version = 1, byte_order_mark = 0x0102 };
+
+    enum container_kind { element_set = 1, element_map, interval_set, interval_map };
+
+    struct header
+    {
+        char            magic[4];
+        boost::uint16_t version;
+        boost::uint16_t byte_order;
+        boost::uint32_t kind;
+        boost::uint32_t domain_size;
+        boost::uint32_t codomain_size;
+        boost::uint32_t record_size;
+        boost::uint64_t count;
+    };
+
+    inline header make_header(container_kind kind, std::size_t domain_size,
+                              std::size_t codomain_size, std::size_t record_size,
+                              boost::uint64_t count)
+    {
+        header head;
+        std::memset(&head, 0, sizeof(head));
+        std::memcpy(head.magic, "ITLS", 4);
+        head.version       = current_version;
+        head.byte_order    = byte_order_mark;
+        head.kind          = kind;
+        head.domain_size   = static_cast<boost::uint32_t>(domain_size);
+        head.codomain_size = static_cast<boost::uint32_t>(codomain_size);
+        head.record_size   = static_cast<boost::uint32_t>(record_size);
+        head.count         = count;
+        return head;
+    }
+
+    /// Does \c found describe records of the same layout as \c expected?
+    inline bool matches(const header& found, const header& expected)
+    {
+        return std::memcmp(found.magic, expected.magic, 4) == 0
+            && found.version       == expected.version
+            && found.byte_order    == expected.byte_order
+            && found.kind          == expected.kind
+            && found.domain_size   == expected.domain_size
+            && found.codomain_size == expected.codomain_size
+            && found.record_size   == expected.record_size;
+    }
+
+    //--------------------------------------------------------------------------
+    template <class DomainT>
+    struct element_record
+    {
+        DomainT key;
+
+        bool precedes(const DomainT& x)const { return key < x; }
+        bool holds(const DomainT& x)const { return !(key < x) && !(x < key); }
+    };
+
+    template <class DomainT, class CodomainT>
+    struct element_pair_record
+    {
+        DomainT   key;
+        CodomainT value;
+
+        bool precedes(const DomainT& x)const { return key < x; }
+        bool holds(const DomainT& x)const { return !(key < x) && !(x < key); }
+    };
+
+    template <class DomainT>
+    struct interval_record
+    {
+        DomainT       lower;
+        DomainT       upper;
+        unsigned char bounds;
+
+        itl::interval<DomainT> interval()const
+        { return itl::interval<DomainT>(lower, upper, bounds); }
+
+        void set_interval(const itl::interval<DomainT>& itv)
+        { lower = itv.lower(); upper = itv.upper(); bounds = itv.boundtypes(); }
+
+        bool precedes(const DomainT& x)const
+        { return interval().exclusive_less(itl::interval<DomainT>(x)); }
+        bool holds(const DomainT& x)const { return interval().contains(x); }
+    };
+
+    template <class DomainT, class CodomainT>
+    struct segment_record : public interval_record<DomainT>
+    {
+        CodomainT value;
+    };
+
+    //--------------------------------------------------------------------------
+    /// Interval containers are the containers with interval keys
+    template <class KeyT> struct has_interval_keys { enum { value = false }; };
+
+    template <class DomainT>
+    struct has_interval_keys<itl::interval<DomainT> > { enum { value = true }; };
+
+    /// Records and kinds of the snapshots of \c ContainerT
+    template <class ContainerT,
+              bool IsIntervalContainer = has_interval_keys<typename ContainerT::key_type>::value,
+              bool IsSet = boost::is_same<typename ContainerT::value_type,
+                                          typename ContainerT::key_type>::value>
+    struct format;
+
+    template <class ContainerT>
+    struct format<ContainerT, false, true>
+    {
+        typedef typename ContainerT::key_type   domain_type;
+        typedef typename ContainerT::value_type value_type;
+        typedef element_record<domain_type>     record_type;
+        enum { kind = element_set, codomain_size = 0 };
+
+        static void fill(record_type& record, const value_type& value) { record.key = value; }
+        static value_type value(const record_type& record) { return record.key; }
+    };
+
+    template <class ContainerT>
+    struct format<ContainerT, false, false>
+    {
+        typedef typename ContainerT::key_type   domain_type;
+        typedef typename ContainerT::data_type  codomain_type;
+        typedef typename ContainerT::value_type value_type;
+        typedef element_pair_record<domain_type, codomain_type> record_type;
+        enum { kind = element_map, codomain_size = sizeof(codomain_type) };
+
+        static void fill(record_type& record, const value_type& value)
+        { record.key = value.KEY_VALUE; record.value = value.CONT_VALUE; }
+        static value_type value(const record_type& record)
+        { return value_type(record.key, record.value); }
+    };
+
+    template <class ContainerT>
+    struct format<ContainerT, true, true>
+    {
+        typedef typename ContainerT::domain_type   domain_type;
+        typedef typename ContainerT::interval_type interval_type;
+        typedef typename ContainerT::value_type    value_type;
+        typedef interval_record<domain_type>       record_type;
+        enum { kind = interval_set, codomain_size = 0 };
+
+        static void fill(record_type& record, const value_type& value) { record.set_interval(value); }
+        static value_type value(const record_type& record) { return record.interval(); }
+        static value_type value(const record_type&, const interval_type& itv) { return itv; }
+    };
+
+    template <class ContainerT>
+    struct format<ContainerT, true, false>
+    {
+        typedef typename ContainerT::domain_type   domain_type;
+        typedef typename ContainerT::codomain_type codomain_type;
+        typedef typename ContainerT::interval_type interval_type;
+        typedef typename ContainerT::value_type    value_type;
+        typedef segment_record<domain_type, codomain_type> record_type;
+        enum { kind = interval_map, codomain_size = sizeof(codomain_type) };
+
+        static void fill(record_type& record, const value_type& value)
+        { record.set_interval(value.KEY_VALUE); record.value = value.CONT_VALUE; }
+        static value_type value(const record_type& record)
+        { return value_type(record.interval(), record.value); }
+        static value_type value(const record_type& record, const interval_type& itv)
+        { return value_type(itv, record.value); }
+    };
+
+    template <class ContainerT>
+    header make_header(boost::uint64_t count)
+    {
+        typedef format<ContainerT> format_type;
+        return make_header(static_cast<container_kind>(format_type::kind),
+                           sizeof(typename format_type::domain_type), format_type::codomain_size,
+                           sizeof(typename format_type::record_type), count);
+    }
+
+} // namespace Snapshot
+
+
+/// Write a snapshot of \c object to the binary \c stream
+/** Returns false, if writing failed. */
+template <class ContainerT>
+bool write_snapshot(std::ostream& stream, const ContainerT& object)
+{
+    typedef Snapshot::format<ContainerT>     format_type;
+    typedef typename format_type::record_type record_type;
+
+    Snapshot::header head = Snapshot::make_header<ContainerT>(
+        std::distance(object.begin(), object.end()));
+    stream.write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+    record_type record;
+    // Padding bytes are cleared, so equal containers yield equal snapshots
+    std::memset(&record, 0, sizeof(record));
+    const_FORALL(typename ContainerT, it_, object)
+    {
+        format_type::fill(record, *it_);
+        stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    return stream.good();
+}
+
+/// Replace the contents of \c object by the snapshot read from the binary \c stream
+/** Returns false, if the stream does not contain a snapshot of the
+    format of \c ContainerT or if reading failed. Segments are appended
+    using hints, so reading takes linear time. */
+template <class ContainerT>
+bool read_snapshot(std::istream& stream, ContainerT& object)
+{
+    typedef Snapshot::format<ContainerT>     format_type;
+    typedef typename format_type::record_type record_type;
+
+    Snapshot::header head;
+    stream.read(reinterpret_cast<char*>(&head), sizeof(head));
+    if(!stream || !Snapshot::matches(head, Snapshot::make_header<ContainerT>(0)))
+        return false;
+
+    object.clear();
+    typename ContainerT::iterator prior_ = object.end();
+    record_type record;
+    for(boost::uint64_t idx = 0; idx < head.count; idx++)
+    {
+        stream.read(reinterpret_cast<char*>(&record), sizeof(record));
+        if(!stream)
+            return false;
+        prior_ = object.add(prior_, format_type::value(record));
+    }
+    return true;
+}
+
+
+/// Read only view of a snapshot of a \c ContainerT in memory
+/**
+    A snapshot_view runs queries directly on the records of a snapshot,
+    e.g. of a mapped_file, without building a container. Attaching a view
+    takes constant time and mapped snapshots share their pages between
+    processes. Records are found by binary search, so \c find and
+    \c contains take O(log n).
+
+    The bounds of the memory must stay valid while the view is used.
+
+    @author Joachim Faulhaber
+*/
+template <class ContainerT>
+class snapshot_view
+{
+public:
+    typedef Snapshot::format<ContainerT>          format_type;
+    typedef typename format_type::domain_type     domain_type;
+    typedef typename format_type::value_type      value_type;
+    typedef typename format_type::record_type     record_type;
+    typedef itl::interval<domain_type>            interval_type;
+    typedef const record_type*                    const_iterator;
+
+    snapshot_view(): _begin(0), _end(0) {}
+    snapshot_view(const void* data, std::size_t size): _begin(0), _end(0) { attach(data, size); }
+
+    /// View the snapshot at \c data; false, if it is not a snapshot of a \c ContainerT
+    bool attach(const void* data, std::size_t size)
+    {
+        _begin = _end = 0;
+        if(data == 0 || size < sizeof(Snapshot::header)
+           || reinterpret_cast<std::size_t>(data) % boost::alignment_of<record_type>::value != 0)
+            return false;
+
+        Snapshot::header head;
+        std::memcpy(&head, data, sizeof(head));
+        if(!Snapshot::matches(head, Snapshot::make_header<ContainerT>(0))
+           || (size - sizeof(head)) / sizeof(record_type) < head.count)
+            return false;
+
+        _begin = reinterpret_cast<const record_type*>(static_cast<const char*>(data) + sizeof(head));
+        _end   = _begin + head.count;
+        return true;
+    }
+
+    bool is_attached()const { return _begin != 0; }
+
+    const_iterator begin()const { return _begin; }
+    const_iterator end()const   { return _end; }
+
+    bool empty()const { return _begin == _end; }
+
+    /// Number of records: Segments of interval containers or elements
+    std::size_t iterative_size()const { return _end - _begin; }
+
+    /// The record that contains \c x or end()
+    const_iterator find(const domain_type& x)const
+    {
+        const_iterator it_ = std::lower_bound(_begin, _end, x, precedes());
+        return it_ != _end && (*it_).holds(x) ? it_ : _end;
+    }
+
+    bool contains(const domain_type& x)const { return find(x) != _end; }
+
+    /// The element or segment of the record
+    static value_type value(const_iterator it_) { return format_type::value(*it_); }
+
+    /** @name Intersection of interval container snapshots */
+    //@{
+    /// First segment that is not exclusively less than \c itv
+    const_iterator lower_bound(const interval_type& itv)const
+    { return std::lower_bound(_begin, _end, itv, exclusive_less()); }
+
+    /// First segment that \c itv is exclusively less than
+    const_iterator upper_bound(const interval_type& itv)const
+    { return std::upper_bound(_begin, _end, itv, exclusive_less()); }
+
+    /// Add the intersection of the snapshot with \c itv to \c section
+    void add_intersection(ContainerT& section, const interval_type& itv)const
+    {
+        typename ContainerT::iterator prior_ = section.end();
+        interval_type common;
+        for(const_iterator it_ = lower_bound(itv); it_ != _end && !itv.exclusive_less((*it_).interval()); ++it_)
+        {
+            (*it_).interval().intersect(common, itv);
+            prior_ = section.add(prior_, format_type::value(*it_, common));
+        }
+    }
+    //@}
+
+private:
+    struct precedes
+    {
+        bool operator()(const record_type& record, const domain_type& x)const
+        { return record.precedes(x); }
+    };
+
+    struct exclusive_less
+    {
+        bool operator()(const record_type& record, const interval_type& itv)const
+        { return record.interval().exclusive_less(itv); }
+        bool operator()(const interval_type& itv, const record_type& record)const
+        { return itv.exclusive_less(record.interval()); }
+    };
+
+    const record_type* _begin;
+    const record_type* _end;
+};
+
+}} // namespace itl boost
+
+#endif
+
+
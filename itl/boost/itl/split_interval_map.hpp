@@ -37,6 +37,7 @@ class split_interval_map
 #include <boost/itl/interval_set.hpp>
 #include <boost/itl/interval_map.hpp>
 #include <boost/itl/interval_base_map.hpp>
+#include <boost/itl/interval_rewrite.hpp>
 #include <boost/itl/interval_maps.hpp>
 #include <boost/itl/split_interval_set.hpp>
 
@@ -215,27 +216,6 @@ namespace boost{namespace itl
         
         //TESTCODE
         void getResiduals(const interval_type& x_itv, interval_type& leftResid, interval_type& rightResid);
-
-    private:
-
-        void fill(const value_type&);
-
-        template<template<class>class Combinator>
-        void fill_gap(const value_type&);
-
-        template<template<class>class Combinator>
-        void add_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it);
-
-        template<template<class>class Combinator>
-        void add_rear(const interval_type& x_itv, const CodomainT& x_val, iterator& it);
-
-        template<template<class>class Combinator>
-        void subtract_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it);
-
-        void insert_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it);
-        void insert_rear(const interval_type& x_itv, const CodomainT& x_val, iterator& it);
-
-        void erase_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it);
     } ;
 
 
@@ -283,42 +263,6 @@ namespace boost{namespace itl
     }
 
 
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::fill(const value_type& value)
-{
-    //collision free insert is asserted
-    if(value.KEY_VALUE.empty())
-        return;
-    if(Traits::absorbs_neutrons && value.CONT_VALUE == CodomainT())
-        return;
-    this->_map.insert(value);
-}
-
-template <typename DomainT, typename CodomainT, class Traits,
-          template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::fill_gap(const value_type& value)
-{
-    static Combinator<CodomainT> combine;
-    //collision free insert is asserted
-    if(value.KEY_VALUE.empty())
-        return;
-    if(Traits::absorbs_neutrons && value.CONT_VALUE == CodomainT())
-        return;
-
-    if(Traits::emits_neutrons)
-    {
-        CodomainT added_val = CodomainT();
-        combine(added_val, value.CONT_VALUE);
-        this->_map.insert(value_type(value.KEY_VALUE, added_val));
-    }
-    else
-        this->_map.insert(value);
-}
-
 //-----------------------------------------------------------------------------
 // add<Combinator>(pair(interval,value)):
 //-----------------------------------------------------------------------------
@@ -327,148 +271,9 @@ template <typename DomainT, typename CodomainT, class Traits, template<class>cla
 void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
     ::add_(const value_type& x)
 {
-    static Combinator<CodomainT> combine;
-    const interval_type& x_itv = x.KEY_VALUE;
-
-    if(x_itv.empty()) 
-        return;
-
-    const CodomainT& x_val = x.CONT_VALUE;
-    if(Traits::absorbs_neutrons && x_val==CodomainT()) 
-        return;
-
-    std::pair<iterator,bool> insertion;
-    if(Traits::emits_neutrons)
-    {
-        CodomainT added_val = CodomainT();
-        combine(added_val, x_val);
-        insertion = this->_map.insert(value_type(x_itv, added_val));
-    }
-    else
-        insertion = this->_map.insert(x);
-
-    if(!insertion.WAS_SUCCESSFUL)
-    {
-        // Detect the first and the end iterator of the collision sequence
-        iterator fst_it = this->_map.lower_bound(x_itv);
-        iterator end_it = insertion.ITERATOR;
-        if(end_it != this->_map.end())
-            end_it++; 
-        //assert(end_it == this->_map.upper_bound(x_itv));
-
-        interval_type fst_itv = (*fst_it).KEY_VALUE ;
-        CodomainT cur_val     = (*fst_it).CONT_VALUE ;
-
-
-        interval_type leadGap; x_itv.left_surplus(leadGap, fst_itv);
-        // this is a new Interval that is a gap in the current map
-        fill_gap<Combinator>(value_type(leadGap, x_val));
-
-        // only for the first there can be a leftResid: a part of *it left of x
-        interval_type leftResid;  fst_itv.left_surplus(leftResid, x_itv);
-
-        // handle special case for first
-
-        interval_type interSec;
-        fst_itv.intersect(interSec, x_itv);
-
-        CodomainT cmb_val = cur_val;
-        combine(cmb_val, x_val);
-
-        iterator snd_it = fst_it; snd_it++;
-        if(snd_it == end_it) 
-        {
-            // first == last
-
-            interval_type endGap; x_itv.right_surplus(endGap, fst_itv);
-            // this is a new Interval that is a gap in the current map
-            fill_gap<Combinator>(value_type(endGap, x_val));
-
-            // only for the last there can be a rightResid: a part of *it right of x
-            interval_type rightResid;  (*fst_it).KEY_VALUE.right_surplus(rightResid, x_itv);
-
-            this->_map.erase(fst_it);
-            fill(value_type(leftResid,  cur_val));
-            fill(value_type(interSec,   cmb_val));
-            fill(value_type(rightResid, cur_val));
-        }
-        else
-        {
-            this->_map.erase(fst_it);
-            fill(value_type(leftResid, cur_val));
-            fill(value_type(interSec,  cmb_val));
-
-            // shrink interval
-            interval_type x_rest(x_itv);
-            x_rest.left_subtract(fst_itv);
-
-            add_rest<Combinator>(x_rest, x_val, snd_it, end_it);
-        }
-    }
-}
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::add_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it)
-{
-    static Combinator<CodomainT> combine;
-    iterator nxt_it = it; nxt_it++;
-    interval_type x_rest = x_itv, gap, common, cur_itv;
-
-    while(nxt_it!=end_it)
-    {
-        cur_itv = (*it).KEY_VALUE ;            
-        x_rest.left_surplus(gap, cur_itv);
-
-        combine(it->CONT_VALUE, x_val);
-        fill_gap<Combinator>(value_type(gap, x_val));
-
-        if(Traits::absorbs_neutrons && it->CONT_VALUE == CodomainT())
-            this->_map.erase(it++);
-        else it++;
-
-        // shrink interval
-        x_rest.left_subtract(cur_itv);
-        nxt_it++;
-    }
-
-    add_rear<Combinator>(x_rest, x_val, it);
-}
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::add_rear(const interval_type& x_rest, const CodomainT& x_val, iterator& it)
-{
-    static Combinator<CodomainT> combine;
-    interval_type cur_itv = (*it).KEY_VALUE ;
-    CodomainT     cur_val = (*it).CONT_VALUE ;
-
-    interval_type left_gap;
-    x_rest.left_surplus(left_gap, cur_itv);
-    fill_gap<Combinator>(value_type(left_gap, x_val));
-
-    interval_type common;
-    cur_itv.intersect(common, x_rest);
-
-    CodomainT cmb_val = cur_val;
-    combine(cmb_val, x_val);
-
-    interval_type end_gap; 
-    x_rest.right_surplus(end_gap, cur_itv);
-    fill_gap<Combinator>(value_type(end_gap, x_val));
-
-    // only for the last there can be a rightResid: a part of *it right of x
-    interval_type right_resid;  
-    cur_itv.right_surplus(right_resid, x_rest);
-
-    this->_map.erase(it);
-    fill(value_type(common,   cmb_val));
-    fill(value_type(right_resid, cur_val));
+    Rewrite::add<Combinator>(this->_map, x.KEY_VALUE, x.CONT_VALUE, false);
 }
 
-
 //-----------------------------------------------------------------------------
 // subtract<Combinator>(pair(interval,value)):
 //-----------------------------------------------------------------------------
@@ -477,106 +282,7 @@ template <typename DomainT, typename CodomainT, class Traits, template<class>cla
 void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
     ::subtract_(const value_type& x)
 {
-    static Combinator<CodomainT> combine;
-    const interval_type& x_itv = x.KEY_VALUE;
-
-    if(x_itv.empty()) 
-        return;
-
-    const CodomainT& x_val = x.CONT_VALUE;
-    if(Traits::absorbs_neutrons && x_val==CodomainT()) 
-        return;
-
-    iterator fst_it = this->_map.lower_bound(x_itv);
-    if(fst_it==this->_map.end()) return;
-    iterator end_it = this->_map.upper_bound(x_itv);
-    if(fst_it==end_it) return;
-
-    interval_type fst_itv = (*fst_it).KEY_VALUE ;
-    // must be copies because fst_it will be erased
-    CodomainT fst_val = (*fst_it).CONT_VALUE ;
-
-    // only for the first there can be a leftResid: a part of *it left of x
-    interval_type leftResid;  
-    fst_itv.left_surplus(leftResid, x_itv);
-
-    // handle special case for first
-
-    interval_type interSec;
-    fst_itv.intersect(interSec, x_itv);
-
-    CodomainT cmb_val = fst_val;
-    combine(cmb_val, x_val);
-
-    iterator snd_it = fst_it; snd_it++;
-    if(snd_it == end_it) 
-    {
-        // only for the last there can be a rightResid: a part of *it right of x
-        interval_type rightResid;  (*fst_it).KEY_VALUE.right_surplus(rightResid, x_itv);
-
-        this->_map.erase(fst_it);
-        fill(value_type(leftResid,  fst_val));
-        fill(value_type(interSec,   cmb_val));
-        fill(value_type(rightResid, fst_val));
-    }
-    else
-    {
-        // first AND NOT last
-        this->_map.erase(fst_it);
-        fill(value_type(leftResid, fst_val));
-        fill(value_type(interSec,  cmb_val));
-
-        subtract_rest<Combinator>(x_itv, x_val, snd_it, end_it);
-    }
-}
-
-
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-    template<template<class>class Combinator>
-void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::subtract_rest(const interval_type& x_itv, const CodomainT& x_val, iterator& it, iterator& end_it)
-{
-    static Combinator<CodomainT> combine;
-    iterator nxt_it=it; nxt_it++;
-
-    while(nxt_it!=end_it)
-    {
-        CodomainT& cur_val = (*it).CONT_VALUE ;
-        combine(cur_val, x_val);
-
-        if(Traits::absorbs_neutrons && cur_val==CodomainT())
-            this->_map.erase(it++); 
-        else it++;
-
-        nxt_it=it; nxt_it++;
-    }
-
-    // it refers the last overlaying intervals of x_itv
-    const interval_type& cur_itv = (*it).KEY_VALUE ;
-
-    interval_type rightResid; 
-    cur_itv.right_surplus(rightResid, x_itv);
-
-    if(rightResid.empty())
-    {
-        CodomainT& cur_val = (*it).CONT_VALUE ;
-        combine(cur_val, x_val);
-        if(Traits::absorbs_neutrons && cur_val==CodomainT())
-            this->_map.erase(it);
-    }
-    else
-    {
-        CodomainT cur_val = (*it).CONT_VALUE ;
-        CodomainT cmb_val = cur_val ;
-        combine(cmb_val, x_val);
-        interval_type interSec; 
-        cur_itv.intersect(interSec, x_itv);
-
-        this->_map.erase(it);
-        fill(value_type(interSec, cmb_val));
-        fill(value_type(rightResid, cur_val));
-    }
+    Rewrite::subtract<Combinator>(this->_map, x.KEY_VALUE, x.CONT_VALUE, false);
 }
 
 
@@ -589,97 +295,7 @@ template <typename DomainT, typename CodomainT, class Traits, template<class>cla
 void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
     ::insert_(const value_type& x)
 {
-    const interval_type& x_itv = x.KEY_VALUE;
-    if(x_itv.empty()) 
-        return;
-
-    const CodomainT& x_val = x.CONT_VALUE;
-    if(Traits::absorbs_neutrons && x_val==CodomainT()) 
-        return;
-
-    std::pair<typename ImplMapT::iterator,bool> 
-        insertion = this->_map.insert(x);
-
-    if(!insertion.WAS_SUCCESSFUL)
-    {
-        // Detect the first and the end iterator of the collision sequence
-        iterator fst_it = this->_map.lower_bound(x_itv);
-        iterator end_it = insertion.ITERATOR;
-        if(end_it != this->_map.end())
-            end_it++; 
-        //assert(end_it == this->_map.upper_bound(x_itv));
-        interval_type fst_itv = (*fst_it).KEY_VALUE ;
-
-        interval_type leadGap; x_itv.left_surplus(leadGap, fst_itv);
-        // this is a new Interval that is a gap in the current map
-        fill_gap<inplace_plus>(value_type(leadGap, x_val));
-
-        // only for the first there can be a leftResid: a part of *it left of x
-        interval_type leftResid;  fst_itv.left_surplus(leftResid, x_itv);
-
-        // handle special case for first
-
-        interval_type interSec;
-        fst_itv.intersect(interSec, x_itv);
-
-        iterator snd_it = fst_it; snd_it++;
-        if(snd_it == end_it) 
-        {
-            interval_type endGap; x_itv.right_surplus(endGap, fst_itv);
-            // this is a new Interval that is a gap in the current map
-            fill_gap<inplace_plus>(value_type(endGap, x_val));
-        }
-        else
-        {
-            // shrink interval
-            interval_type x_rest(x_itv);
-            x_rest.left_subtract(fst_itv);
-
-            insert_rest(x_rest, x_val, snd_it, end_it);
-        }
-    }
-}
-
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, 
-          template<class>class Compare, template<class>class Alloc>
-void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::insert_rest(const interval_type& x_itv, const CodomainT& x_val, 
-                  iterator& it, iterator& end_it)
-{
-    iterator nxt_it = it; nxt_it++;
-    interval_type x_rest = x_itv, gap, common, cur_itv;
-
-    for(; nxt_it!=end_it; ++it, ++nxt_it)
-    {
-        cur_itv = (*it).KEY_VALUE ;            
-        x_rest.left_surplus(gap, cur_itv);
-        fill_gap<inplace_plus>(value_type(gap, x_val));
-        // shrink interval
-        x_rest.left_subtract(cur_itv);
-    }
-
-    insert_rear(x_rest, x_val, it);
-}
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, 
-          template<class>class Compare, template<class>class Alloc>
-void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::insert_rear(const interval_type& x_rest, const CodomainT& x_val, 
-                  iterator& it)
-{
-    interval_type cur_itv = (*it).KEY_VALUE ;
-
-    interval_type left_gap;
-    x_rest.left_surplus(left_gap, cur_itv);
-    fill_gap<inplace_plus>(value_type(left_gap, x_val));
-
-    interval_type common;
-    cur_itv.intersect(common, x_rest);
-
-    interval_type end_gap; 
-    x_rest.right_surplus(end_gap, cur_itv);
-    fill_gap<inplace_plus>(value_type(end_gap, x_val));
+    Rewrite::insert(this->_map, x.KEY_VALUE, x.CONT_VALUE, false);
 }
 
 
@@ -690,103 +306,7 @@ template <typename DomainT, typename CodomainT, class Traits, template<class>cla
 void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
     ::erase_(const value_type& x)
 {
-    const interval_type& x_itv = x.KEY_VALUE;
-    if(x_itv.empty()) 
-        return;
-
-    const CodomainT& x_val = x.CONT_VALUE;
-    if(Traits::absorbs_neutrons && x_val==CodomainT()) 
-        return;
-
-    iterator fst_it = this->_map.lower_bound(x_itv);
-    if(fst_it==this->_map.end()) return;
-    iterator end_it = this->_map.upper_bound(x_itv);
-    if(fst_it==end_it) return;
-
-    interval_type fst_itv = (*fst_it).KEY_VALUE ;
-    // must be copies because fst_it will be erased
-    CodomainT fst_val = (*fst_it).CONT_VALUE ;
-
-    // only for the first there can be a leftResid: a part of *it left of x
-    interval_type leftResid;  
-    fst_itv.left_surplus(leftResid, x_itv);
-
-    // handle special case for first
-
-    interval_type interSec;
-    fst_itv.intersect(interSec, x_itv);
-
-    iterator snd_it = fst_it; snd_it++;
-    if(snd_it == end_it) 
-    {
-        // only for the last there can be a rightResid: a part of *it right of x
-        interval_type rightResid;  (*fst_it).KEY_VALUE.right_surplus(rightResid, x_itv);
-
-        if(!interSec.empty() && fst_val == x_val)
-        {
-            this->_map.erase(fst_it);
-            fill(value_type(leftResid,  fst_val));
-            // erased: fill(value_type(interSec,  cmb_val));
-            fill(value_type(rightResid, fst_val));
-        }
-    }
-    else
-    {
-        // first AND NOT last
-        if(!interSec.empty() && fst_val == x_val)
-        {
-            this->_map.erase(fst_it);
-            fill(value_type(leftResid, fst_val));
-            // erased: fill(value_type(interSec,  cmb_val));
-        }
-
-        erase_rest(x_itv, x_val, snd_it, end_it);
-    }
-}
-
-
-template <typename DomainT, typename CodomainT, class Traits, template<class>class Interval, template<class>class Compare, template<class>class Alloc>
-void split_interval_map<DomainT,CodomainT,Traits,Interval,Compare,Alloc>
-    ::erase_rest(const interval_type& x_itv, const CodomainT& x_val, 
-                 iterator& it, iterator& end_it)
-{
-    iterator nxt_it=it; nxt_it++;
-
-    // For all intervals within loop: it->KEY_VALUE are contained_in x_itv
-    while(nxt_it!=end_it)
-    {
-        if((*it).CONT_VALUE == x_val)
-            this->_map.erase(it++); 
-        else it++;
-
-        nxt_it=it; nxt_it++;
-    }
-
-    // it refers the last overlaying intervals of x_itv
-    interval_type cur_itv = (*it).KEY_VALUE ;
-    // Has to be a copy, cause 'it' will be erased
-    CodomainT cur_val = (*it).CONT_VALUE;
-
-    interval_type rightResid; 
-    cur_itv.right_surplus(rightResid, x_itv);
-
-    if(rightResid.empty())
-    {
-        if(cur_val == x_val)
-            this->_map.erase(it);
-    }
-    else
-    {
-        interval_type interSec; 
-        cur_itv.intersect(interSec, x_itv);
-
-        if(!interSec.empty() && cur_val == x_val)
-        {
-            this->_map.erase(it);
-            //erased: fill(value_type(interSec, cmb_val));
-            fill(value_type(rightResid, cur_val));
-        }
-    }
+    Rewrite::erase(this->_map, x.KEY_VALUE, x.CONT_VALUE, false);
 }
 
 
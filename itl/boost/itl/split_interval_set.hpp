@@ -132,7 +132,7 @@ namespace boost{namespace itl
         typedef typename itl::set<DomainT,Compare,Alloc> atomized_type;
 
         /// Container type for the implementation 
-        typedef typename itl::set<interval_type,exclusive_less,Alloc> ImplSetT;
+        typedef typename base_type::ImplSetT ImplSetT;
 
         /// key type of the implementing container
         typedef typename ImplSetT::key_type   key_type;
@@ -237,11 +237,15 @@ namespace boost{namespace itl
         if(x.empty()) return;
 
         std::pair<typename ImplSetT::iterator,bool> insertion = this->_set.insert(x);
+        ITL_COUNT(search);
+        ITL_COUNT_IF(insertion.WAS_SUCCESSFUL, allocation);
 
         if(!insertion.WAS_SUCCESSFUL)
         {
             iterator fst_it = this->_set.lower_bound(x);
             iterator end_it = this->_set.upper_bound(x);
+            ITL_COUNT(search);
+            ITL_COUNT(search);
 
             if(fst_it == this->_set.end())
                 fst_it = end_it;
@@ -255,6 +259,8 @@ namespace boost{namespace itl
 
             // only for the first there can be a leftResid: a part of *it left of x
             interval_type leftResid;  cur_itv.left_surplus(leftResid, x);
+            ITL_COUNT(visit);
+            ITL_COUNT_IF(!leftResid.empty(), split);
 
             // handle special case for first
             interval_type interSec;
@@ -271,6 +277,7 @@ namespace boost{namespace itl
 
                 // only for the last there can be a rightResid: a part of *it right of x
                 interval_type rightResid;  (*cur_it).right_surplus(rightResid, x);
+                ITL_COUNT_IF(!rightResid.empty(), split);
 
                 this->_set.erase(cur_it);
                 add_(leftResid);
@@ -299,6 +306,7 @@ namespace boost{namespace itl
         iterator nxt_it = it; nxt_it++;
 
         interval_type cur_itv = *it;
+        ITL_COUNT(visit);
         
         interval_type newGap; x_itv.left_surplus(newGap, cur_itv);
         // this is a new Interval that is a gap in the current map
@@ -315,6 +323,7 @@ namespace boost{namespace itl
 
             // only for the last there can be a rightResid: a part of *it right of x
             interval_type rightResid;  cur_itv.right_surplus(rightResid, x_itv);
+            ITL_COUNT_IF(!rightResid.empty(), split);
 
             this->_set.erase(it);
             add_(interSec);
@@ -346,10 +355,14 @@ namespace boost{namespace itl
         if(x.lower() < this->_set.begin()->upper())
             fst_it = this->_set.begin();
         else
+        {
             fst_it = this->_set.lower_bound(x);
+            ITL_COUNT(search);
+        }
 
         if(fst_it==this->_set.end()) return;
         iterator end_it = this->_set.upper_bound(x);
+        ITL_COUNT(search);
         if(fst_it==end_it) return;
 
         iterator cur_it = fst_it ;
@@ -357,6 +370,8 @@ namespace boost{namespace itl
 
         // only for the first there can be a leftResid: a part of *it left of x
         interval_type leftResid;  cur_itv.left_surplus(leftResid, x);
+        ITL_COUNT(visit);
+        ITL_COUNT_IF(!leftResid.empty(), split);
 
         // handle special case for first
         interval_type interSec;
@@ -368,6 +383,7 @@ namespace boost{namespace itl
             // first == last
             // only for the last there can be a rightResid: a part of *it right of x
             interval_type rightResid;  (*cur_it).right_surplus(rightResid, x);
+            ITL_COUNT_IF(!rightResid.empty(), split);
 
             this->_set.erase(cur_it);
             add_(leftResid);
@@ -392,6 +408,7 @@ namespace boost{namespace itl
 
         while(nxt_it!=end_it)
         {
+            ITL_COUNT(visit);
             { iterator victim; victim=it; it++; this->_set.erase(victim); }
             nxt_it=it; nxt_it++;
         }
@@ -400,6 +417,8 @@ namespace boost{namespace itl
         const interval_type&  cur_itv = *it ;
 
         interval_type rightResid; cur_itv.right_surplus(rightResid, x_itv);
+        ITL_COUNT(visit);
+        ITL_COUNT_IF(!rightResid.empty(), split);
 
         if(rightResid.empty())
             this->_set.erase(it);
@@ -407,7 +426,8 @@ namespace boost{namespace itl
         {
             interval_type interSec; cur_itv.intersect(interSec, x_itv);
             this->_set.erase(it);
-            this->_set.insert(rightResid);
+            std::pair<iterator,bool> insertion = this->_set.insert(rightResid);
+            ITL_COUNT_IF(insertion.WAS_SUCCESSFUL, allocation);
         }
     }
 
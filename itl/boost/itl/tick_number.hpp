@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class tick_number
+    Integer encoded domain adapter for boost::posix_time::ptime
+--------------------------------------------------------------------*/
+#ifndef __itl_tick_number_JOFA_081031_H__
+#define __itl_tick_number_JOFA_081031_H__
+
+#include <string>
+#include <ostream>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/itl/type_traits/difference.hpp>
+#include <boost/itl/type_traits/type_to_string.hpp>
+#include <boost/itl/type_traits/domain_conversion.hpp>
+
+namespace boost{namespace itl
+{
+
+/// A point in time, that is represented by the ticks since 1970-01-01 00:00
+/**
+    A tick is the resolution of boost::posix_time::time_duration, which is
+    a microsecond by default. Like day_number for dates, tick_number keeps
+    a 64 bit integer, so intervals of tick_numbers step and compare without
+    the special value checks of ptime. <tt>tick_number(time)</tt>,
+    <tt>x.to_ptime()</tt> and <tt>interval_cast</tt> convert at the
+    boundary of the API.
+
+    Special values like <tt>not_a_date_time</tt> have no tick_number.
+
+    @author Joachim Faulhaber
+*/
+class tick_number
+{
+public:
+    typedef boost::int64_t                  rep_type;
+    typedef boost::int64_t                  difference_type;
+    typedef boost::posix_time::ptime         ptime_type;
+    typedef boost::posix_time::time_duration duration_type;
+
+    tick_number(): _rep(0) {}
+    explicit tick_number(rep_type ticks): _rep(ticks) {}
+
+    /// Implicit conversion from ptimes at the API boundary
+    tick_number(const ptime_type& time): _rep(ticks_since_epoch(time)) {}
+
+    ptime_type to_ptime()const { return epoch() + duration_type(0, 0, 0, _rep); }
+
+    rep_type ticks()const { return _rep; }
+
+    tick_number& operator ++ () { ++_rep; return *this; }
+    tick_number& operator -- () { --_rep; return *this; }
+    tick_number& operator += (rep_type ticks) { _rep += ticks; return *this; }
+    tick_number& operator -= (rep_type ticks) { _rep -= ticks; return *this; }
+
+    /// Ticks per second of the posix_time resolution
+    static rep_type ticks_per_second() { return duration_type::ticks_per_second(); }
+
+    const std::string as_string()const
+    { return boost::posix_time::to_simple_string(to_ptime()); }
+
+private:
+    static ptime_type epoch()
+    { return ptime_type(boost::gregorian::date(1970, 1, 1)); }
+
+    static rep_type ticks_since_epoch(const ptime_type& time)
+    {
+        BOOST_ASSERT(!time.is_special());
+        return (time - epoch()).ticks();
+    }
+
+    rep_type _rep;
+};
+
+inline bool operator == (const tick_number& lhs, const tick_number& rhs) { return lhs.ticks() == rhs.ticks(); }
+inline bool operator != (const tick_number& lhs, const tick_number& rhs) { return lhs.ticks() != rhs.ticks(); }
+inline bool operator <  (const tick_number& lhs, const tick_number& rhs) { return lhs.ticks() <  rhs.ticks(); }
+inline bool operator <= (const tick_number& lhs, const tick_number& rhs) { return lhs.ticks() <= rhs.ticks(); }
+inline bool operator >  (const tick_number& lhs, const tick_number& rhs) { return lhs.ticks() >  rhs.ticks(); }
+inline bool operator >= (const tick_number& lhs, const tick_number& rhs) { return lhs.ticks() >= rhs.ticks(); }
+
+inline tick_number operator + (tick_number lhs, tick_number::rep_type ticks) { return lhs += ticks; }
+inline tick_number operator - (tick_number lhs, tick_number::rep_type ticks) { return lhs -= ticks; }
+
+inline tick_number::rep_type operator - (const tick_number& lhs, const tick_number& rhs)
+{ return lhs.ticks() - rhs.ticks(); }
+
+template<class CharType, class CharTraits>
+std::basic_ostream<CharType, CharTraits>& operator <<
+  (std::basic_ostream<CharType, CharTraits>& stream, const tick_number& x)
+{ return stream << x.to_ptime(); }
+
+
+template<>
+struct difference<tick_number> { typedef tick_number::difference_type type; };
+
+template<>
+struct domain_conversion<boost::posix_time::ptime, tick_number>
+{
+    static boost::posix_time::ptime apply(const tick_number& value){ return value.to_ptime(); }
+};
+
+template<>
+inline std::string type_to_string<tick_number>::apply() { return "tick_number"; }
+
+}} // namespace itl boost
+
+#endif
+
+
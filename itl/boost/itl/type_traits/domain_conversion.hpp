@@ -0,0 +1,26 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#ifndef __itl_type_traits_domain_conversion_JOFA_081031_H__
+#define __itl_type_traits_domain_conversion_JOFA_081031_H__
+
+namespace boost{ namespace itl
+{
+    /// Conversion of domain values of type \c SourceT into \c TargetT
+    /** Domain adapters that can not be converted by a constructor of
+        \c TargetT specialize this template. */
+    template <class TargetT, class SourceT>
+    struct domain_conversion
+    {
+        static TargetT apply(const SourceT& value){ return TargetT(value); }
+    };
+
+}} // namespace boost itl
+
+#endif
+
+
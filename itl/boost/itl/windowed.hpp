@@ -0,0 +1,144 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------
+class windowed
+    Interval containers that retain a sliding window of their domain
+--------------------------------------------------------------------*/
+#ifndef __itl_windowed_JOFA_081104_H__
+#define __itl_windowed_JOFA_081104_H__
+
+#include <utility>
+#include <boost/itl/interval.hpp>
+
+namespace boost{namespace itl
+{
+
+/// An interval container that keeps the most recent part of its domain only
+/**
+    A <b>windowed</b> container wraps an interval set or map and a window
+    length. The <b>horizon</b> is the greatest upper bound of all operands
+    that were added or inserted, or that the container was advanced to.
+    Elements less than <tt>horizon() - length()</tt> are expired. They are
+    evicted by <tt>truncate_before</tt> whenever the horizon moves, which
+    costs O(log n) plus the number of evicted segments. Since data arrive
+    in ascending order mostly, the container works like a ring buffer of
+    segments over the last <tt>length()</tt> of the time line.
+
+    @author Joachim Faulhaber
+*/
+template <class ContainerT>
+class windowed
+{
+public:
+    typedef ContainerT                                  container_type;
+    typedef typename ContainerT::domain_type            domain_type;
+    typedef typename ContainerT::difference_type        difference_type;
+    typedef typename ContainerT::interval_type          interval_type;
+    typedef typename ContainerT::value_type             value_type;
+    typedef typename ContainerT::size_type              size_type;
+    typedef typename ContainerT::const_iterator         const_iterator;
+
+    explicit windowed(const difference_type& length)
+        : _length(length), _horizon(), _has_horizon(false) {}
+
+    /// The wrapped container
+    const container_type& container()const { return _object; }
+
+    /// Length of the window
+    const difference_type& length()const { return _length; }
+
+    /// Greatest upper bound of all operands; undefined for a fresh container
+    const domain_type& horizon()const { return _horizon; }
+
+    /// Elements less than the expiry have been evicted
+    domain_type expiry()const { return _horizon - _length; }
+
+    const_iterator begin()const { return _object.begin(); }
+    const_iterator end()const   { return _object.end(); }
+
+    bool empty()const { return _object.empty(); }
+    size_type iterative_size()const { return _object.iterative_size(); }
+
+    template <class OperandT>
+    bool contains(const OperandT& x)const { return _object.contains(x); }
+
+    void clear() { _object.clear(); _horizon = domain_type(); _has_horizon = false; }
+
+    /// Move the horizon to \c now, if it is later, and evict expired segments
+    windowed& advance(const domain_type& now)
+    {
+        if(_has_horizon && !(_horizon < now))
+            return *this;
+        _horizon = now;
+        _has_horizon = true;
+        _object.truncate_before(expiry());
+        return *this;
+    }
+
+    /** @name Updates of segments and elements */
+    //@{
+    template <class OperandT>
+    windowed& add(const OperandT& x)
+    {
+        _object.add(x);
+        return advance_to(region_of(x));
+    }
+
+    template <class OperandT>
+    windowed& insert(const OperandT& x)
+    {
+        _object.insert(x);
+        return advance_to(region_of(x));
+    }
+
+    template <class OperandT>
+    windowed& subtract(const OperandT& x) { _object.subtract(x); return *this; }
+
+    template <class OperandT>
+    windowed& erase(const OperandT& x) { _object.erase(x); return *this; }
+
+    template <class OperandT>
+    windowed& operator += (const OperandT& x) { return add(x); }
+
+    template <class OperandT>
+    windowed& operator -= (const OperandT& x) { return subtract(x); }
+    //@}
+
+private:
+    static interval_type region_of(const domain_type& x) { return interval_type(x); }
+    static interval_type region_of(const interval_type& x) { return x; }
+
+    template <class IntervalT, class CodomainT>
+    static interval_type region_of(const std::pair<IntervalT, CodomainT>& x) { return x.first; }
+
+    windowed& advance_to(const interval_type& region)
+    {
+        if(region.empty())
+            return *this;
+        if(_has_horizon && !(_horizon < region.upper()))
+        {
+            // Late operands may reach into the expired part
+            if(region.lower() < expiry())
+                _object.truncate_before(expiry());
+            return *this;
+        }
+        return advance(region.upper());
+    }
+
+private:
+    ContainerT      _object;
+    difference_type _length;
+    domain_type     _horizon;
+    bool            _has_horizon;
+};
+
+}} // namespace itl boost
+
+#endif
+
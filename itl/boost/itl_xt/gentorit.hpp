@@ -50,6 +50,11 @@ public:
 
 template <class TypeTV> class RandomGentorAT : public GentorIT<TypeTV>
 {
+public:
+    /** Random generators draw from the engine of their thread by default.
+        Seeding gives a generator (and the generators it owns) engines of
+        their own, so its values are reproducible independent of others. */
+    virtual void seed(boost::uint64_t seed_value)=0;
 };
 
 }} // namespace itl boost
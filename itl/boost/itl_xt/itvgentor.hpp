@@ -51,6 +51,16 @@ public:
     void setMaxIntervalLength(ItvDomTV len) { m_maxIntervalLength=len; }
     void setProbDerivation();
 
+    void seed(boost::uint64_t seed_value) { m_ItvDomTVGentor.seed(seed_value); }
+
+    /// Batched generation: Fills <tt>[first,last)</tt> with random intervals
+    template<class IteratorT>
+    void some(IteratorT first, IteratorT last)
+    {
+        for(; first != last; ++first)
+            some(*first);
+    }
+
 
 private:
     NumberGentorT<ItvDomTV> m_ItvDomTVGentor;
@@ -63,11 +73,12 @@ private:
 template <class ItvDomTV, class ItvTV>
 void ItvGentorT<ItvDomTV,ItvTV>::some(ItvTV& x)
 {
-    NumberGentorT<unsigned> NATGentor;
+    // Bound types and shape are drawn from the same engine as the bounds
+    xoshiro256& NATGentor = m_ItvDomTVGentor.engine();
     ItvDomTV x1   = m_ItvDomTVGentor(m_valueRange);
-    ITV_BOUNDTYPES bndTypes = NATGentor(4);
-    unsigned upOrDown = NATGentor(1);
-    unsigned decideEmpty = NATGentor(2);
+    ITV_BOUNDTYPES bndTypes = NATGentor.below(4);
+    unsigned upOrDown = NATGentor.below(1);
+    unsigned decideEmpty = NATGentor.below(2);
 
     if(decideEmpty==0)
     {        
@@ -39,6 +39,7 @@ class MapGentorT
 
 #include <boost/itl_xt/list.hpp>
 #include <boost/itl_xt/gentorit.hpp>
+#include <boost/itl_xt/numbergentor.hpp>
 
 namespace boost{namespace itl
 {
@@ -77,22 +78,33 @@ public:
     void setRangeOfSampleSize(const interval<int>& szRange)
     { BOOST_ASSERT(szRange.is_rightopen()); m_sampleSizeRange = szRange; }
 
+    /// Seeds this generator and its (co)domain generators. Call it after calibration.
+    void seed(boost::uint64_t seed_value)
+    {
+        xoshiro256 splitter(seed_value);
+        m_sizeGentor.seed(splitter.split());
+        if(p_domainGentor)
+            p_domainGentor->seed(splitter.split());
+        if(p_codomainGentor)
+            p_codomainGentor->seed(splitter.split());
+    }
+
 private:
     RandomGentorAT<DomainTD>*    p_domainGentor;
     RandomGentorAT<CodomainTD>*  p_codomainGentor;
     interval<int>                m_sampleSizeRange;
     SampleTypeTD                 m_sample;
     int                          m_sampleSize;
+    mutable NumberGentorT<int>   m_sizeGentor;
 };
 
 
 template <class MapTV> 
 void MapGentorT<MapTV>::some(MapTV& x)
 {
-    NumberGentorT<int> intGentor;
     x.clear();
     m_sample.clear();
-    m_sampleSize = intGentor(m_sampleSizeRange);
+    m_sampleSize = m_sizeGentor(m_sampleSizeRange);
 
     for(int i=0; i<m_sampleSize; i++)
     {
@@ -121,10 +133,9 @@ void MapGentorT<MapTV>::last_permuted(MapTV& x)const
 
     SampleTypeTD perm;
 
-    NumberGentorT<int> intGentor;
     const_FORALL(typename SampleTypeTD, it, m_sample)
     {
-        if( 0==intGentor(2) ) perm.push_back(*it);
+        if( 0==m_sizeGentor(2) ) perm.push_back(*it);
         else perm.push_front(*it);
     }
 
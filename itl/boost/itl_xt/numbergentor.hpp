@@ -40,38 +40,54 @@ class NumberGentorT
 
 using namespace boost::itl;
 
-#define RND_1_TO(y)      (1+(int)((double)(y)*rand()/(RAND_MAX+1.0)))
-#define RND_0_TO(y)      ((int)((double)((y)+1)*rand()/(RAND_MAX+1.0)))
-#define RND_WITHIN(x,y) ((x)+(int)((double)((y)-(x)+1)*rand()/(RAND_MAX+1.0)))
+// The RND_* macros draw from the engine of the current thread (see random.hpp)
+#define RND_UNIT()       (boost::itl::rnd_engine().unit())
+
+#define RND_1_TO(y)      (1+(int)((double)(y)*RND_UNIT()))
+#define RND_0_TO(y)      ((int)((double)((y)+1)*RND_UNIT()))
+#define RND_WITHIN(x,y) ((x)+(int)((double)((y)-(x)+1)*RND_UNIT()))
 
 // -----------------------------------------------------------
 
-#define RND_O_TO_EXCL(y) (((double)(y))*rand()/(RAND_MAX+1.0))
+#define RND_O_TO_EXCL(y) (((double)(y))*RND_UNIT())
 
-#define RND_WITHIN_EXUPB(x,y) ((x)+((double)((y)-(x))*rand()/(RAND_MAX+1.0)))
+#define RND_WITHIN_EXUPB(x,y) ((x)+((double)((y)-(x))*RND_UNIT()))
 
 namespace boost{namespace itl
 {
 
+template <class NumTV>
+inline NumTV rnd_0_to_excl(NumTV exclusive_upb, xoshiro256& engine) 
+{ return (NumTV)(((double)exclusive_upb)*engine.unit()); }
+
 template <class NumTV>
 inline NumTV rnd_0_to_excl(NumTV exclusive_upb) 
-{ return (NumTV)RND_O_TO_EXCL(exclusive_upb); }
+{ return rnd_0_to_excl(exclusive_upb, rnd_engine()); }
 
 
 template <class NumTV>
-inline NumTV rnd_within_exUpb(NumTV lwb, NumTV exclusive_upb) 
+inline NumTV rnd_within_exUpb(NumTV lwb, NumTV exclusive_upb, xoshiro256& engine) 
 { 
-    NumTV some = (NumTV)RND_WITHIN_EXUPB(lwb,exclusive_upb); 
+    NumTV some = (NumTV)(lwb + ((double)(exclusive_upb-lwb))*engine.unit()); 
     return some;
 }
 
 template <class NumTV>
-inline NumTV rnd_within(NumTV lwb, NumTV exclusive_upb) 
+inline NumTV rnd_within_exUpb(NumTV lwb, NumTV exclusive_upb) 
+{ return rnd_within_exUpb(lwb, exclusive_upb, rnd_engine()); }
+
+
+template <class NumTV>
+inline NumTV rnd_within(NumTV lwb, NumTV upb, xoshiro256& engine) 
 { 
-    NumTV some = (NumTV)RND_WITHIN(lwb,exclusive_upb); 
+    NumTV some = (NumTV)(lwb + (NumTV)(((double)(upb-lwb+1))*engine.unit())); 
     return some;
 }
 
+template <class NumTV>
+inline NumTV rnd_within(NumTV lwb, NumTV upb) 
+{ return rnd_within(lwb, upb, rnd_engine()); }
+
 template <class NumT>
 class NumberGentorProfile : public RandomGentorProfile<NumT>
 {
@@ -87,17 +103,21 @@ public:
     NumberGentorT(): 
       m_valueRange( NumTV(), unon<NumTV>::value(), interval<NumTV>::RIGHT_OPEN ) {}
 
-    NumTV operator() (NumTV upb) { return rnd_0_to_excl<NumTV>(upb); }
-    NumTV operator() (NumTV lwb, NumTV upb)  { return rnd_within_exUpb<NumTV>(lwb,upb); }
+    NumTV operator() (NumTV upb) { return rnd_0_to_excl<NumTV>(upb, engine()); }
+    NumTV operator() (NumTV lwb, NumTV upb)  { return rnd_within_exUpb<NumTV>(lwb,upb, engine()); }
     NumTV operator() (interval<NumTV> rng) 
     { 
         BOOST_ASSERT(rng.is_rightopen() || rng.is_closed());
         if(rng.is_rightopen())
-            return rnd_within_exUpb<NumTV>(rng.lower(), rng.upper());
+            return rnd_within_exUpb<NumTV>(rng.lower(), rng.upper(), engine());
         else
-            return rnd_within<NumTV>(rng.lower(), rng.upper());
+            return rnd_within<NumTV>(rng.lower(), rng.upper(), engine());
     }
 
+    /// Gives this generator an engine of its own, seeded by \c seed_value
+    void seed(boost::uint64_t seed_value) { m_random.seed(seed_value); }
+    xoshiro256& engine() { return m_random.engine(); }
+
     void setRange(interval<NumTV> rng) { m_valueRange = rng; }
     void setRange(NumTV lwb, NumTV upb) { m_valueRange = rightopen_interval(lwb,upb); } 
 
@@ -108,10 +128,23 @@ public:
 
     void some(NumTV& x) { x = (*this)(m_valueRange); }
 
+    /// Batched generation: Fills <tt>[first,last)</tt> with values of the value range
+    template<class IteratorT>
+    void some(IteratorT first, IteratorT last)
+    {
+        xoshiro256& engine_ = engine();
+        const NumTV lwb = m_valueRange.lower();
+        const double width = static_cast<double>(m_valueRange.upper() - lwb)
+                             + (m_valueRange.is_closed() ? 1.0 : 0.0);
+        for(; first != last; ++first)
+            *first = static_cast<NumTV>(lwb + static_cast<NumTV>(width * engine_.unit()));
+    }
+
     std::string as_string()const { return "NumberGentorT";}
 
 private:
     interval<NumTV> m_valueRange;
+    random          m_random;
 };
 
 // ----------------------------------------------------------------------------
@@ -164,6 +197,8 @@ public:
     int some();
     void some(int& index){ index = some(); }
 
+    void seed(boost::uint64_t seed_value) { _numgentor.seed(seed_value); }
+
     int lower_bound_index(int low, int up, WeightsT val);
 
     bool isRangeValid()const 
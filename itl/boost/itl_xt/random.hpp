@@ -32,24 +32,112 @@ DEALINGS IN THE SOFTWARE.
 #include <functional>
 #include <stdlib.h>
 #include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/tss.hpp>
 #include <boost/itl/interval.hpp>
 
 namespace boost{namespace itl
 {
 
+/** xoshiro256** (Blackman, Vigna): A small and fast generator of 64 bit
+    pseudo random numbers. The 256 bit state is expanded from a 64 bit seed
+    by splitmix64, so every seed, including 0, yields a usable state. */
+class xoshiro256
+{
+public:
+    typedef boost::uint64_t result_type;
+
+    enum { default_seed = 5489 };
+
+    explicit xoshiro256(boost::uint64_t seed_value = default_seed) { seed(seed_value); }
+
+    void seed(boost::uint64_t seed_value)
+    {
+        for(int idx=0; idx<4; idx++)
+        {
+            seed_value += 0x9E3779B97F4A7C15ULL;
+            boost::uint64_t z = seed_value;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            _state[idx] = z ^ (z >> 31);
+        }
+    }
+
+    result_type operator()()
+    {
+        const boost::uint64_t result = rotl(_state[1] * 5, 7) * 9;
+        const boost::uint64_t t = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotl(_state[3], 45);
+        return result;
+    }
+
+    /// Some number in <tt>[0,upb)</tt> by multiply and shift, no division.
+    boost::uint32_t below(boost::uint32_t upb)
+    { return static_cast<boost::uint32_t>(((*this)() >> 32) * upb >> 32); }
+
+    /// Some double in <tt>[0,1)</tt> with 53 significant bits.
+    double unit()
+    { return ((*this)() >> 11) * (1.0/9007199254740992.0); }
+
+    /// Batched generation: Fills <tt>[first,last)</tt> with numbers in <tt>[0,upb)</tt>.
+    template<class IteratorT>
+    void fill(IteratorT first, IteratorT last, boost::uint32_t upb)
+    {
+        for(; first != last; ++first)
+            *first = below(upb);
+    }
+
+    /// A seed for a subordinate generator, that depends on this generator's seed only.
+    boost::uint64_t split() { return (*this)(); }
+
+private:
+    static boost::uint64_t rotl(boost::uint64_t x, int k)
+    { return (x << k) | (x >> (64 - k)); }
+
+private:
+    boost::uint64_t _state[4];
+};
+
+
+/** The engine of the current thread. All generators that are not seeded
+    explicitly draw from this engine, so no state is shared between threads. */
+inline xoshiro256& rnd_engine()
+{
+    static boost::thread_specific_ptr<xoshiro256> engine;
+    if(engine.get() == NULL)
+        engine.reset(new xoshiro256);
+    return *engine;
+}
+
+/// Seeds the engine of the current thread. Equal seeds reproduce equal runs.
+inline void rnd_seed(boost::uint64_t seed_value)
+{ rnd_engine().seed(seed_value); }
+
+
+/** class random draws from the engine of its thread, unless it is seeded. 
+    A seeded random owns an engine of its own. */
 class random
 {
 public:
-    //JODO subtractive_rng random generator is only an sgi extension of std-lib
-    //unsigned rnd(unsigned upb) { return m_random(upb); };
-    
+    random(): _seeded(false) {}
+    explicit random(boost::uint64_t seed_value): _seeded(true), _engine(seed_value) {}
+
+    void seed(boost::uint64_t seed_value) { _seeded = true; _engine.seed(seed_value); }
+    bool is_seeded()const { return _seeded; }
+
+    xoshiro256& engine() { return _seeded ? _engine : rnd_engine(); }
+
+    /// Some number in <tt>[0,upb)</tt>
     unsigned rnd(unsigned upb) 
     {
-        return static_cast<int>(upb * (::rand() / static_cast<double>(RAND_MAX)));
-        //JODO return m_random(upb); 
+        return engine().below(upb);
     };
 
-
     unsigned rnd(unsigned lwb, unsigned upb)
     {
         BOOST_ASSERT(0<=lwb && lwb <= upb);
@@ -62,10 +150,10 @@ public:
     { BOOST_ASSERT( rng.is_rightopen() ); return rnd(rng.lower(),rng.upper()); }
 
 private:
-    //JODO subtractive_rng m_random;
+    bool       _seeded;
+    xoshiro256 _engine;
 };
 
 }} // namespace itl boost
 
 #endif
-
@@ -33,6 +33,7 @@ class SeqGentorT
 #define __SeqGentorT_H_JOFA_000724__
 
 #include <boost/itl_xt/gentorit.hpp>
+#include <boost/itl_xt/numbergentor.hpp>
 #include <boost/itl_xt/list.hpp>
 
 namespace boost{namespace itl
@@ -60,22 +61,31 @@ public:
 
     void setUnique(bool truth) { m_unique = truth; }
 
+    /// Seeds this generator and its domain generator. Call it after setDomainGentor.
+    void seed(boost::uint64_t seed_value)
+    {
+        xoshiro256 splitter(seed_value);
+        m_sizeGentor.seed(splitter.split());
+        if(m_domainGentor)
+            m_domainGentor->seed(splitter.split());
+    }
+
 private:
     RandomGentorAT<DomainTD>*    m_domainGentor;
     interval<int>                m_sampleSizeRange;
     SampleTypeTD                m_sample;
     int                            m_sampleSize;
     bool                        m_unique;
+    mutable NumberGentorT<int>  m_sizeGentor;
 };
 
 
 template <class SeqTV> 
 void SeqGentorT<SeqTV>::some(SeqTV& x)
 {
-    NumberGentorT<int> intGentor;
     x.clear();
     m_sample.clear();
-    m_sampleSize = intGentor(m_sampleSizeRange);
+    m_sampleSize = m_sizeGentor(m_sampleSizeRange);
 
     for(int i=0; i<m_sampleSize; i++)
     {
@@ -109,10 +119,9 @@ void SeqGentorT<SeqTV>::last_permuted(SeqTV& x)const
 
     SampleTypeTD perm;
 
-    NumberGentorT<int> intGentor;
     const_FORALL(typename SampleTypeTD, it, m_sample)
     {
-        if( 0==intGentor(2) ) perm.push_back(*it);
+        if( 0==m_sizeGentor(2) ) perm.push_back(*it);
         else perm.push_front(*it);
     }
 
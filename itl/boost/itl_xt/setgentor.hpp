@@ -70,21 +70,30 @@ public:
 
     DomainGentorPT domainGentor()const { return p_domainGentor; } 
 
+    /// Seeds this generator and its domain generator. Call it after setDomainGentor.
+    void seed(boost::uint64_t seed_value)
+    {
+        xoshiro256 splitter(seed_value);
+        m_sizeGentor.seed(splitter.split());
+        if(p_domainGentor)
+            p_domainGentor->seed(splitter.split());
+    }
+
 private:
     RandomGentorAT<DomainTD>*  p_domainGentor;
     interval<int>              m_sampleSizeRange;
     SampleTypeTD               m_sample;
     int                        m_sampleSize;
+    mutable NumberGentorT<int> m_sizeGentor;
 };
 
 
 template <class SetTV> 
 void SetGentorT<SetTV>::some(SetTV& x)
 {
-    NumberGentorT<int> intGentor;
     x.clear();
     m_sample.clear();
-    m_sampleSize = intGentor(m_sampleSizeRange);
+    m_sampleSize = m_sizeGentor(m_sampleSizeRange);
 
     for(int i=0; i<m_sampleSize; i++)
     {
@@ -111,10 +120,9 @@ void SetGentorT<SetTV>::last_permuted(SetTV& x)const
 
     SampleTypeTD perm;
 
-    NumberGentorT<int> intGentor;
     const_FORALL(typename SampleTypeTD, it, m_sample)
     {
-        if( 0==intGentor(2) ) perm.push_back(*it);
+        if( 0==m_sizeGentor(2) ) perm.push_back(*it);
         else perm.push_front(*it);
     }
 
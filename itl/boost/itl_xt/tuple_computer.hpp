@@ -358,7 +358,7 @@ namespace boost{namespace itl
         void alignFor(const tuple_set_type& domain)
         {
             const_FORALL(typename tuple_set_type, it_, domain)
-                insert(*it_, counter_type());
+                this->insert(*it_, counter_type());
         }
 
     };
@@ -368,7 +368,7 @@ namespace boost{namespace itl
     {
         const date_tuple_computer& src = dynamic_cast<const date_tuple_computer&>(srcI);
         const_FORALL(typename date_tuple_computer, it_, src)
-            insert(*it_);
+            this->insert(*it_);
     }
 
 
@@ -417,7 +417,7 @@ namespace boost{namespace itl
         void alignFor(const tuple_set_type& domain)
         {
             const_FORALL(typename tuple_set_type, it_, domain)
-                insert(*it_, counter_type());
+                this->insert(*it_, counter_type());
         }
     };
 
@@ -427,7 +427,7 @@ namespace boost{namespace itl
     {
         const interval_tuple_computer& src = dynamic_cast<const interval_tuple_computer&>(srcI);
         const_FORALL(typename interval_tuple_computer, it_, src)
-            insert(*it_);
+            this->insert(*it_);
     }
 
     template <int VarCount, class TimeT, class CounteeT>
@@ -437,14 +437,14 @@ namespace boost{namespace itl
         const_FORALL(typename DateMapTD, date_, date)
         {
             itvCounter.insert(
-                counter_type::value_type(
-                    counter_type::interval_type((*date_).KEY_VALUE, (*date_).KEY_VALUE), 
+                typename counter_type::value_type(
+                    typename counter_type::interval_type((*date_).KEY_VALUE, (*date_).KEY_VALUE), 
                     (*date_).CONT_VALUE
                     )
                 );
         }
 
-        insert(value_type(tup, itvCounter));
+        this->insert(typename base_type::value_type(tup, itvCounter));
     }
 
 
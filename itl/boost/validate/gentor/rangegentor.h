@@ -33,6 +33,7 @@ class IntevalGentor
 
 #include <boost/itl/interval.hpp>
 #include <boost/itl_xt/gentorit.hpp>
+#include <boost/itl_xt/numbergentor.hpp>
 
 namespace boost{namespace itl
 {
@@ -56,6 +57,13 @@ namespace boost{namespace itl
         void setUpperBoundRange(const interval<int>& range)
         { BOOST_ASSERT(range.is_rightopen()||range.is_closed()); _upbGentor.setRange(range); }
 
+        void seed(boost::uint64_t seed_value)
+        {
+            xoshiro256 splitter(seed_value);
+            _lwbGentor.seed(splitter.split());
+            _upbGentor.seed(splitter.split());
+        }
+
     private:
         NumberGentorT<Type>   _lwbGentor;
         NumberGentorT<Type>   _upbGentor;
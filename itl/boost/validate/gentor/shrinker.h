@@ -0,0 +1,175 @@
+/*----------------------------------------------------------------------------+
+A Law Based Test Automaton 'LaBatea'
+Author: Joachim Faulhaber
+Copyright (c) 2007-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <boost/itl/interval.hpp>
+#include <boost/itl/set.hpp>
+#include <boost/itl/map.hpp>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/separate_interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+
+namespace boost{namespace itl
+{
+    // ------------------------------------------------------------------------
+    // class template Shrinker:
+    // Shrinker<Type>::candidates(value, smaller) appends values to 'smaller'
+    // that are simpler than 'value'. Candidates are ordered: The ones that
+    // simplify most come first. A value that can not be simplified any
+    // further has no candidates. Shrinkers are used to minimize counter
+    // examples of law violations (see LawShrinker).
+    // ------------------------------------------------------------------------
+
+    // ----- numbers: zero, half the value, one step towards zero -------------
+    template <class Type> struct Shrinker
+    {
+        static void candidates(const Type& value, std::vector<Type>& smaller)
+        {
+            if(value == Type())
+                return;
+            smaller.push_back(Type());
+
+            Type half = static_cast<Type>(value / 2);
+            if(half != Type() && half != value)
+                smaller.push_back(half);
+
+            Type step = value < Type() ? static_cast<Type>(value + 1)
+                                       : static_cast<Type>(value - 1);
+            if((step < Type() ? -step : step) < (value < Type() ? -value : value)
+                && step != half && step != Type())
+                smaller.push_back(step);
+        }
+    };
+
+    // ----- intervals: narrowed to their left or right half -----------------
+    template <class DomainT> struct Shrinker<interval<DomainT> >
+    {
+        static void candidates(const interval<DomainT>& value, std::vector<interval<DomainT> >& smaller)
+        {
+            if(value.empty())
+                return;
+
+            DomainT mid = static_cast<DomainT>(value.lower() + (value.upper() - value.lower()) / 2);
+            interval<DomainT> left_half (value.lower(), mid, value.boundtypes());
+            interval<DomainT> right_half(mid, value.upper(), value.boundtypes());
+
+            if(!left_half.empty() && !(left_half == value))
+                smaller.push_back(left_half);
+            if(!right_half.empty() && !(right_half == value))
+                smaller.push_back(right_half);
+        }
+    };
+
+    // ----- sets: drop an element, shrink an element -------------------------
+    template <class SetT> struct SetShrinker
+    {
+        typedef typename SetT::key_type element_type;
+
+        static void candidates(const SetT& value, std::vector<SetT>& smaller)
+        {
+            const_FORALL(typename SetT, it, value)
+            {
+                SetT dropped = value;
+                dropped.erase(*it);
+                smaller.push_back(dropped);
+            }
+
+            const_FORALL(typename SetT, it, value)
+            {
+                std::vector<element_type> elements;
+                Shrinker<element_type>::candidates(*it, elements);
+                for(typename std::vector<element_type>::size_type idx = 0; idx < elements.size(); idx++)
+                {
+                    SetT shrunk = value;
+                    shrunk.erase(*it);
+                    shrunk.insert(elements[idx]);
+                    smaller.push_back(shrunk);
+                }
+            }
+        }
+    };
+
+    // ----- maps: drop a pair, shrink a key, shrink an associated value ------
+    template <class MapT> struct MapShrinker
+    {
+        typedef typename MapT::key_type   domain_type;
+        typedef typename MapT::data_type  codomain_type;
+        typedef typename MapT::value_type value_type;
+
+        static void candidates(const MapT& value, std::vector<MapT>& smaller)
+        {
+            const_FORALL(typename MapT, it, value)
+            {
+                MapT dropped = value;
+                dropped.erase((*it).KEY_VALUE);
+                smaller.push_back(dropped);
+            }
+
+            const_FORALL(typename MapT, it, value)
+            {
+                std::vector<domain_type> keys;
+                Shrinker<domain_type>::candidates((*it).KEY_VALUE, keys);
+                for(typename std::vector<domain_type>::size_type idx = 0; idx < keys.size(); idx++)
+                {
+                    MapT shrunk = value;
+                    shrunk.erase((*it).KEY_VALUE);
+                    shrunk.insert(value_type(keys[idx], (*it).CONT_VALUE));
+                    smaller.push_back(shrunk);
+                }
+
+                std::vector<codomain_type> values;
+                Shrinker<codomain_type>::candidates((*it).CONT_VALUE, values);
+                for(typename std::vector<codomain_type>::size_type idx = 0; idx < values.size(); idx++)
+                {
+                    MapT shrunk = value;
+                    shrunk.erase((*it).KEY_VALUE);
+                    shrunk.insert(value_type((*it).KEY_VALUE, values[idx]));
+                    smaller.push_back(shrunk);
+                }
+            }
+        }
+    };
+
+
+    // ----- sets -------------------------------------------------------------
+    template <class DomainT>
+    struct Shrinker<itl::set<DomainT> > :
+        public SetShrinker<itl::set<DomainT> > {};
+
+    template <class DomainT>
+    struct Shrinker<itl::interval_set<DomainT> > :
+        public SetShrinker<itl::interval_set<DomainT> > {};
+
+    template <class DomainT>
+    struct Shrinker<itl::separate_interval_set<DomainT> > :
+        public SetShrinker<itl::separate_interval_set<DomainT> > {};
+
+    template <class DomainT>
+    struct Shrinker<itl::split_interval_set<DomainT> > :
+        public SetShrinker<itl::split_interval_set<DomainT> > {};
+
+    // ----- maps -------------------------------------------------------------
+    template <class DomainT, class CodomainT, class Neutronizer>
+    struct Shrinker<itl::map<DomainT,CodomainT,Neutronizer> > :
+        public MapShrinker<itl::map<DomainT,CodomainT,Neutronizer> > {};
+
+    template <class DomainT, class CodomainT, class Neutronizer>
+    struct Shrinker<interval_map<DomainT,CodomainT,Neutronizer> > :
+        public MapShrinker<interval_map<DomainT,CodomainT,Neutronizer> > {};
+
+    template <class DomainT, class CodomainT, class Neutronizer>
+    struct Shrinker<split_interval_map<DomainT,CodomainT,Neutronizer> > :
+        public MapShrinker<split_interval_map<DomainT,CodomainT,Neutronizer> > {};
+
+}} // namespace itl boost
+
@@ -0,0 +1,166 @@
+/*----------------------------------------------------------------------------+
+A Law Based Test Automaton 'LaBatea'
+Author: Joachim Faulhaber
+Copyright (c) 2007-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <boost/validate/loki/Typelist.h>
+#include <boost/validate/loki_xt/Tuple.h>
+#include <boost/validate/gentor/shrinker.h>
+
+namespace boost{namespace itl
+{
+    template <class LawT> class LawShrinker;
+
+    // ------------------------------------------------------------------------
+    // ComponentShrinker<LawT,count> tries to replace one of the first 'count'
+    // input values of a violating law instance by a simpler value, for which
+    // the law is still violated. It returns true, if it succeeded.
+    // ------------------------------------------------------------------------
+    template <class LawT, unsigned int count>
+    struct ComponentShrinker
+    {
+        typedef typename LawT::input_types input_types;
+        typedef typename LawT::input_tuple input_tuple;
+        typedef typename Loki::TL::TypeAt<input_types, count-1>::Result value_type;
+
+        static bool apply(LawShrinker<LawT>& shrinker, input_tuple& current)
+        {
+            if(ComponentShrinker<LawT, count-1>::apply(shrinker, current))
+                return true;
+
+            std::vector<value_type> smaller;
+            Shrinker<value_type>::candidates(Loki::tup::get<count-1>(current), smaller);
+
+            for(typename std::vector<value_type>::size_type idx = 0;
+                idx < smaller.size() && !shrinker.exhausted(); idx++)
+            {
+                input_tuple candidate = current;
+                Loki::tup::refer<count-1>(candidate) = smaller[idx];
+                if(shrinker.violates(candidate))
+                {
+                    current = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    template <class LawT>
+    struct ComponentShrinker<LawT, 0>
+    {
+        typedef typename LawT::input_tuple input_tuple;
+        static bool apply(LawShrinker<LawT>&, input_tuple&){ return false; }
+    };
+
+    // ------------------------------------------------------------------------
+    // ComponentsEqual<LawT,count> is true, if the first 'count' input values
+    // of two input tuples are equal.
+    // ------------------------------------------------------------------------
+    template <class LawT, unsigned int count>
+    struct ComponentsEqual
+    {
+        typedef typename LawT::input_tuple input_tuple;
+
+        static bool apply(const input_tuple& lhs, const input_tuple& rhs)
+        {
+            return ComponentsEqual<LawT, count-1>::apply(lhs, rhs)
+                && Loki::tup::get<count-1>(lhs) == Loki::tup::get<count-1>(rhs);
+        }
+    };
+
+    template <class LawT>
+    struct ComponentsEqual<LawT, 0>
+    {
+        typedef typename LawT::input_tuple input_tuple;
+        static bool apply(const input_tuple&, const input_tuple&){ return true; }
+    };
+
+
+    /** class LawShrinker:
+        Deterministic minimization of a counter example. Starting from a
+        violating instance of a law, input values are replaced by simpler
+        candidates of their Shrinker, as long as the law remains violated.
+        Intervals are dropped or narrowed, numbers are halved. Each input
+        tuple is evaluated by the law's holds() only once. Results are
+        looked up by the string form of a tuple and told apart by equality,
+        since different values, e.g. doubles, may print alike.
+    */
+    template <class LawT>
+    class LawShrinker
+    {
+    public:
+        typedef typename LawT::input_types input_types;
+        typedef typename LawT::input_tuple input_tuple;
+
+        enum { MaxEvaluations = 10000 };
+
+        LawShrinker(LawT& law): _law(law), _maxEvaluations(MaxEvaluations),
+            _evaluations(0), _cacheHits(0) {}
+
+        void setMaxEvaluations(int evaluations) { _maxEvaluations = evaluations; }
+
+        /** Shrinks the violated instance of the law. Afterwards the law is set to
+            the simplest violating instance found and has been evaluated for it. */
+        void shrink()
+        {
+            input_tuple current;
+            _law.getInputInstance(current);
+            _violated[current.as_string()].push_back(memo_type(current, true));
+
+            while(!exhausted()
+                  && ComponentShrinker<LawT, Loki::TL::Length<input_types>::value>::apply(*this, current))
+                ;
+
+            _law.setInstance(current);
+            _law.holds();
+        }
+
+        /// True, if the law is violated for \c values. Results are memoized.
+        bool violates(const input_tuple& values)
+        {
+            bucket_type& known = _violated[values.as_string()];
+            for(typename bucket_type::size_type idx = 0; idx < known.size(); idx++)
+                if(ComponentsEqual<LawT, Loki::TL::Length<input_types>::value>
+                       ::apply(known[idx].first, values))
+                {
+                    _cacheHits++;
+                    return known[idx].second;
+                }
+
+            _evaluations++;
+            _law.setInstance(values);
+            bool violated = !_law.holds();
+            known.push_back(memo_type(values, violated));
+            return violated;
+        }
+
+        bool exhausted()const { return _evaluations >= _maxEvaluations; }
+
+        int evaluations()const { return _evaluations; }
+        int cacheHits()const   { return _cacheHits; }
+
+    private:
+        typedef std::pair<input_tuple, bool> memo_type;
+        typedef std::vector<memo_type>       bucket_type;
+
+    private:
+        LawT&                               _law;
+        int                                 _maxEvaluations;
+        int                                 _evaluations;
+        int                                 _cacheHits;
+        std::map<std::string, bucket_type>  _violated;
+    };
+
+}} // namespace itl boost
+
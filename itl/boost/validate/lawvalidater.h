@@ -11,19 +11,40 @@ Copyright (c) 2007-2008: Joachim Faulhaber
 
 #include <iostream>
 #include <stdio.h>
+#include <vector>
+#include <algorithm>
 #include <boost/validate/loki_xt/Tuple.h>
 #include <boost/itl/set.hpp>
 #include <boost/itl/map.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/validate/gentor/randomgentor.h>
+#include <boost/validate/workerpool.h>
 
 #include <boost/validate/laws/monoid.h>
 #include <boost/validate/lawviolations.h>
+#include <boost/validate/lawshrinker.h>
 
 namespace boost{namespace itl
 {
     typedef itl::map<std::string, int> ValidationCounterT;
     typedef itl::map<std::string, int> ViolationCounterT;
     typedef itl::map<std::string, PolyLawViolations> ViolationMapT;
+    typedef itl::map<std::string, double> ValidationTimeT;
+
+    /// Serializes reports of validaters that run concurrently
+    inline boost::mutex& validation_report_mutex()
+    {
+        static boost::mutex report_mutex;
+        return report_mutex;
+    }
+
+    /// Threads that run the trials of law validaters
+    inline WorkerPool& validation_pool()
+    {
+        static WorkerPool pool;
+        return pool;
+    }
 
     class LawValidaterI
     {
@@ -33,6 +54,7 @@ namespace boost{namespace itl
         virtual void run()=0;
         virtual void addFrequencies(ValidationCounterT&)=0;
         virtual void addViolations(ViolationCounterT&, ViolationMapT&)=0;
+        virtual void addTimings(ValidationCounterT&, ValidationTimeT&)=0;
     };
 
 
@@ -49,7 +71,7 @@ namespace boost{namespace itl
         typedef typename Loki::tuple<gentor_types> input_gentor;
 
     public:
-        LawValidater(){ setTrialsCount(1000); } //1000(std)//JODO config at only ONE location
+        LawValidater(): _duration(0.0) { setTrialsCount(1000); } //1000(std)//JODO config at only ONE location
 
         void setTrialsCount(int trials) 
         {
@@ -57,7 +79,7 @@ namespace boost{namespace itl
             _silentTrialsCount = std::max(1, _trialsCount / 10);
         }
 
-        void setSilentTrialsCount(int trials) { _trialsCount = trials; }
+        void setSilentTrialsCount(int trials) { _silentTrialsCount = trials; }
 
         void init();
         void run();
@@ -70,6 +92,13 @@ namespace boost{namespace itl
                 collector += ViolationMapT::value_type(lawType(), PolyLawViolations(new LawViolationsT(_lawViolations)));
         }
 
+        /// Adds the number of trials of the last run and the seconds they took
+        void addTimings(ValidationCounterT& trials, ValidationTimeT& durations)
+        {
+            trials    += ValidationCounterT::value_type(lawType(), _trialsCount);
+            durations += ValidationTimeT::value_type(lawType(), _duration);
+        }
+
         std::string lawType()const{ return _law.typeString(); }
 
         void reportLawInfo()const;
@@ -80,12 +109,15 @@ namespace boost{namespace itl
     private:
         typedef LawViolations<LawT> LawViolationsT;
 
+        void runTrials(int chunk, int chunks, boost::uint64_t seed,
+                       std::vector<LawViolationsT>* violations);
+
     private:
-        input_gentor _gentor;
         LawT         _law;
 
         int _trialsCount;
         int _silentTrialsCount;
+        double _duration;
 
         LawViolationsT     _lawViolations;
         ValidationCounterT _frequencies;
@@ -105,28 +137,35 @@ namespace boost{namespace itl
     template <class LawT, template<typename>class GentorT>
     void LawValidater<LawT, GentorT>::run()
     {
-        // apply Calibrater.apply to each element of the generator-tuple _gentor
-        // This is just an initialisation of the generators according to system
-        // defaults for convenience purposes.
-        _gentor.template apply<GentorT, Calibrater, input_tuple>();
-
-        // Input values that are to be generated on every iteration
-        input_tuple values;
-
-        for(int idx=0; idx<_trialsCount; idx++)
-        {
-            // Apply the function SomeVale to each component of the input tuple
-            _gentor.template map_template<GentorT, SomeValue>(values);
-            _law.setInstance(values);
-
-            if(!_law.holds())
-                _lawViolations.insert(_law);
-        }
+        // Trials are split into chunks, that the threads of the validation pool
+        // take one by one. Every trial seeds the engine of its thread by its
+        // number, so its values do not depend on the number of threads.
+        boost::uint64_t seed = rnd_engine().split();
+        int chunks = std::min(_trialsCount, 4 * validation_pool().threadCount());
+        std::vector<LawViolationsT> violations(chunks);
+
+        // The calling thread runs chunks too, which reseed its engine
+        xoshiro256 caller_engine = rnd_engine();
+        boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+        validation_pool().run(boost::bind(&LawValidater::runTrials, this, _1, chunks, 
+                                          seed, &violations), chunks);
+        rnd_engine() = caller_engine;
+        _duration = (boost::posix_time::microsec_clock::universal_time() - start)
+                    .total_microseconds() / 1000000.0;
+
+        for(int chunk=0; chunk < chunks; chunk++)
+            _lawViolations.merge(violations[chunk]);
 
         if(!_lawViolations.empty())
         {
-            reportViolations();
+            // Minimize the smallest counter example before it is reported
             LawT violation = *(_lawViolations.begin());
+            LawShrinker<LawT> shrinker(violation);
+            shrinker.shrink();
+            _lawViolations.insert_derived(violation);
+
+            boost::mutex::scoped_lock lock(validation_report_mutex());
+            reportViolations();
 
             input_tuple  inVars;
             output_tuple outVars;
@@ -146,6 +185,30 @@ namespace boost{namespace itl
 
     }
 
+    template <class LawT, template<typename>class GentorT>
+    void LawValidater<LawT, GentorT>::runTrials(int chunk, int chunks, 
+        boost::uint64_t seed, std::vector<LawViolationsT>* violations)
+    {
+        // Generators own their element generators, so every chunk calibrates its own
+        input_gentor gentor;
+        gentor.template apply<GentorT, Calibrater, input_tuple>();
+
+        LawT law;
+        // Input values that are to be generated on every iteration
+        input_tuple values;
+        for(int idx = chunk * _trialsCount / chunks; idx < (chunk+1) * _trialsCount / chunks; idx++)
+        {
+            // Seeding by splitmix64 decorrelates the engines of consecutive trials
+            rnd_seed(seed + idx);
+            // Apply the function SomeVale to each component of the input tuple
+            gentor.template map_template<GentorT, SomeValue>(values);
+            law.setInstance(values);
+
+            if(!law.holds())
+                (*violations)[chunk].insert(law);
+        }
+    }
+
     template <class LawT, template<typename>class GentorT>
     void LawValidater<LawT, GentorT>::reportLawInfo()const
     {
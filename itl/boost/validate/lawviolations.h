@@ -131,8 +131,22 @@ namespace boost{namespace itl
 
         void insert(const LawType& lawInstance) 
         {
-            _violations.insert(lawInstance);
+            insert_derived(lawInstance);
             _violationsCount++;
+        }
+
+        /// Adds the violations found by another validation of the same law
+        void merge(const LawViolations& rhs)
+        {
+            const_FORALL(typename ViolationSet, vio_, rhs._violations)
+                insert_derived(*vio_);
+            _violationsCount += rhs._violationsCount;
+        }
+
+        /// Inserts an instance derived from found violations, e.g. a shrunk one, without counting it.
+        void insert_derived(const LawType& lawInstance) 
+        {
+            _violations.insert(lawInstance);
             if(0 < _violations.size() && _maxSize < static_cast<int>(_violations.size()))
             {
                 typename ViolationSet::iterator doomed_ = _violations.end();
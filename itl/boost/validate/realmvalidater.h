@@ -12,6 +12,7 @@ Copyright (c) 2007-2008: Joachim Faulhaber
 #include <iostream>
 #include <stdio.h>
 #include <time.h>
+#include <vector>
 #include <boost/validate/typevalidater.h>
 
 #define ITL_LOCATION(message) location(__FILE__,__LINE__,message)
@@ -50,7 +51,11 @@ namespace boost{namespace itl
     class RealmValidater
     {
     public:
-        RealmValidater() { setProfile(); }
+        enum { ReportCycle = 100 };
+
+        RealmValidater(): _wallTime(0.0),
+            _seed(static_cast<boost::uint64_t>(time(NULL))) //Different numbers each run
+        { setProfile(); }
 
     private:
         void setRootTypeNames()
@@ -93,6 +98,18 @@ namespace boost{namespace itl
     public:
         bool hasValidProfile()const { return _isValid; }
 
+        /** Number of threads that run the trials of each law concurrently. Threads
+            are started once and kept in the validation pool. Types are validated
+            one after another, each of them by all threads, so a thread is never
+            left idle behind a type with few or cheap laws. */
+        void setThreadCount(int threads) { validation_pool().setThreadCount(std::max(1, threads)); }
+        int threadCount()const { return validation_pool().threadCount(); }
+
+        /** Seed of the random engines for validate(). A run is reproduced by passing 
+            the seed it reported, with any number of threads. */
+        void setSeed(boost::uint64_t seed) { _seed = seed; }
+        boost::uint64_t seed()const { return _seed; }
+
         void setProfile()
         {
             _isValid = true;
@@ -145,18 +162,27 @@ namespace boost{namespace itl
 
         void validate()
         {
-            srand(static_cast<unsigned>(time(NULL))); //Different numbers each run
-            //srand(static_cast<unsigned>(1)); //Same numbers each run (std)
-            //srand(static_cast<unsigned>(4711)); //Same numbers each run (varying)
+            std::cout << "seed: " << to_string<unsigned long>::apply(static_cast<unsigned long>(_seed)) 
+                      << std::endl;
+            rnd_seed(_seed);
 
-            for(int idx=0; hasValidProfile(); idx++)
+            while(hasValidProfile())
             {
-                if(idx>0 && idx % 100 == 0)
-                    reportFrequencies();
-                validateType();
+                boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+                validateTypes(ReportCycle);
+                _wallTime += (boost::posix_time::microsec_clock::universal_time() - start)
+                             .total_microseconds() / 1000000.0;
+                reportFrequencies();
             }
         }
 
+        /// Validates \c count randomly chosen types
+        void validateTypes(int count)
+        {
+            for(int idx=0; idx < count && hasValidProfile(); idx++)
+                validateType();
+        }
+
         AlgebraValidater* chooseValidater()
         {
             int rootChoice = _rootChoice.some();
@@ -287,6 +313,7 @@ namespace boost{namespace itl
                 _validater->validate();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(_trials, _durations);
                 delete _validater;
             }
         }
@@ -301,6 +328,7 @@ namespace boost{namespace itl
                 valid_count++;
             }
             std::cout << "------------------------------------------------------------------------------" << std::endl;
+            reportThroughput();
             int violation_count = 1;
             FORALL(ViolationMapT, it, _violations)
             {
@@ -318,6 +346,27 @@ namespace boost{namespace itl
                 std::cout << "------------------------------------------------------------------------------" << std::endl;
         }
 
+        /** Trials per second for each law, measured while its trials ran concurrently. 
+            The last line shows the overall number of trials per second of wall time. */
+        void reportThroughput()
+        {
+            int law_count = 1, trials_count = 0;
+            FORALL(ValidationCounterT, it, _trials)
+            {
+                ValidationTimeT::const_iterator duration_ = _durations.find(it->KEY_VALUE);
+                if(duration_ == _durations.end())
+                    printf("%3d %-58s%8d%8s\n", law_count, it->KEY_VALUE.c_str(), it->CONT_VALUE, "-");
+                else
+                    printf("%3d %-58s%8d%8.0f\n", law_count, it->KEY_VALUE.c_str(), it->CONT_VALUE, 
+                           it->CONT_VALUE / duration_->CONT_VALUE);
+                trials_count += it->CONT_VALUE;
+                law_count++;
+            }
+            if(_wallTime > 0.0)
+                printf("%-62s%8d%8.0f\n", "trials/sec total:", trials_count, trials_count / _wallTime);
+            std::cout << "------------------------------------------------------------------------------" << std::endl;
+        }
+
         void reportTypeChoiceError(const std::string& location, int rootChoice, const ChoiceT& chooser)const
         {
             std::cout << location
@@ -334,6 +383,10 @@ namespace boost{namespace itl
         ValidationCounterT _frequencies;
         ViolationCounterT  _violationsCount;
         ViolationMapT      _violations;
+        ValidationCounterT _trials;
+        ValidationTimeT    _durations;
+        double             _wallTime;
+        boost::uint64_t    _seed;
         bool               _isValid;
     };
 
@@ -34,6 +34,17 @@ namespace boost{namespace itl
         virtual void addViolations(ViolationCounterT&, ViolationMapT&)=0;
 
         virtual bool hasValidProfile()const{ return true; }
+
+        /// Adds the number of trials of each law validated and the seconds they took
+        void addTimings(ValidationCounterT& trials, ValidationTimeT& durations)
+        {
+            trials    += _trials;
+            durations += _durations;
+        }
+
+    protected:
+        ValidationCounterT _trials;
+        ValidationTimeT    _durations;
     };
 
 
@@ -85,6 +96,7 @@ namespace boost{namespace itl
                 _validater->run();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(_trials, _durations);
                 delete _validater;
             }
         }
@@ -152,6 +164,7 @@ namespace boost{namespace itl
                 _validater->run();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(_trials, _durations);
                 delete _validater;
             }
         }
@@ -315,6 +328,7 @@ namespace boost{namespace itl
                 _validater->run();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(_trials, _durations);
                 delete _validater;
             }
         }
@@ -402,6 +416,7 @@ namespace boost{namespace itl
                 _validater->run();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(this->_trials, this->_durations);
                 delete _validater;
             }
         }
@@ -485,6 +500,7 @@ namespace boost{namespace itl
                 _validater->run();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(this->_trials, this->_durations);
                 delete _validater;
             }
         }
@@ -589,6 +605,7 @@ namespace boost{namespace itl
                 _validater->run();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(_trials, _durations);
                 delete _validater;
             }
         }
@@ -652,6 +669,7 @@ namespace boost{namespace itl
                 _validater->run();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(this->_trials, this->_durations);
                 delete _validater;
             }
         }
@@ -720,6 +738,7 @@ namespace boost{namespace itl
                 _validater->run();
                 _validater->addFrequencies(_frequencies);
                 _validater->addViolations(_violationsCount, _violations);
+                _validater->addTimings(this->_trials, this->_durations);
                 delete _validater;
             }
         }
@@ -0,0 +1,129 @@
+/*----------------------------------------------------------------------------+
+A Law Based Test Automaton 'LaBatea'
+Author: Joachim Faulhaber
+Copyright (c) 2007-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <boost/assert.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace boost{namespace itl
+{
+    /** class WorkerPool:
+        Threads that are started once and run the tasks of many calls of run().
+        run(task, count) calls task(0), ..., task(count-1). The calling thread
+        takes tasks, too, and returns, when all of them are done. Tasks are
+        taken in ascending order by the first thread that is idle. They must
+        not throw.
+
+        All calls of run() share one task and its counters, so run() has a
+        single caller: It must neither be called by two threads at a time
+        nor from within a task.
+    */
+    class WorkerPool
+    {
+    public:
+        typedef boost::function<void(int)> TaskT;
+
+        WorkerPool(): _next(0), _count(0), _active(0), _running(false), _stopping(false) {}
+        ~WorkerPool() { stop(); }
+
+        /// Number of threads that run tasks, including the calling thread
+        int threadCount()const { return static_cast<int>(_workers.size()) + 1; }
+
+        void setThreadCount(int threads)
+        {
+            stop();
+            _stopping = false;
+            for(int idx=1; idx < threads; idx++)
+                _workers.push_back(new boost::thread(boost::bind(&WorkerPool::work, this)));
+        }
+
+        void run(const TaskT& task, int count)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            BOOST_ASSERT(!_running); // run() has a single caller
+            _running = true;
+            _task   = task;
+            _next   = 0;
+            _count  = count;
+            _wakeup.notify_all();
+            runTasks(lock);
+            while(_active > 0)
+                _done.wait(lock);
+            _running = false;
+        }
+
+    private:
+        // Runs tasks until none is left. The lock is held on entry and on return.
+        void runTasks(boost::mutex::scoped_lock& lock)
+        {
+            while(_next < _count)
+            {
+                int idx = _next++;
+                _active++;
+                lock.unlock();
+                _task(idx);
+                lock.lock();
+                if(--_active == 0 && _next >= _count)
+                    _done.notify_all();
+            }
+        }
+
+        void work()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            for(;;)
+            {
+                while(!_stopping && _next >= _count)
+                    _wakeup.wait(lock);
+                if(_stopping)
+                    return;
+                runTasks(lock);
+            }
+        }
+
+        void stop()
+        {
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                _stopping = true;
+                _wakeup.notify_all();
+            }
+            for(std::vector<boost::thread*>::size_type idx=0; idx < _workers.size(); idx++)
+            {
+                _workers[idx]->join();
+                delete _workers[idx];
+            }
+            _workers.clear();
+        }
+
+    private:
+        // Copies would share the threads
+        WorkerPool(const WorkerPool&);
+        WorkerPool& operator = (const WorkerPool&);
+
+    private:
+        boost::mutex                _mutex;
+        boost::condition_variable   _wakeup;
+        boost::condition_variable   _done;
+        TaskT                       _task;
+        int                         _next;
+        int                         _count;
+        int                         _active;
+        bool                        _running;
+        bool                        _stopping;
+        std::vector<boost::thread*> _workers;
+    };
+
+}} // namespace itl boost
@@ -0,0 +1,150 @@
+/*----------------------------------------------------------------------------+
+Interval Template Library
+Author: Joachim Faulhaber
+Copyright (c) 2007-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#ifndef __itl_libs_benchmark_JOFA_081020_H__
+#define __itl_libs_benchmark_JOFA_081020_H__
+
+/*  Common measurement instruments for itl benchmarks: A stopwatch and
+    replacements of the global operators new and delete that count
+    allocations, allocated bytes and the peak of live bytes.
+
+    Since the global operators are replaced, this header must be included
+    by exactly one translation unit of a benchmark program. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <string>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace boost{namespace itl{namespace benchmark
+{
+    struct allocation_counts
+    {
+        allocation_counts(): allocations(0), bytes(0), live_bytes(0), peak_bytes(0) {}
+
+        long allocations;
+        long bytes;
+        long live_bytes;
+        long peak_bytes;
+    };
+
+    inline allocation_counts& allocation_counter()
+    {
+        static allocation_counts counts;
+        return counts;
+    }
+
+    /// Restart the peak of live bytes at the current live bytes
+    inline void reset_peak()
+    { allocation_counter().peak_bytes = allocation_counter().live_bytes; }
+
+    // Every block is preceded by a header that keeps its size
+    union allocation_header
+    {
+        size_t size;
+        double alignment_1;
+        void*  alignment_2;
+    };
+
+    inline void* counted_allocate(size_t size)
+    {
+        allocation_header* block
+            = static_cast<allocation_header*>(malloc(sizeof(allocation_header) + size));
+        if(block == NULL)
+            throw std::bad_alloc();
+        block->size = size;
+
+        allocation_counts& counts = allocation_counter();
+        counts.allocations++;
+        counts.bytes += static_cast<long>(size);
+        counts.live_bytes += static_cast<long>(size);
+        if(counts.peak_bytes < counts.live_bytes)
+            counts.peak_bytes = counts.live_bytes;
+        return block + 1;
+    }
+
+    inline void counted_deallocate(void* pointer)
+    {
+        if(pointer == NULL)
+            return;
+        allocation_header* block = static_cast<allocation_header*>(pointer) - 1;
+        allocation_counter().live_bytes -= static_cast<long>(block->size);
+        free(block);
+    }
+
+
+    /// A measurement of time and allocations between start() and stop()
+    class stopwatch
+    {
+    public:
+        void start()
+        {
+            _start_counts = allocation_counter();
+            reset_peak();
+            _start = boost::posix_time::microsec_clock::universal_time();
+        }
+
+        void stop()
+        {
+            _stop = boost::posix_time::microsec_clock::universal_time();
+            _stop_counts = allocation_counter();
+        }
+
+        double nanoseconds()const
+        { return static_cast<double>((_stop - _start).total_microseconds()) * 1000.0; }
+
+        long allocations()const { return _stop_counts.allocations - _start_counts.allocations; }
+        long bytes()const       { return _stop_counts.bytes - _start_counts.bytes; }
+
+        /// Peak of live bytes during the measurement, above the live bytes at its start
+        long peak_bytes()const  { return _stop_counts.peak_bytes - _start_counts.live_bytes; }
+
+    private:
+        boost::posix_time::ptime _start;
+        boost::posix_time::ptime _stop;
+        allocation_counts        _start_counts;
+        allocation_counts        _stop_counts;
+    };
+
+
+    inline void report_header()
+    {
+        printf("%-20s %-26s %9s %11s %11s %11s\n",
+               "workload", "container", "ops", "ns/op", "allocs/op", "peak KB");
+        printf("--------------------------------------------------------------------------------------------\n");
+    }
+
+    inline void report(const std::string& workload, const std::string& container,
+                       long operations, const stopwatch& watch)
+    {
+        double ops = operations > 0 ? static_cast<double>(operations) : 1.0;
+        printf("%-20s %-26s %9ld %11.1f %11.2f %11.1f\n",
+               workload.c_str(), container.c_str(), operations,
+               watch.nanoseconds() / ops, watch.allocations() / ops,
+               watch.peak_bytes() / 1024.0);
+    }
+
+}}} // namespace benchmark itl boost
+
+
+void* operator new(size_t size) throw(std::bad_alloc)
+{ return boost::itl::benchmark::counted_allocate(size); }
+
+void* operator new[](size_t size) throw(std::bad_alloc)
+{ return boost::itl::benchmark::counted_allocate(size); }
+
+void operator delete(void* pointer) throw()
+{ boost::itl::benchmark::counted_deallocate(pointer); }
+
+void operator delete[](void* pointer) throw()
+{ boost::itl::benchmark::counted_deallocate(pointer); }
+
+#endif // __itl_libs_benchmark_JOFA_081020_H__
+
@@ -0,0 +1,113 @@
+/*----------------------------------------------------------------------------+
+Interval Template Library
+Author: Joachim Faulhaber
+Copyright (c) 2007-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <string>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/buffered.hpp>
+#include <boost/itl_xt/numbergentor.hpp>
+#include <boost/itl_xt/itvgentor.hpp>
+#include "../benchmark.hpp"
+
+using namespace std;
+using namespace boost::itl;
+using namespace boost::itl::benchmark;
+
+/** Benchmark buffered_ingest.cpp \file buffered_ingest.cpp
+
+    Compares the ingestion of many small overlapping intervals by eager
+    interval maps and by buffered maps, that merge their additions lazily.
+
+    add       random intervals of up to 40 elements are added; the buffered
+              map is compacted at the end
+    query     a lookup follows every 1000 additions
+
+    Usage: buffered_ingest [operations [seed]]
+*/
+
+typedef interval<int> itv_type;
+
+template <class MapT>
+void bench_eager(const std::string& name, const vector<typename MapT::value_type>& segments, long query_step)
+{
+    long count = static_cast<long>(segments.size()), found = 0;
+    MapT object;
+    stopwatch watch;
+    watch.start();
+    for(long idx = 0; idx < count; idx++)
+    {
+        object += segments[idx];
+        if(idx % query_step == 0 && object.contains(segments[idx].first.lower()))
+            ++found;
+    }
+    watch.stop();
+    report(query_step < count ? "query" : "add", name, count, watch);
+    if(found < 0)
+        printf("%ld\n", found);
+}
+
+template <class MapT>
+void bench_buffered(const std::string& name, const vector<typename MapT::value_type>& segments, long query_step)
+{
+    long count = static_cast<long>(segments.size()), found = 0;
+    buffered<MapT> object;
+    stopwatch watch;
+    watch.start();
+    for(long idx = 0; idx < count; idx++)
+    {
+        object += segments[idx];
+        if(idx % query_step == 0 && object.contains(segments[idx].first.lower()))
+            ++found;
+    }
+    object.compact();
+    watch.stop();
+    report(query_step < count ? "query" : "add", name, count, watch);
+    if(found < 0)
+        printf("%ld\n", found);
+}
+
+int main(int argc, char* argv[])
+{
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    boost::uint64_t seed = argc > 2 ? strtoul(argv[2], NULL, 10) : 4711;
+    xoshiro256 splitter(seed);
+
+    ItvGentorT<int> itvGentor;
+    itvGentor.setValueRange(0, count);
+    itvGentor.setMaxIntervalLength(40);
+    itvGentor.seed(splitter.split());
+    vector<itv_type> intervals(count);
+    itvGentor.some(intervals.begin(), intervals.end());
+
+    NumberGentorT<int> valueGentor;
+    valueGentor.setRange(1, 4);
+    valueGentor.seed(splitter.split());
+    vector<int> values(count);
+    valueGentor.some(values.begin(), values.end());
+
+    vector<interval_map<int,int>::value_type> segments;
+    for(int idx = 0; idx < count; idx++)
+        segments.push_back(interval_map<int,int>::value_type(intervals[idx], values[idx]));
+
+    printf(">> Interval Template Library: Benchmark buffered_ingest.cpp <<\n");
+    printf("operations: %d seed: %lu\n", count, static_cast<unsigned long>(seed));
+    report_header();
+
+    bench_eager<interval_map<int,int> >          ("interval_map",           segments, count);
+    bench_buffered<interval_map<int,int> >       ("buffered<interval_map>", segments, count);
+    bench_eager<split_interval_map<int,int> >    ("split_map",              segments, count);
+    bench_buffered<split_interval_map<int,int> > ("buffered<split_map>",    segments, count);
+    bench_eager<interval_map<int,int> >          ("interval_map",           segments, 1000);
+    bench_buffered<interval_map<int,int> >       ("buffered<interval_map>", segments, 1000);
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*----------------------------------------------------------------------------+
+Interval Template Library
+Author: Joachim Faulhaber
+Copyright (c) 2007-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <string>
+#include <boost/itl/set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl_xt/numbergentor.hpp>
+#include <boost/itl_xt/itvgentor.hpp>
+#include "../benchmark.hpp"
+
+using namespace std;
+using namespace boost::itl;
+using namespace boost::itl::benchmark;
+
+/** Benchmark codomain_copies.cpp \file codomain_copies.cpp
+
+    Counts the copies of associated values that interval maps make when
+    values are added. Heavy codomains like the member sets of the
+    user_groups example are copied, whenever a segment is split or joined,
+    unless the value of the old segment is swapped into the new one.
+
+    user_groups     random intervals of a range, that are added with
+                    member sets of one of 50 members or with strings of one
+                    character; values accumulate on overlaps
+    adjacent_join   intervals [i,i+1) appended in ascending order with
+                    equal values, so every addition joins
+    split_heavy     long random intervals on a narrow range
+
+    The codomains are wrapped by counted, that counts copy constructions
+    and assignments of values, that are not empty. Swapping counted values
+    swaps their contents.
+    Usage: codomain_copies [operations [seed]]
+*/
+
+long copy_count = 0;
+
+/// A codomain value, that counts the copies of its contents
+template <class Type>
+class counted
+{
+public:
+    counted(){}
+    explicit counted(const Type& value): _value(value) {}
+    counted(const counted& src): _value(src._value) { count(src); }
+
+    counted& operator = (const counted& src)
+    { count(src); _value = src._value; return *this; }
+
+    counted& operator += (const counted& operand) { _value += operand._value; return *this; }
+    counted& operator -= (const counted& operand) { _value -= operand._value; return *this; }
+
+    bool operator == (const counted& rhs)const { return _value == rhs._value; }
+    bool operator <  (const counted& rhs)const { return _value <  rhs._value; }
+
+    void swap(counted& src) { using std::swap; swap(_value, src._value); }
+
+    const Type& value()const { return _value; }
+
+private:
+    static void count(const counted& src)
+    {
+        if(!(src._value == Type()))
+            ++copy_count;
+    }
+
+    Type _value;
+};
+
+template <class Type>
+inline void swap(counted<Type>& lhs, counted<Type>& rhs) { lhs.swap(rhs); }
+
+
+typedef interval<int>            itv_type;
+typedef counted<boost::itl::set<int> > member_set;
+typedef counted<std::string>     text;
+
+struct workload
+{
+    std::vector<itv_type> intervals;
+    std::vector<int>      values;
+};
+
+void generate(workload& data, int count, int range, int max_length, boost::uint64_t seed)
+{
+    xoshiro256 splitter(seed);
+
+    ItvGentorT<int> itvGentor;
+    itvGentor.setValueRange(0, range);
+    itvGentor.setMaxIntervalLength(max_length);
+    itvGentor.seed(splitter.split());
+    data.intervals.resize(count);
+    itvGentor.some(data.intervals.begin(), data.intervals.end());
+
+    NumberGentorT<int> valueGentor;
+    valueGentor.setRange(0, 50);
+    valueGentor.seed(splitter.split());
+    data.values.resize(count);
+    valueGentor.some(data.values.begin(), data.values.end());
+}
+
+void generate_adjacent(workload& data, int count)
+{
+    data.intervals.resize(count);
+    data.values.resize(count);
+    for(int idx = 0; idx < count; idx++)
+    {
+        data.intervals[idx] = rightopen_interval(idx, idx+1);
+        data.values[idx] = 0;
+    }
+}
+
+member_set make_value(const member_set*, int member)
+{
+    boost::itl::set<int> members;
+    members.insert(member);
+    return member_set(members);
+}
+
+text make_value(const text*, int member)
+{ return text(std::string(1, static_cast<char>('a' + member % 26))); }
+
+template <class MapT>
+void bench_add(const std::string& workload_name, const std::string& name, const workload& data)
+{
+    typedef typename MapT::codomain_type codomain_type;
+    long count = static_cast<long>(data.intervals.size());
+
+    // Values are made beforehand, so only copies of the map are counted
+    std::vector<typename MapT::value_type> values;
+    for(long idx = 0; idx < count; idx++)
+        values.push_back(typename MapT::value_type(data.intervals[idx],
+            make_value(static_cast<const codomain_type*>(0), data.values[idx])));
+
+    stopwatch watch;
+    copy_count = 0;
+    watch.start();
+    {
+        MapT object;
+        for(long idx = 0; idx < count; idx++)
+            object += values[idx];
+        watch.stop();
+    }
+    printf("%-16s %-34s %9ld %11.1f %11.2f %11.2f\n",
+           workload_name.c_str(), name.c_str(), count,
+           watch.nanoseconds() / count, watch.allocations() / static_cast<double>(count),
+           copy_count / static_cast<double>(count));
+}
+
+template <class CodomainT>
+void bench_codomain(const std::string& codomain_name, const workload& user_groups,
+                    const workload& adjacent, const workload& split_heavy)
+{
+    typedef interval_map<int, CodomainT>       join_map;
+    typedef split_interval_map<int, CodomainT> split_map;
+
+    bench_add<join_map> ("user_groups",   "interval_map<"       + codomain_name + ">", user_groups);
+    bench_add<split_map>("user_groups",   "split_interval_map<" + codomain_name + ">", user_groups);
+    bench_add<join_map> ("adjacent_join", "interval_map<"       + codomain_name + ">", adjacent);
+    bench_add<join_map> ("split_heavy",   "interval_map<"       + codomain_name + ">", split_heavy);
+    bench_add<split_map>("split_heavy",   "split_interval_map<" + codomain_name + ">", split_heavy);
+}
+
+int main(int argc, char* argv[])
+{
+    int count = argc > 1 ? atoi(argv[1]) : 20000;
+    boost::uint64_t seed = argc > 2 ? strtoul(argv[2], NULL, 10) : 4711;
+
+    workload user_groups, adjacent, split_heavy;
+    generate(user_groups, count, 20 * count, 40, seed);
+    generate_adjacent(adjacent, count);
+    generate(split_heavy, count / 10, 2000, 400, seed + 1);
+
+    printf(">> Interval Template Library: Benchmark codomain_copies.cpp <<\n");
+    printf("operations: %d seed: %lu\n", count, static_cast<unsigned long>(seed));
+    printf("%-16s %-34s %9s %11s %11s %11s\n",
+           "workload", "container", "ops", "ns/op", "allocs/op", "copies/op");
+    printf("------------------------------------------------------------------------------------------------\n");
+
+    bench_codomain<member_set>("set<int>", user_groups, adjacent, split_heavy);
+    bench_codomain<text>      ("string",   user_groups, adjacent, split_heavy);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*----------------------------------------------------------------------------+
+Interval Template Library
+Author: Joachim Faulhaber
+Copyright (c) 2007-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <string>
+// gregorian.hpp and ptime.hpp have to come first
+#include <boost/itl/gregorian.hpp>
+#include <boost/itl/ptime.hpp>
+#include <boost/itl/day_number.hpp>
+#include <boost/itl/tick_number.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl_xt/numbergentor.hpp>
+#include <boost/itl_xt/itvgentor.hpp>
+#include "../benchmark.hpp"
+
+using namespace std;
+using namespace boost::itl;
+using namespace boost::itl::benchmark;
+using boost::gregorian::date;
+using boost::posix_time::ptime;
+
+/** Benchmark date_domains.cpp \file date_domains.cpp
+
+    Compares interval maps on boost::gregorian::date and
+    boost::posix_time::ptime with interval maps on their integer
+    encodings day_number and tick_number, and on int.
+
+    add       random periods of up to 40 days or minutes are added
+    contains  random days or minutes are looked up
+
+    The same random intervals on int are converted to each domain
+    beforehand, so only the operations of the maps are measured.
+    Usage: date_domains [operations [seed]]
+*/
+
+typedef interval<int> itv_type;
+
+date  day_of(int offset)    { return date(2000,1,1) + boost::gregorian::days(offset); }
+ptime minute_of(int offset) { return ptime(date(2008,1,1)) + boost::posix_time::minutes(offset); }
+
+interval<int>         convert(const itv_type& itv, const int*)         { return itv; }
+interval<date>        convert(const itv_type& itv, const date*)        { return rightopen_interval(day_of(itv.first()), day_of(itv.last()+1)); }
+interval<day_number>  convert(const itv_type& itv, const day_number*)  { return interval_cast<day_number>(convert(itv, static_cast<const date*>(0))); }
+interval<ptime>       convert(const itv_type& itv, const ptime*)       { return rightopen_interval(minute_of(itv.first()), minute_of(itv.last()+1)); }
+interval<tick_number> convert(const itv_type& itv, const tick_number*) { return interval_cast<tick_number>(convert(itv, static_cast<const ptime*>(0))); }
+
+template <class MapT>
+void bench_domain(const std::string& name, const vector<itv_type>& intervals,
+                  const vector<int>& values, const vector<itv_type>& probes)
+{
+    typedef typename MapT::domain_type   domain_type;
+    typedef typename MapT::interval_type interval_type;
+    long count = static_cast<long>(intervals.size());
+
+    vector<typename MapT::value_type> segments;
+    for(long idx = 0; idx < count; idx++)
+        segments.push_back(typename MapT::value_type(
+            convert(intervals[idx], static_cast<const domain_type*>(0)), values[idx]));
+    vector<domain_type> points;
+    for(long idx = 0; idx < count; idx++)
+        points.push_back(convert(probes[idx], static_cast<const domain_type*>(0)).lower());
+
+    MapT object;
+    stopwatch watch;
+    watch.start();
+    for(long idx = 0; idx < count; idx++)
+        object += segments[idx];
+    watch.stop();
+    report("add", name, count, watch);
+
+    long found = 0;
+    watch.start();
+    for(long idx = 0; idx < count; idx++)
+        if(object.contains(points[idx]))
+            ++found;
+    watch.stop();
+    report("contains", name, count, watch);
+    if(found < 0)
+        printf("%ld\n", found);
+}
+
+int main(int argc, char* argv[])
+{
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+    boost::uint64_t seed = argc > 2 ? strtoul(argv[2], NULL, 10) : 4711;
+    xoshiro256 splitter(seed);
+
+    ItvGentorT<int> itvGentor;
+    itvGentor.setValueRange(0, count);
+    itvGentor.setMaxIntervalLength(40);
+    itvGentor.seed(splitter.split());
+    vector<itv_type> intervals(count), probes(count);
+    itvGentor.some(intervals.begin(), intervals.end());
+    itvGentor.some(probes.begin(), probes.end());
+
+    NumberGentorT<int> valueGentor;
+    valueGentor.setRange(1, 4);
+    valueGentor.seed(splitter.split());
+    vector<int> values(count);
+    valueGentor.some(values.begin(), values.end());
+
+    printf(">> Interval Template Library: Benchmark date_domains.cpp <<\n");
+    printf("operations: %d seed: %lu\n", count, static_cast<unsigned long>(seed));
+    report_header();
+
+    bench_domain<interval_map<int,int> >               ("interval_map<int>",         intervals, values, probes);
+    bench_domain<interval_map<date,int> >              ("interval_map<date>",        intervals, values, probes);
+    bench_domain<interval_map<day_number,int> >        ("interval_map<day_number>",  intervals, values, probes);
+    bench_domain<interval_map<ptime,int> >             ("interval_map<ptime>",       intervals, values, probes);
+    bench_domain<interval_map<tick_number,int> >       ("interval_map<tick_number>", intervals, values, probes);
+    bench_domain<split_interval_map<date,int> >        ("split_map<date>",           intervals, values, probes);
+    bench_domain<split_interval_map<day_number,int> >  ("split_map<day_number>",     intervals, values, probes);
+
+    return 0;
+}
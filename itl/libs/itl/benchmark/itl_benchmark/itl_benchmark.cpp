@@ -0,0 +1,320 @@
+/*----------------------------------------------------------------------------+
+Interval Template Library
+Author: Joachim Faulhaber
+Copyright (c) 2007-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <string>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/itl/set.hpp>
+#include <boost/itl/map.hpp>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/separate_interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl_xt/numbergentor.hpp>
+#include <boost/itl_xt/itvgentor.hpp>
+#include <boost/itl_xt/var_tuple_order.hpp>
+#include <boost/itl_xt/tuple_computer.hpp>
+#include "../benchmark.hpp"
+
+using namespace std;
+using namespace boost::itl;
+using namespace boost::itl::benchmark;
+
+/** Benchmark itl_benchmark.cpp \file itl_benchmark.cpp
+
+    Drives the interval containers, itl::set, itl::map and tuple computers
+    through a set of workloads and reports time, allocations and peak memory
+    per operation:
+
+    sequential_append   intervals [2i,2i+1) appended in ascending order
+    random_overlap      random intervals of moderate length on a wide range
+    heavy_split         long random intervals on a narrow range
+    union, difference,  set algebra on two containers that are built from
+    intersection        random intervals
+    intersection_query  intersections of a container with random intervals
+
+    All random workloads are generated by seeded ItvGentorT and NumberGentorT
+    generators, so runs with equal arguments process equal data.
+    Usage: itl_benchmark [operations [seed]]
+
+    For itl::set and itl::map the lower bounds of generated intervals are
+    used as elements.
+
+    Interval maps are measured on both implementation containers: The
+    btree variants have traits btree_implemented<>.
+*/
+
+typedef interval<int> itv_type;
+
+struct workload
+{
+    std::vector<itv_type> intervals;
+    std::vector<int>      values;
+};
+
+void generate(workload& data, int count, int range, int max_length, boost::uint64_t seed)
+{
+    xoshiro256 splitter(seed);
+
+    ItvGentorT<int> itvGentor;
+    itvGentor.setValueRange(0, range);
+    itvGentor.setMaxIntervalLength(max_length);
+    itvGentor.seed(splitter.split());
+    data.intervals.resize(count);
+    itvGentor.some(data.intervals.begin(), data.intervals.end());
+
+    NumberGentorT<int> valueGentor;
+    valueGentor.setRange(1, 10);
+    valueGentor.seed(splitter.split());
+    data.values.resize(count);
+    valueGentor.some(data.values.begin(), data.values.end());
+}
+
+void generate_sequential(workload& data, int count)
+{
+    data.intervals.resize(count);
+    data.values.resize(count);
+    for(int idx = 0; idx < count; idx++)
+    {
+        data.intervals[idx] = rightopen_interval(2*idx, 2*idx+1);
+        data.values[idx] = 1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Segments: The values that are added to a container of Type
+// ----------------------------------------------------------------------------
+// itl::set and itl::map count as interval containers as well, so containers
+// are distinguished by their key_type here.
+template <class Type> struct has_interval_keys
+{ enum { value = boost::is_same<typename Type::key_type, itv_type>::value }; };
+
+template <class Type> struct is_map_type
+{ enum { value = !boost::is_same<typename Type::key_type, typename Type::value_type>::value }; };
+
+template <class Type, bool has_interval_keys, bool is_map> struct segment;
+
+template <class Type> struct segment<Type, true, false>
+{
+    static typename Type::value_type make(const itv_type& itv, int)
+    { return itv; }
+};
+
+template <class Type> struct segment<Type, true, true>
+{
+    static typename Type::value_type make(const itv_type& itv, int value)
+    { return typename Type::value_type(itv, value); }
+};
+
+template <class Type> struct segment<Type, false, false>
+{
+    static typename Type::value_type make(const itv_type& itv, int)
+    { return itv.lower(); }
+};
+
+template <class Type> struct segment<Type, false, true>
+{
+    static typename Type::value_type make(const itv_type& itv, int value)
+    { return typename Type::value_type(itv.lower(), value); }
+};
+
+template <class Type>
+typename Type::value_type make_segment(const itv_type& itv, int value)
+{
+    return segment<Type, has_interval_keys<Type>::value, is_map_type<Type>::value>
+           ::make(itv, value);
+}
+
+template <class Type>
+void fill(Type& object, const workload& data, int first, int last)
+{
+    for(int idx = first; idx < last; idx++)
+        object += make_segment<Type>(data.intervals[idx], data.values[idx]);
+}
+
+// ----------------------------------------------------------------------------
+// Queries
+// ----------------------------------------------------------------------------
+template <class Type, bool has_interval_keys> struct query;
+
+template <class Type> struct query<Type, true>
+{
+    static size_t apply(const Type& object, const itv_type& itv)
+    {
+        Type section;
+        object.add_intersection(section, itv);
+        return section.iterative_size();
+    }
+};
+
+template <class Type> struct query<Type, false>
+{
+    static size_t apply(const Type& object, const itv_type& itv)
+    { return object.find(itv.lower()) == object.end() ? 0 : 1; }
+};
+
+// ----------------------------------------------------------------------------
+// Workloads
+// ----------------------------------------------------------------------------
+template <class Type>
+void bench_add(const std::string& workload_name, const std::string& name, const workload& data)
+{
+    stopwatch watch;
+    watch.start();
+    {
+        Type object;
+        fill(object, data, 0, static_cast<int>(data.intervals.size()));
+        watch.stop();
+    }
+    report(workload_name, name, static_cast<long>(data.intervals.size()), watch);
+}
+
+template <class Type>
+void bench_algebra(const std::string& name, const workload& data)
+{
+    int half = static_cast<int>(data.intervals.size()) / 2;
+    Type lhs, rhs;
+    fill(lhs, data, 0, half);
+    fill(rhs, data, half, 2*half);
+    long operations = static_cast<long>(lhs.iterative_size() + rhs.iterative_size());
+
+    stopwatch watch;
+    {
+        Type object = lhs;
+        watch.start();
+        object += rhs;
+        watch.stop();
+    }
+    report("union", name, operations, watch);
+    {
+        Type object = lhs;
+        watch.start();
+        object -= rhs;
+        watch.stop();
+    }
+    report("difference", name, operations, watch);
+    {
+        Type object = lhs;
+        watch.start();
+        object *= rhs;
+        watch.stop();
+    }
+    report("intersection", name, operations, watch);
+}
+
+template <class Type>
+void bench_query(const std::string& name, const workload& data, const workload& queries)
+{
+    Type object;
+    fill(object, data, 0, static_cast<int>(data.intervals.size()));
+
+    size_t found = 0;
+    stopwatch watch;
+    watch.start();
+    for(size_t idx = 0; idx < queries.intervals.size(); idx++)
+        found += query<Type, has_interval_keys<Type>::value>::apply(object, queries.intervals[idx]);
+    watch.stop();
+    report("intersection_query", name, static_cast<long>(queries.intervals.size()), watch);
+    if(found == 0) // keep the queries from being optimized away
+        printf("  (no query hit)\n");
+}
+
+template <class Type>
+void bench_container(const std::string& name, int count, boost::uint64_t seed)
+{
+    workload sequential, overlapping, splitting, queries;
+    generate_sequential(sequential, count);
+    generate(overlapping, count, 10*count, 50, seed);
+    generate(splitting, count, count/10 + 1, count/20 + 1, seed);
+    generate(queries, count, 10*count, 50, seed + 1);
+
+    bench_add<Type>("sequential_append", name, sequential);
+    bench_add<Type>("random_overlap",    name, overlapping);
+    bench_add<Type>("heavy_split",       name, splitting);
+    bench_algebra<Type>(name, overlapping);
+    bench_query<Type>(name, overlapping, queries);
+}
+
+// ----------------------------------------------------------------------------
+// Tuple computers
+// ----------------------------------------------------------------------------
+enum CubeVarsET { var_a, var_b, var_c, CubeVarsET_size };
+
+void bench_tuple_computers(int count, boost::uint64_t seed)
+{
+    typedef var_tuple<CubeVarsET_size>                      tuple_type;
+    typedef amount_tuple_computer<CubeVarsET_size, int>     amount_cube_type;
+    typedef interval_tuple_computer<CubeVarsET_size, int, int> interval_cube_type;
+    typedef interval_cube_type::counter_type                counter_type;
+
+    workload data;
+    generate(data, count, 10*count, 50, seed);
+    NumberGentorT<int> varGentor;
+    varGentor.setRange(0, 10);
+    varGentor.seed(seed);
+    std::vector<int> vars(CubeVarsET_size * count);
+    varGentor.some(vars.begin(), vars.end());
+
+    std::vector<tuple_type> tuples(count);
+    for(int idx = 0; idx < count; idx++)
+    {
+        tuples[idx][var_a] = vars[CubeVarsET_size*idx];
+        tuples[idx][var_b] = vars[CubeVarsET_size*idx + 1];
+        tuples[idx][var_c] = vars[CubeVarsET_size*idx + 2];
+    }
+
+    var_tuple_order<tuple_type> order;
+    stopwatch watch;
+    {
+        amount_cube_type cube(order);
+        watch.start();
+        for(int idx = 0; idx < count; idx++)
+            cube.insert(tuples[idx], data.values[idx]);
+        watch.stop();
+    }
+    report("tuple_insert", "amount_tuple_computer", count, watch);
+    {
+        interval_cube_type cube(order);
+        watch.start();
+        for(int idx = 0; idx < count; idx++)
+            cube.insert(tuples[idx], counter_type(counter_type::value_type(data.intervals[idx], data.values[idx])));
+        watch.stop();
+    }
+    report("tuple_insert", "interval_tuple_computer", count, watch);
+}
+
+
+int main(int argc, char* argv[])
+{
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+    boost::uint64_t seed = argc > 2 ? strtoul(argv[2], NULL, 10) : 4711;
+
+    printf(">> Interval Template Library: Benchmark itl_benchmark.cpp <<\n");
+    printf("operations: %d seed: %lu\n", count, static_cast<unsigned long>(seed));
+    report_header();
+
+    bench_container<interval_set<int> >               ("interval_set",          count, seed);
+    bench_container<separate_interval_set<int> >      ("separate_interval_set", count, seed);
+    bench_container<split_interval_set<int> >         ("split_interval_set",    count, seed);
+    bench_container<interval_map<int,int> >           ("interval_map",          count, seed);
+    bench_container<split_interval_map<int,int> >     ("split_interval_map",    count, seed);
+    bench_container<interval_map<int,int,btree_implemented<> > >
+                                                      ("btree interval_map",    count, seed);
+    bench_container<split_interval_map<int,int,btree_implemented<> > >
+                                                      ("btree split_interval_map", count, seed);
+    bench_container<boost::itl::set<int> >            ("itl::set",              count, seed);
+    bench_container<boost::itl::map<int,int> >        ("itl::map",              count, seed);
+    bench_tuple_computers(count, seed);
+
+    return 0;
+}
+
@@ -0,0 +1,113 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::accumulator unit test
+#include <stdlib.h>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/accumulator.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+// The overlap count of the intervals, that writer \c part adds
+template <class MapT>
+struct overlap_writer
+{
+    overlap_writer(accumulator<MapT>& counts): _counts(&counts) {}
+
+    void operator()(unsigned part)const
+    {
+        MapT& counts = _counts->part(part);
+        for(int idx = 0; idx < 300; idx++)
+        {
+            int lower = static_cast<int>((part * 7919 + idx * 104729) % 2000);
+            counts += make_pair(rightopen_interval(lower, lower + 1 + (idx * 31) % 50), 1);
+        }
+    }
+
+    accumulator<MapT>* _counts;
+};
+
+template <class MapT>
+MapT expected_overlaps(unsigned parts)
+{
+    MapT counts;
+    for(unsigned part = 0; part < parts; part++)
+        for(int idx = 0; idx < 300; idx++)
+        {
+            int lower = static_cast<int>((part * 7919 + idx * 104729) % 2000);
+            counts += make_pair(rightopen_interval(lower, lower + 1 + (idx * 31) % 50), 1);
+        }
+    return counts;
+}
+
+template <class MapT> void check_accumulator(unsigned parts, unsigned threads)
+{
+    accumulator<MapT> counts(parts);
+    BOOST_CHECK_EQUAL(counts.part_count(), parts);
+    Parallel::run(overlap_writer<MapT>(counts), parts);
+    MapT expected = expected_overlaps<MapT>(parts);
+
+    const MapT& collected = counts.collect(threads);
+    BOOST_CHECK(is_element_equal(collected, expected));
+    if(is_interval_joiner<MapT>::value)
+        BOOST_CHECK(collected == expected);
+    for(unsigned part = 1; part < parts; part++)
+        BOOST_CHECK(counts.part(part).empty());
+
+    // Collecting again includes the previous total
+    Parallel::run(overlap_writer<MapT>(counts), parts);
+    MapT twice = expected;
+    twice += expected;
+    BOOST_CHECK(is_element_equal(counts.collect(threads), twice));
+
+    counts.clear();
+    BOOST_CHECK(counts.collect(threads).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_accumulated_overlaps)
+{
+    for(unsigned parts = 1; parts <= 9; parts++)
+        for(unsigned threads = 1; threads <= 4; threads++)
+        {
+            check_accumulator<interval_map<int,int> >(parts, threads);
+            check_accumulator<split_interval_map<int,int> >(parts, threads);
+        }
+}
+
+BOOST_AUTO_TEST_CASE(test_default_parts)
+{
+    unsigned hardware = boost::thread::hardware_concurrency();
+    accumulator<interval_map<int,int> > counts;
+    BOOST_CHECK_EQUAL(counts.part_count(), hardware == 0 ? 1u : hardware);
+    Parallel::run(overlap_writer<interval_map<int,int> >(counts), counts.part_count());
+    BOOST_CHECK(is_element_equal(counts.collect(),
+                                 expected_overlaps<interval_map<int,int> >(counts.part_count())));
+}
+
+BOOST_AUTO_TEST_CASE(test_accumulated_sets)
+{
+    typedef interval_map<int,itl::set<int> > PartiesT;
+    accumulator<PartiesT> parties(3);
+    PartiesT expected;
+    for(unsigned part = 0; part < 3; part++)
+        for(int guest = 0; guest < 20; guest++)
+        {
+            itl::set<int> arrival;
+            arrival.insert(guest + 100 * static_cast<int>(part));
+            parties.part(part) += make_pair(rightopen_interval(guest, guest + 10), arrival);
+            expected += make_pair(rightopen_interval(guest, guest + 10), arrival);
+        }
+    BOOST_CHECK(parties.collect(2) == expected);
+}
@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::aggregate unit test
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/aggregate.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+
+template <class IntervalMapT>
+IntervalMapT random_map(int value_range)
+{
+    typedef typename IntervalMapT::codomain_type CodomainT;
+    IntervalMapT map;
+    for(int step = 0; step < 8; step++)
+    {
+        int lower = rand() % 60, upper = lower + rand() % 12;
+        map.add(make_pair(rightopen_interval(lower, upper),
+                          CodomainT(rand() % value_range - value_range / 3)));
+    }
+    return map;
+}
+
+// Repeated addition is the reference for aggregate
+template <template<class>class Combinator, class ResultMapT, class InputMapT>
+void check_aggregate(int value_range)
+{
+    std::vector<InputMapT> inputs;
+    for(int idx = 0; idx < 1 + rand() % 12; idx++)
+        inputs.push_back(random_map<InputMapT>(value_range));
+
+    ResultMapT aggregated, expected;
+    if(rand() % 3 == 0)
+    {
+        InputMapT initial = random_map<InputMapT>(value_range);
+        const_FORALL(typename InputMapT, segment_, initial)
+        {
+            aggregated.insert(*segment_);
+            expected.insert(*segment_);
+        }
+    }
+
+    aggregate<Combinator>(aggregated, inputs.begin(), inputs.end());
+    for(typename std::vector<InputMapT>::const_iterator input_ = inputs.begin();
+        input_ != inputs.end(); ++input_)
+        const_FORALL(typename InputMapT, segment_, *input_)
+            expected.template add<Combinator>(*segment_);
+
+    // Repeated addition forgets the borders of segments that were absorbed
+    // on the way, so split results are only equal element wise.
+    BOOST_CHECK(is_element_equal(aggregated, expected));
+    if(is_interval_joiner<ResultMapT>::value)
+        BOOST_CHECK_EQUAL(aggregated.as_string(), expected.as_string());
+}
+
+BOOST_AUTO_TEST_CASE(test_aggregate_sums)
+{
+    typedef interval_map<int,int>                        JoinMapT;
+    typedef split_interval_map<int,int>                  SplitMapT;
+    typedef interval_map<int,int,neutron_enricher>       EnricherMapT;
+
+    srand(11);
+    for(int run = 0; run < 200; run++)
+    {
+        check_aggregate<inplace_plus, JoinMapT,     JoinMapT>(6);
+        check_aggregate<inplace_plus, JoinMapT,     SplitMapT>(6);
+        check_aggregate<inplace_plus, SplitMapT,    SplitMapT>(6);
+        check_aggregate<inplace_plus, SplitMapT,    JoinMapT>(6);
+        check_aggregate<inplace_plus, EnricherMapT, EnricherMapT>(6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_aggregate_other_combinators)
+{
+    typedef interval_map<int,int>                 JoinMapT;
+    typedef split_interval_map<int,int>           SplitMapT;
+    typedef interval_map<int,double>              DoubleMapT;
+
+    srand(13);
+    for(int run = 0; run < 200; run++)
+    {
+        check_aggregate<inplace_max,   JoinMapT,   JoinMapT>(10);
+        check_aggregate<inplace_min,   SplitMapT,  SplitMapT>(10);
+        check_aggregate<inplace_minus, JoinMapT,   JoinMapT>(10);
+        check_aggregate<inplace_plus,  DoubleMapT, DoubleMapT>(4);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_aggregate_set_values)
+{
+    typedef interval_map<int, interval_set<int> > SetMapT;
+    std::vector<SetMapT> groups(50);
+    SetMapT expected;
+    for(int member = 0; member < 50; member++)
+    {
+        int lower = member % 7 * 5;
+        groups[member].add(make_pair(rightopen_interval(lower, lower + 10), interval_set<int>(member)));
+        expected += groups[member];
+    }
+
+    SetMapT aggregated;
+    aggregate(aggregated, groups.begin(), groups.end());
+    BOOST_CHECK(aggregated == expected);
+}
+
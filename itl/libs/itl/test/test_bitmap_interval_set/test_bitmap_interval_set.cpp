@@ -0,0 +1,163 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::bitmap_interval_set unit test
+#include <stdlib.h>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/bitmap_interval_set.hpp>
+#include <boost/itl/interval_morphism.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+
+template <class BitmapSetT, class IntervalSetT>
+void check_same_intervals(const BitmapSetT& bitmap_set, const IntervalSetT& interval_set_)
+{
+    BOOST_CHECK_EQUAL(bitmap_set.iterative_size(), interval_set_.iterative_size());
+    BOOST_CHECK_EQUAL(bitmap_set.size(), interval_set_.size());
+    typename BitmapSetT::const_iterator bitmap_ = bitmap_set.begin();
+    typename IntervalSetT::const_iterator expected_ = interval_set_.begin();
+    for(; expected_ != interval_set_.end() && bitmap_ != bitmap_set.end(); ++bitmap_, ++expected_)
+    {
+        BOOST_CHECK_EQUAL((*bitmap_).first(), (*expected_).first());
+        BOOST_CHECK_EQUAL((*bitmap_).last(),  (*expected_).last());
+    }
+    BOOST_CHECK(bitmap_ == bitmap_set.end());
+}
+
+// Random intervals spread over a few chunks, some of them long enough
+// to fill or span chunks. A narrow spread yields dense bitmap chunks.
+template <class DomainT>
+interval<DomainT> random_interval(DomainT offset, int spread = 200000)
+{
+    DomainT lower = offset + static_cast<DomainT>(rand() % spread);
+    DomainT length = static_cast<DomainT>(rand() % 8 == 0 && spread > 70000 ? rand() % 70000 : rand() % 4);
+    return closed_interval<DomainT>(lower, lower + length);
+}
+
+BOOST_AUTO_TEST_CASE(test_bitmap_interval_set_representations)
+{
+    typedef bitmap_interval_set<unsigned> BitmapSetT;
+    BitmapSetT ids;
+
+    // Sparse values are kept in arrays
+    for(unsigned id = 0; id < 1000; id += 3)
+        ids += id;
+    BOOST_CHECK_EQUAL(ids.size(), 334u);
+    BOOST_CHECK_EQUAL(ids.iterative_size(), 334u);
+    BOOST_CHECK_EQUAL(ids.chunk_count(), 1u);
+    BOOST_CHECK(ids.contains(999u));
+    BOOST_CHECK(!ids.contains(998u));
+
+    // Intervals spanning chunks are iterated as a single interval
+    ids += closed_interval<unsigned>(60000, 200000);
+    BOOST_CHECK_EQUAL(ids.chunk_count(), 4u);
+    BOOST_CHECK_EQUAL(ids.iterative_size(), 335u);
+    BOOST_CHECK(ids.contains(closed_interval<unsigned>(60000, 200000)));
+    BOOST_CHECK(!ids.contains(closed_interval<unsigned>(59999, 200000)));
+    BOOST_CHECK_EQUAL(ids.upper(), 200000u);
+    BOOST_CHECK_EQUAL(ids.lower(), 0u);
+
+    // Dense sets of values are bitmaps
+    for(unsigned id = 300000; id < 340000; id += 2)
+        ids += id;
+    BOOST_CHECK_EQUAL(ids.size(), 334u + 140001u + 20000u);
+
+    ids -= closed_interval<unsigned>(0, 299999);
+    BOOST_CHECK_EQUAL(ids.chunk_count(), 2u);
+    BOOST_CHECK_EQUAL(ids.iterative_size(), 20000u);
+
+    // Extreme values of the domain
+    bitmap_interval_set<int> extremes;
+    extremes += closed_interval<int>((std::numeric_limits<int>::min)(), (std::numeric_limits<int>::min)() + 2);
+    extremes += closed_interval<int>(-2, 2);
+    extremes += (std::numeric_limits<int>::max)();
+    BOOST_CHECK_EQUAL(extremes.iterative_size(), 3u);
+    BOOST_CHECK_EQUAL(extremes.first(), (std::numeric_limits<int>::min)());
+    BOOST_CHECK_EQUAL(extremes.last(),  (std::numeric_limits<int>::max)());
+    BOOST_CHECK(extremes.contains(-1));
+}
+
+BOOST_AUTO_TEST_CASE(test_bitmap_interval_set_equals_interval_set)
+{
+    typedef bitmap_interval_set<int> BitmapSetT;
+    typedef interval_set<int>        IntervalSetT;
+
+    srand(4711);
+    for(int run = 0; run < 20; run++)
+    {
+        BitmapSetT   bitmap_set, bitmap_other;
+        IntervalSetT expected,   expected_other;
+        bool dense = run % 2 == 1;
+        for(int step = 0; step < (dense ? 12000 : 200); step++)
+        {
+            interval<int> itv = random_interval<int>(dense ? 1000 : -100000, dense ? 20000 : 200000);
+            switch(rand() % 4)
+            {
+            case 0: case 1: bitmap_set += itv; expected += itv; break;
+            case 2:         bitmap_set -= itv; expected -= itv; break;
+            default:        bitmap_other += itv; expected_other += itv; break;
+            }
+        }
+        check_same_intervals(bitmap_set, expected);
+        check_same_intervals(bitmap_other, expected_other);
+
+        BitmapSetT   bitmap_section = bitmap_set;
+        IntervalSetT expected_section = expected;
+        bitmap_section *= bitmap_other;
+        expected_section *= expected_other;
+        check_same_intervals(bitmap_section, expected_section);
+
+        BitmapSetT   bitmap_union = bitmap_set;
+        IntervalSetT expected_union = expected;
+        bitmap_union += bitmap_other;
+        expected_union += expected_other;
+        check_same_intervals(bitmap_union, expected_union);
+
+        BitmapSetT   bitmap_difference = bitmap_set;
+        IntervalSetT expected_difference = expected;
+        bitmap_difference -= bitmap_other;
+        expected_difference -= expected_other;
+        check_same_intervals(bitmap_difference, expected_difference);
+
+        BOOST_CHECK(bitmap_union.contains(bitmap_set));
+        BOOST_CHECK(bitmap_section.contained_in(bitmap_other));
+        BOOST_CHECK(bitmap_set == bitmap_set);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bitmap_interval_set_atomize_and_cluster)
+{
+    typedef bitmap_interval_set<int> BitmapSetT;
+
+    srand(42);
+    BitmapSetT bitmap_set;
+    interval_set<int> expected;
+    for(int step = 0; step < 50; step++)
+    {
+        interval<int> itv = random_interval<int>(-100000);
+        bitmap_set += itv;
+        expected   += itv;
+    }
+
+    itl::set<int> elements, expected_elements;
+    Interval::atomize(elements, bitmap_set);
+    Interval::atomize(expected_elements, expected);
+    BOOST_CHECK(elements == expected_elements);
+
+    BitmapSetT clustered;
+    Interval::cluster(clustered, elements);
+    BOOST_CHECK(clustered == bitmap_set);
+    check_same_intervals(clustered, expected);
+}
+
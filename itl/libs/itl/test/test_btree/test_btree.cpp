@@ -0,0 +1,255 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::btree unit test
+// Small nodes make the trees of the tests deep
+#define ITL_BTREE_NODE_BYTES 16
+#include <stdlib.h>
+#include <set>
+#include <map>
+#include <vector>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/btree_set.hpp>
+#include <boost/itl/btree_map.hpp>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/interval_morphism.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+
+template <class BtreeT, class StdT>
+void check_equal_sequences(const BtreeT& btree_object, const StdT& std_object)
+{
+    BOOST_CHECK_EQUAL(btree_object.size(), std_object.size());
+    BOOST_CHECK(std::equal(std_object.begin(), std_object.end(), btree_object.begin()));
+    BOOST_CHECK(std::equal(std_object.rbegin(), std_object.rend(), btree_object.rbegin()));
+}
+
+BOOST_AUTO_TEST_CASE(test_btree_set_ordered_and_reverse_insertion)
+{
+    btree_set<int> ascending, descending;
+    std::set<int>  expected;
+    for(int idx = 0; idx < 1000; idx++)
+    {
+        ascending.insert(idx);
+        descending.insert(999 - idx);
+        expected.insert(idx);
+    }
+    check_equal_sequences(ascending,  expected);
+    check_equal_sequences(descending, expected);
+    BOOST_CHECK(ascending == descending);
+    BOOST_CHECK(ascending.height() > 1);
+
+    BOOST_CHECK_EQUAL(ascending.insert(500).WAS_SUCCESSFUL, false);
+    BOOST_CHECK_EQUAL(*ascending.insert(500).ITERATOR, 500);
+    BOOST_CHECK_EQUAL(ascending.size(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(test_btree_set_random_insertion_and_erasure)
+{
+    srand(4711);
+    btree_set<int> object;
+    std::set<int>  expected;
+    for(int idx = 0; idx < 20000; idx++)
+    {
+        int value = rand() % 3000;
+        if(rand() % 3 == 0)
+            BOOST_CHECK_EQUAL(object.erase(value), expected.erase(value));
+        else
+            BOOST_CHECK_EQUAL(object.insert(value).WAS_SUCCESSFUL, expected.insert(value).WAS_SUCCESSFUL);
+
+        if(idx % 1000 == 0)
+            check_equal_sequences(object, expected);
+    }
+    check_equal_sequences(object, expected);
+
+    for(int value = -1; value <= 3001; value++)
+    {
+        std::set<int>::const_iterator lower_ = expected.lower_bound(value);
+        std::set<int>::const_iterator upper_ = expected.upper_bound(value);
+        btree_set<int>::const_iterator btree_lower_ = object.lower_bound(value);
+        btree_set<int>::const_iterator btree_upper_ = object.upper_bound(value);
+        BOOST_CHECK_EQUAL(lower_ == expected.end(), btree_lower_ == object.end());
+        BOOST_CHECK_EQUAL(upper_ == expected.end(), btree_upper_ == object.end());
+        if(lower_ != expected.end() && btree_lower_ != object.end())
+            BOOST_CHECK_EQUAL(*lower_, *btree_lower_);
+        if(upper_ != expected.end() && btree_upper_ != object.end())
+            BOOST_CHECK_EQUAL(*upper_, *btree_upper_);
+        BOOST_CHECK_EQUAL(object.contains(value), expected.find(value) != expected.end());
+    }
+
+    // Erase everything in random order
+    std::vector<int> values(expected.begin(), expected.end());
+    for(size_t idx = values.size(); idx > 1; idx--)
+        std::swap(values[idx-1], values[rand() % idx]);
+    for(size_t idx = 0; idx < values.size(); idx++)
+        object.erase(values[idx]);
+    BOOST_CHECK(object.empty());
+    BOOST_CHECK(object.begin() == object.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_btree_hinted_insertion_and_erasure)
+{
+    btree_set<int> object;
+    std::set<int>  expected;
+    for(int idx = 0; idx < 500; idx += 2)
+    {
+        BOOST_CHECK_EQUAL(*object.insert(object.end(), idx), idx);
+        expected.insert(idx);
+    }
+
+    // Odd values are inserted behind their predecessors, wrong hints are ignored
+    for(int idx = 1; idx < 500; idx += 2)
+    {
+        BOOST_CHECK_EQUAL(*object.insert(object.find(idx-1), idx), idx);
+        expected.insert(idx);
+    }
+    BOOST_CHECK_EQUAL(*object.insert(object.begin(), 1000), 1000);
+    BOOST_CHECK_EQUAL(*object.insert(object.end(), 250), 250);
+    expected.insert(1000);
+    check_equal_sequences(object, expected);
+
+    // Erasure returns the position behind the erased elements
+    btree_set<int>::iterator it_ = object.begin();
+    while(it_ != object.end())
+        if(*it_ % 3 == 0)
+        {
+            int value = *it_;
+            it_ = object.erase(it_);
+            expected.erase(value);
+            if(it_ != object.end())
+                BOOST_CHECK_EQUAL(*it_, *expected.upper_bound(value));
+        }
+        else ++it_;
+    check_equal_sequences(object, expected);
+
+    it_ = object.erase(object.lower_bound(100), object.lower_bound(300));
+    expected.erase(expected.lower_bound(100), expected.lower_bound(300));
+    BOOST_CHECK_EQUAL(*it_, *expected.lower_bound(300));
+    check_equal_sequences(object, expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_btree_map_replace)
+{
+    srand(815);
+    btree_map<int,int> object;
+    std::map<int,int>  expected;
+    for(int idx = 0; idx < 1000; idx += 10)
+    {
+        object.insert(make_pair(idx, idx+1));
+        expected.insert(make_pair(idx, idx+1));
+    }
+
+    // Ranges are replaced by fewer, as many or more elements
+    for(int round = 0; round < 500; round++)
+    {
+        int lower = rand() % 1000, upper = lower + rand() % 100;
+        std::vector<std::pair<int,int> > segments;
+        for(int key = lower + rand() % 7; key < upper; key += 1 + rand() % 15)
+            segments.push_back(make_pair(key, round+1));
+
+        expected.erase(expected.lower_bound(lower), expected.lower_bound(upper));
+        expected.insert(segments.begin(), segments.end());
+        object.replace(object.lower_bound(lower), object.lower_bound(upper), segments);
+        if(round % 50 == 0)
+            check_equal_sequences(object, expected);
+    }
+    check_equal_sequences(object, expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_btree_map_absorbs_neutrons)
+{
+    btree_map<int,int> object;
+    object.insert(make_pair(1, 0));
+    BOOST_CHECK(object.empty());
+
+    object.insert(make_pair(1, 2));
+    object.insert(make_pair(2, 3));
+    (*object.find(2)).CONT_VALUE += 4;
+    BOOST_CHECK_EQUAL(object.as_string(), "(1->2)(2->7)");
+
+    btree_map<int,int> copy(object);
+    BOOST_CHECK(copy == object);
+    copy.erase(1);
+    BOOST_CHECK(!(copy == object));
+}
+
+BOOST_AUTO_TEST_CASE(test_btree_implementation_of_interval_containers)
+{
+    typedef interval_map<int,int,btree_implemented<> >       IntervalMapT;
+    typedef split_interval_map<int,int,btree_implemented<> > SplitIntervalMapT;
+    typedef itl::map<int,int>           ElementMapT;
+
+    srand(815);
+    IntervalMapT      joining;
+    SplitIntervalMapT splitting;
+    interval_set<int> covered;
+    ElementMapT       expected;
+    for(int idx = 0; idx < 2000; idx++)
+    {
+        int lower = rand() % 500, upper = lower + 1 + rand() % 20, value = 1 + rand() % 3;
+        interval<int> itv = rightopen_interval(lower, upper);
+        if(rand() % 3 == 0)
+        {
+            joining   -= make_pair(itv, value);
+            splitting -= make_pair(itv, value);
+            for(int elem = lower; elem < upper; elem++)
+                expected.subtract(ElementMapT::value_type(elem, value));
+        }
+        else
+        {
+            joining   += make_pair(itv, value);
+            splitting += make_pair(itv, value);
+            covered   += itv;
+            for(int elem = lower; elem < upper; elem++)
+                expected.add(ElementMapT::value_type(elem, value));
+        }
+    }
+
+    ElementMapT joined_elements, split_elements;
+    Interval::atomize(joined_elements, joining);
+    Interval::atomize(split_elements,  splitting);
+    BOOST_CHECK(joined_elements == expected);
+    BOOST_CHECK(split_elements  == expected);
+    BOOST_CHECK(is_element_equal(joining, splitting));
+
+    IntervalMapT::const_iterator it_ = joining.begin(), next_ = it_;
+    while(it_ != joining.end() && ++next_ != joining.end())
+    {
+        // Touching neighbours of equal values are joined
+        BOOST_CHECK(!((*it_).KEY_VALUE.touches((*next_).KEY_VALUE) 
+                      && (*it_).CONT_VALUE == (*next_).CONT_VALUE));
+        it_ = next_;
+    }
+
+    ElementMapT::const_iterator elem_ = expected.begin();
+    for(; elem_ != expected.end(); ++elem_)
+        BOOST_CHECK(covered.contains((*elem_).KEY_VALUE));
+}
+
+BOOST_AUTO_TEST_CASE(test_btree_bound_transformations)
+{
+    // Transformed bounds must be found by later lookups in the tree
+    interval_map<int,int,btree_implemented<> > joining;
+    for(int idx = 0; idx < 100; idx++)
+        joining += make_pair(open_interval(10*idx, 10*idx + 6), 1);
+    joining.closeLeftBounds();
+    joining.uniformBounds(interval<int>::RIGHT_OPEN);
+    BOOST_CHECK_EQUAL(joining.iterative_size(), 100);
+    BOOST_CHECK((*joining.begin()).KEY_VALUE == rightopen_interval(1, 6));
+
+    joining += make_pair(rightopen_interval(506, 511), 1);
+    BOOST_CHECK_EQUAL(joining.iterative_size(), 99);
+    BOOST_CHECK(joining.contains(make_pair(rightopen_interval(501, 516), 1)));
+}
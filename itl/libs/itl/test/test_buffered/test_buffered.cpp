@@ -0,0 +1,136 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::buffered unit test
+#include <stdlib.h>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include "../test_value_maker.hpp"
+
+#include <boost/itl/set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/buffered.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+int random_value(const int*) { return rand() % 5 - 2; }
+
+itl::set<int> random_value(const itl::set<int>*)
+{
+    itl::set<int> value;
+    value.insert(rand() % 4);
+    return value;
+}
+
+// Reference: The same updates on the eager map
+template <class MapT> void check_buffered(int capacity, int steps)
+{
+    typedef typename MapT::codomain_type codomain_type;
+    buffered<MapT> lazy(capacity);
+    MapT eager;
+    for(int step = 0; step < steps; step++)
+    {
+        interval<int> itv = random_interval(1000, 20);
+        codomain_type value = random_value(static_cast<const codomain_type*>(0));
+        switch(rand() % 50)
+        {
+        case 0:
+            lazy.subtract(make_pair(itv, value));
+            eager.subtract(make_pair(itv, value));
+            break;
+        case 1:
+            lazy.erase(itv);
+            eager.erase(itv);
+            break;
+        case 2:
+            BOOST_CHECK_EQUAL(lazy.contains(itv.first()), eager.contains(itv.first()));
+            BOOST_CHECK_EQUAL(lazy.log_size(), 0u);
+            BOOST_CHECK_EQUAL(lazy.run_count(), 0u);
+            break;
+        default:
+            lazy += make_pair(itv, value);
+            eager += make_pair(itv, value);
+        }
+        BOOST_CHECK(lazy.log_size() < static_cast<size_t>(capacity));
+    }
+    // Queries of const buffered maps merge the buffers as well
+    const buffered<MapT>& reader = lazy;
+    // The borders of split maps depend on the order of additions, where values cancel out
+    BOOST_CHECK(is_element_equal(reader.container(), eager));
+    BOOST_CHECK_EQUAL(reader.log_size(), 0u);
+    BOOST_CHECK_EQUAL(reader.run_count(), 0u);
+    if(is_interval_joiner<MapT>::value)
+        BOOST_CHECK(reader.container() == eager);
+}
+
+BOOST_AUTO_TEST_CASE(test_buffered_maps)
+{
+    srand(103);
+    check_buffered<interval_map<int,int> >(7, 3000);
+    check_buffered<interval_map<int,int> >(64, 3000);
+    check_buffered<split_interval_map<int,int> >(7, 3000);
+    check_buffered<interval_map<int,int,neutron_enricher> >(16, 3000);
+    check_buffered<split_interval_map<int,int,neutron_enricher> >(16, 3000);
+    check_buffered<interval_map<int,itl::set<int> > >(16, 3000);
+    check_buffered<split_interval_map<int,itl::set<int> > >(5, 3000);
+}
+
+BOOST_AUTO_TEST_CASE(test_buffered_tiers)
+{
+    srand(107);
+    buffered<interval_map<int,int> > lazy(10);
+    interval_map<int,int> eager;
+    for(int idx = 0; idx < 5000; idx++)
+    {
+        interval<int> itv = rightopen_interval(idx * 3, idx * 3 + 2);
+        lazy += make_pair(itv, 1);
+        eager += make_pair(itv, 1);
+        // Run sizes at least halve from run to run
+        BOOST_CHECK(lazy.run_count() <= 16u);
+    }
+    BOOST_CHECK(lazy.container() == eager);
+    BOOST_CHECK_EQUAL(lazy.run_count(), 0u);
+
+    buffered<interval_map<int,int> > other;
+    other.swap(lazy);
+    BOOST_CHECK(lazy.empty());
+    BOOST_CHECK_EQUAL(other.iterative_size(), eager.iterative_size());
+    other.clear();
+    BOOST_CHECK(other.empty());
+
+    // Runs, whose values cancel out, are dropped
+    buffered<interval_map<int,int> > cancelled(4);
+    for(int idx = 0; idx < 1000; idx++)
+    {
+        cancelled += make_pair(rightopen_interval(idx, idx + 3), 1);
+        cancelled += make_pair(rightopen_interval(idx, idx + 3), -1);
+        BOOST_CHECK_EQUAL(cancelled.run_count(), 0u);
+    }
+    BOOST_CHECK(cancelled.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_buffered_overlapping_log)
+{
+    // Logs of many overlapping pairs are merged from chains of disjoint pairs
+    srand(113);
+    for(int capacity = 1; capacity <= 300; capacity += 37)
+    {
+        buffered<interval_map<int,int> > lazy(capacity);
+        interval_map<int,int> eager;
+        for(int idx = 0; idx < 2000; idx++)
+        {
+            interval<int> itv = random_interval(100, 60);
+            lazy += make_pair(itv, 1);
+            eager += make_pair(itv, 1);
+        }
+        BOOST_CHECK(lazy.container() == eager);
+    }
+}
@@ -0,0 +1,144 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::date_domains unit test
+#include <stdlib.h>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+// Interval maps of dates and ptimes are the reference for the adapters,
+// so gregorian.hpp and ptime.hpp have to come first
+#include <boost/itl/gregorian.hpp>
+#include <boost/itl/ptime.hpp>
+#include <boost/itl/gregorian_grid.hpp>
+#include <boost/itl/day_number.hpp>
+#include <boost/itl/tick_number.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+using namespace boost::gregorian;
+using namespace boost::posix_time;
+
+BOOST_AUTO_TEST_CASE(test_day_number_values)
+{
+    BOOST_CHECK_EQUAL(day_number(date(1970,1,1)).days(), 0);
+    BOOST_CHECK_EQUAL(day_number(date(1970,2,1)).days(), 31);
+    BOOST_CHECK_EQUAL(day_number(date(1969,12,31)).days(), -1);
+
+    date some_day(2008,2,28);
+    day_number day = some_day;
+    BOOST_CHECK_EQUAL(day.to_date(), some_day);
+    BOOST_CHECK_EQUAL((++day).to_date(), date(2008,2,29));
+    BOOST_CHECK_EQUAL((day + 2).to_date(), date(2008,3,2));
+    BOOST_CHECK_EQUAL(day_number(date(2009,1,1)) - day_number(date(2008,1,1)), 366L);
+    BOOST_CHECK(day_number(date(2008,1,1)) < date(2008,1,2));
+    BOOST_CHECK_EQUAL(day.as_string(), to_simple_string(date(2008,2,29)));
+
+    interval<day_number> days = rightopen_interval<day_number>(date(2008,1,1), date(2008,2,1));
+    BOOST_CHECK_EQUAL(days.length(), 31L);
+    BOOST_CHECK_EQUAL(days.last().to_date(), date(2008,1,31));
+    BOOST_CHECK_EQUAL(interval_cast<date>(days), rightopen_interval(date(2008,1,1), date(2008,2,1)));
+    BOOST_CHECK_EQUAL(interval_cast<day_number>(interval_cast<date>(days)), days);
+    BOOST_CHECK(interval_cast<date>(interval<day_number>()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_tick_number_values)
+{
+    ptime epoch(date(1970,1,1));
+    BOOST_CHECK_EQUAL(tick_number(epoch).ticks(), 0);
+    BOOST_CHECK_EQUAL(tick_number(epoch + seconds(2)).ticks(), 2 * tick_number::ticks_per_second());
+
+    ptime some_time(date(2008,10,31), hours(23) + minutes(59) + seconds(59));
+    tick_number time = some_time;
+    BOOST_CHECK_EQUAL(time.to_ptime(), some_time);
+    BOOST_CHECK_EQUAL((time + tick_number::ticks_per_second()).to_ptime(), ptime(date(2008,11,1)));
+    BOOST_CHECK_EQUAL((--time).to_ptime(), some_time - time_duration::unit());
+    BOOST_CHECK_EQUAL(time.as_string(), to_simple_string(some_time - time_duration::unit()));
+
+    interval<ptime> hour = rightopen_interval(some_time, some_time + hours(1));
+    BOOST_CHECK_EQUAL(interval_cast<tick_number>(hour).length(), 3600 * tick_number::ticks_per_second());
+    BOOST_CHECK_EQUAL(interval_cast<ptime>(interval_cast<tick_number>(hour)), hour);
+}
+
+// Adapters and boost date types have to yield the same segments
+template <class DomainT, class AdaptedMapT, class MapT>
+bool equal_segments(const AdaptedMapT& adapted, const MapT& reference)
+{
+    if(adapted.iterative_size() != reference.iterative_size())
+        return false;
+    typename MapT::const_iterator ref_ = reference.begin();
+    const_FORALL(typename AdaptedMapT, it_, adapted)
+    {
+        if(!(interval_cast<DomainT>((*it_).KEY_VALUE) == (*ref_).KEY_VALUE
+             && (*it_).CONT_VALUE == (*ref_).CONT_VALUE))
+            return false;
+        ++ref_;
+    }
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(test_day_number_maps)
+{
+    srand(43);
+    date origin(2008,1,1);
+    interval_map<date,int>       dates;
+    interval_map<day_number,int> days;
+    for(int step = 0; step < 500; step++)
+    {
+        date lower = origin + gregorian::days(rand() % 400);
+        interval<date> period = rightopen_interval(lower, lower + gregorian::days(1 + rand() % 60));
+        int value = 1 + rand() % 3;
+        if(rand() % 4 == 0)
+        {
+            dates.subtract(make_pair(period, value));
+            days.subtract(make_pair(interval_cast<day_number>(period), value));
+        }
+        else
+        {
+            dates.add(make_pair(period, value));
+            days.add(make_pair(interval_cast<day_number>(period), value));
+        }
+    }
+    BOOST_CHECK((equal_segments<date>(days, dates)));
+}
+
+BOOST_AUTO_TEST_CASE(test_tick_number_maps)
+{
+    srand(47);
+    ptime origin(date(2008,10,31));
+    interval_map<ptime,int>       times;
+    interval_map<tick_number,int> ticks;
+    for(int step = 0; step < 500; step++)
+    {
+        ptime lower = origin + minutes(rand() % 600);
+        interval<ptime> period = rightopen_interval(lower, lower + minutes(1 + rand() % 90));
+        times += make_pair(period, 1);
+        ticks += make_pair(interval_cast<tick_number>(period), 1);
+    }
+    BOOST_CHECK((equal_segments<ptime>(ticks, times)));
+}
+
+BOOST_AUTO_TEST_CASE(test_day_number_grids)
+{
+    // A regular grid of 7 days starting on a Monday is the grid of iso weeks
+    split_interval_map<date,int>       dates;
+    split_interval_map<day_number,int> days;
+    interval<date> period = rightopen_interval(date(2008,1,3), date(2008,4,17));
+    dates += make_pair(period, 1);
+    days += make_pair(interval_cast<day_number>(period), 1);
+
+    dates *= iso_week_grid();
+    days *= regular_grid<day_number>(date(2008,1,7), 7);
+
+    BOOST_CHECK_EQUAL(days.iterative_size(), dates.iterative_size());
+    BOOST_CHECK((equal_segments<date>(days, dates)));
+}
+
@@ -0,0 +1,146 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::fingerprint unit test
+#include <stdlib.h>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include "../test_value_maker.hpp"
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/separate_interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/fingerprinted.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+template <class SetT> void random_set_update(fingerprinted<SetT>& object)
+{
+    switch(rand() % 5)
+    {
+    case 0:  object.subtract(random_interval(300, 20)); break;
+    case 1:  object -= rand() % 300;                    break;
+    case 2:  object.add(rand() % 300);                  break;
+    default: object += random_interval(300, 10);
+    }
+}
+
+template <class MapT> void random_map_update(fingerprinted<MapT>& object)
+{
+    int value = rand() % 3;
+    switch(rand() % 6)
+    {
+    case 0:  object.subtract(make_pair(random_interval(300, 20), value)); break;
+    case 1:  object.insert(make_pair(random_interval(300, 10), value));   break;
+    case 2:  object.erase(random_interval(300, 20));                     break;
+    case 3:  object.erase(rand() % 300);                                 break;
+    default: object += make_pair(random_interval(300, 10), value);
+    }
+}
+
+template <class SetT> void check_set_fingerprints()
+{
+    fingerprinted<SetT> object, other;
+    for(int step = 0; step < 2000; step++)
+    {
+        random_set_update(object);
+        BOOST_CHECK_EQUAL(object.fingerprint(), fingerprint(object.container()));
+    }
+
+    // Equal contents have equal fingerprints, whatever their histories
+    fingerprinted<SetT> copied(object.container());
+    BOOST_CHECK_EQUAL(copied.fingerprint(), object.fingerprint());
+    BOOST_CHECK(copied == object);
+    copied += random_interval(300, 10);
+    other += copied.container();
+    BOOST_CHECK_EQUAL(other.fingerprint(), fingerprint(other.container()));
+    BOOST_CHECK(copied.container() == object.container() || copied.fingerprint() != object.fingerprint());
+
+    other.swap(object);
+    BOOST_CHECK_EQUAL(object.fingerprint(), fingerprint(object.container()));
+    BOOST_CHECK_EQUAL(other.fingerprint(), fingerprint(other.container()));
+    object.clear();
+    BOOST_CHECK_EQUAL(object.fingerprint(), 0u);
+}
+
+template <class MapT> void check_map_fingerprints()
+{
+    fingerprinted<MapT> object;
+    for(int step = 0; step < 2000; step++)
+    {
+        random_map_update(object);
+        BOOST_CHECK_EQUAL(object.fingerprint(), fingerprint(object.container()));
+    }
+
+    fingerprinted<MapT> other;
+    other += object.container();
+    BOOST_CHECK_EQUAL(other.fingerprint(), fingerprint(other.container()));
+    other -= object.container();
+    BOOST_CHECK_EQUAL(other.fingerprint(), fingerprint(other.container()));
+}
+
+BOOST_AUTO_TEST_CASE(test_fingerprints)
+{
+    srand(73);
+    check_set_fingerprints<interval_set<int> >();
+    check_set_fingerprints<separate_interval_set<int> >();
+    check_set_fingerprints<split_interval_set<int> >();
+    check_map_fingerprints<interval_map<int,int> >();
+    check_map_fingerprints<split_interval_map<int,int> >();
+    check_map_fingerprints<interval_map<int,int,neutron_enricher> >();
+
+    interval_map<int,int> left, right;
+    left.add(make_pair(rightopen_interval(1,3), 1));
+    right.add(make_pair(rightopen_interval(1,3), 2));
+    BOOST_CHECK(fingerprint(left) != fingerprint(right));
+    right.subtract(make_pair(rightopen_interval(1,3), 1));
+    BOOST_CHECK_EQUAL(fingerprint(left), fingerprint(right));
+}
+
+// Reference: Comparison of copies after absorbing neutrons
+template <class MapT>
+bool copied_protonic_equal(const MapT& left, const MapT& right)
+{
+    MapT left0 = left, right0 = right;
+    left0.absorb_neutrons();
+    right0.absorb_neutrons();
+    return left0 == right0;
+}
+
+template <class MapT> void check_protonic_equality()
+{
+    for(int run = 0; run < 300; run++)
+    {
+        MapT left, right;
+        for(int idx = 0; idx < rand() % 8; idx++)
+        {
+            interval<int> itv = random_interval(30, 6);
+            int value = rand() % 2;
+            left.add(make_pair(itv, value));
+            if(rand() % 4 != 0)
+                right.add(make_pair(itv, value));
+        }
+        if(rand() % 3 == 0)
+            right.insert(make_pair(random_interval(40, 4), 0));
+        BOOST_CHECK_EQUAL(is_protonic_equal(left, right), copied_protonic_equal(left, right));
+        BOOST_CHECK_EQUAL(is_protonic_equal(right, left), copied_protonic_equal(left, right));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_protonic_equality)
+{
+    srand(79);
+    check_protonic_equality<interval_map<int,int,neutron_enricher> >();
+    check_protonic_equality<split_interval_map<int,int,neutron_enricher> >();
+    check_protonic_equality<interval_map<int,int> >();
+}
+
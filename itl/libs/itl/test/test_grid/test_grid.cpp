@@ -0,0 +1,195 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::grid unit test
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+// gregorian_grid.hpp includes gregorian.hpp and has to come first
+#include <boost/itl/gregorian_grid.hpp>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+using namespace boost::gregorian;
+
+typedef split_interval_map<int,int> SplitMapT;
+
+SplitMapT random_map(int count)
+{
+    SplitMapT object;
+    for(int idx = 0; idx < count; idx++)
+    {
+        int lower = rand() % 100 - 50;
+        object.add(std::make_pair(rightopen_interval(lower, lower + 1 + rand() % 20), 1 + rand() % 3));
+    }
+    return object;
+}
+
+// A materialized grid is the reference for the lazy ones
+split_interval_set<int> materialized_grid(int origin, int step, const interval<int>& scope)
+{
+    split_interval_set<int> grid;
+    int border = origin - ((origin - scope.first()) / step + 1) * step;
+    for(; border <= scope.last(); border += step)
+        grid += rightopen_interval(border, border + step);
+    return grid;
+}
+
+BOOST_AUTO_TEST_CASE(regular_grid_borders)
+{
+    regular_grid<int> grid(3, 5);
+    BOOST_CHECK_EQUAL(grid.next_border(3),  8);
+    BOOST_CHECK_EQUAL(grid.next_border(7),  8);
+    BOOST_CHECK_EQUAL(grid.next_border(-2), 3);
+    BOOST_CHECK_EQUAL(grid.next_border(-3), -2);
+    BOOST_CHECK_EQUAL(grid.next_border(-7), -2);
+    BOOST_CHECK_EQUAL(grid.cell(-4), rightopen_interval(-7, -2));
+
+    regular_grid<double> real_grid(0.5, 0.25);
+    BOOST_CHECK_EQUAL(real_grid.next_border(0.5),  0.75);
+    BOOST_CHECK_EQUAL(real_grid.next_border(0.3),  0.5);
+    BOOST_CHECK_EQUAL(real_grid.next_border(-0.1), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(split_by_grid_equals_intersection_with_materialized_grid)
+{
+    srand(2008);
+    for(int run = 0; run < 50; run++)
+    {
+        SplitMapT source = random_map(1 + rand() % 12);
+        int origin = rand() % 20 - 10, step = 1 + rand() % 9;
+        regular_grid<int> grid(origin, step);
+
+        SplitMapT expected = source;
+        expected *= materialized_grid(origin, step, rightopen_interval(-60, 80));
+
+        SplitMapT result;
+        split_by_grid(result, source, grid);
+        BOOST_CHECK_EQUAL(result.as_string(), expected.as_string());
+
+        SplitMapT in_place = source;
+        in_place *= grid;
+        BOOST_CHECK_EQUAL(in_place.as_string(), expected.as_string());
+
+        SplitMapT section;
+        source.intersect(section, grid);
+        BOOST_CHECK_EQUAL(section.as_string(), expected.as_string());
+
+        // A joining result is split at grid borders only where values change
+        interval_map<int,int> joined;
+        split_by_grid(joined, source, grid);
+        BOOST_CHECK(is_element_equal(joined, source));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(split_interval_sets_by_grid)
+{
+    interval_set<int> source;
+    source.add(closed_interval(2, 11)).add(rightopen_interval(20, 23));
+
+    split_interval_set<int> result;
+    split_by_grid(result, source, regular_grid<int>(0, 5));
+
+    split_interval_set<int> expected;
+    expected.add(rightopen_interval(2, 5)).add(rightopen_interval(5, 10))
+            .add(closed_interval(10, 11)).add(rightopen_interval(20, 23));
+    BOOST_CHECK_EQUAL(result.as_string(), expected.as_string());
+}
+
+BOOST_AUTO_TEST_CASE(grid_iterator_yields_clipped_cells)
+{
+    regular_grid<int> grid(0, 10);
+    std::vector<interval<int> > cells(grid_begin(grid, closed_interval(5, 31)), grid_end(grid));
+    BOOST_CHECK_EQUAL(cells.size(), 4u);
+    BOOST_CHECK_EQUAL(cells[0], rightopen_interval(5, 10));
+    BOOST_CHECK_EQUAL(cells[1], rightopen_interval(10, 20));
+    BOOST_CHECK_EQUAL(cells[3], closed_interval(30, 31));
+
+    BOOST_CHECK(grid_begin(grid, interval<int>()) == grid_end(grid));
+}
+
+// The month and week grids of the month_and_week_grid example
+typedef split_interval_set<date> date_grid;
+
+date_grid materialized_month_grid(const interval<date>& scope)
+{
+    date_grid grid;
+    date frame_months_1st = scope.first().end_of_month() + days(1) - months(1);
+    for(month_iterator month_iter(frame_months_1st); month_iter <= scope.last(); ++month_iter)
+        grid += rightopen_interval(*month_iter, *month_iter + months(1));
+    grid *= scope;
+    return grid;
+}
+
+date_grid materialized_week_grid(const interval<date>& scope)
+{
+    date_grid grid;
+    date frame_weeks_1st = scope.first()
+        + days(days_until_weekday(scope.first(), greg_weekday(Monday))) - weeks(1);
+    for(week_iterator week_iter(frame_weeks_1st); week_iter <= scope.last(); ++week_iter)
+        grid.insert(rightopen_interval(*week_iter, *week_iter + weeks(1)));
+    grid *= scope;
+    return grid;
+}
+
+BOOST_AUTO_TEST_CASE(calendar_grid_borders)
+{
+    month_grid months_;
+    BOOST_CHECK_EQUAL(months_.next_border(date(2008,Jan,1)),  date(2008,Feb,1));
+    BOOST_CHECK_EQUAL(months_.next_border(date(2008,Dec,31)), date(2009,Jan,1));
+    BOOST_CHECK_EQUAL(months_.cell(date(2008,Feb,29)),
+                      rightopen_interval(date(2008,Feb,1), date(2008,Mar,1)));
+
+    month_grid quarters(3);
+    BOOST_CHECK_EQUAL(quarters.next_border(date(2008,Feb,14)), date(2008,Apr,1));
+    BOOST_CHECK_EQUAL(quarters.next_border(date(2008,Nov,1)),  date(2009,Jan,1));
+
+    iso_week_grid weeks_;
+    BOOST_CHECK_EQUAL(weeks_.next_border(date(2008,Oct,27)), date(2008,Nov,3)); // Monday
+    BOOST_CHECK_EQUAL(weeks_.next_border(date(2008,Nov,2)),  date(2008,Nov,3)); // Sunday
+    BOOST_CHECK_EQUAL(weeks_.cell(date(2008,Oct,30)),
+                      rightopen_interval(date(2008,Oct,27), date(2008,Nov,3)));
+
+    regular_grid<date> fortnights(date(2008,Jan,7), days(14));
+    BOOST_CHECK_EQUAL(fortnights.next_border(date(2008,Jan,7)), date(2008,Jan,21));
+    BOOST_CHECK_EQUAL(fortnights.next_border(date(2007,Dec,31)), date(2008,Jan,7));
+    BOOST_CHECK_EQUAL(fortnights.next_border(date(2007,Dec,23)), date(2007,Dec,24));
+}
+
+BOOST_AUTO_TEST_CASE(month_and_week_grid)
+{
+    date someday(2008,Jun,22);
+    for(int shift = 0; shift < 400; shift += 37)
+    {
+        interval<date> scope = rightopen_interval(someday + days(shift), someday + days(shift) + months(2));
+
+        date_grid expected = materialized_month_grid(scope);
+        expected *= materialized_week_grid(scope);
+
+        date_grid result;
+        result += scope;
+        result *= merge_grids(month_grid(), iso_week_grid());
+        BOOST_CHECK(result == expected);
+
+        std::vector<interval<date> > cells(grid_begin(merge_grids(month_grid(), iso_week_grid()), scope),
+                                           grid_iterator<merged_grid<month_grid,iso_week_grid> >());
+        BOOST_CHECK_EQUAL(cells.size(), expected.iterative_size());
+    }
+
+    BOOST_CHECK_EQUAL(merge_grids(month_grid(), iso_week_grid()).cell(date(2008,Jul,31)),
+                      rightopen_interval(date(2008,Jul,28), date(2008,Aug,1)));
+    BOOST_CHECK_EQUAL(merge_grids(month_grid(), iso_week_grid()).cell(date(2008,Aug,1)),
+                      rightopen_interval(date(2008,Aug,1), date(2008,Aug,4)));
+}
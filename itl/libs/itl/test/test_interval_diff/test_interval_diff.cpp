@@ -0,0 +1,198 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::interval_diff unit test
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <boost/test/unit_test.hpp>
+#include "../test_value_maker.hpp"
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/separate_interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/interval_diff.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+template <class SetT> void random_set_fill(SetT& object)
+{
+    for(int idx = 0; idx < rand() % 20; idx++)
+        object += random_interval(100, 12);
+}
+
+template <class MapT> void random_map_fill(MapT& object)
+{
+    for(int idx = 0; idx < rand() % 20; idx++)
+        object += make_pair(random_interval(100, 12), rand() % 3);
+}
+
+// Reference: Coverage and value of an element by a linear scan of the segments
+template <class IntervalT>
+bool covers(const IntervalT& segment, int x, bool& value)
+{ value = true; return segment.contains(x); }
+
+template <class IntervalT, class CodomainT>
+bool covers(const std::pair<IntervalT, CodomainT>& segment, int x, CodomainT& value)
+{ value = segment.second; return segment.first.contains(x); }
+
+template <class ContainerT, class CodomainT>
+bool value_at(const ContainerT& object, int x, CodomainT& value)
+{
+    for(typename ContainerT::const_iterator it_ = object.begin(); it_ != object.end(); ++it_)
+        if(covers(*it_, x, value))
+            return true;
+    value = CodomainT();
+    return false;
+}
+
+template <class ContainerT, class ChangesT>
+void check_changes(const ContainerT& old_object, const ContainerT& new_object, const ChangesT& changes)
+{
+    typedef typename ChangesT::value_type change_type;
+    typedef typename change_type::codomain_type codomain_type;
+
+    // Changes are ascending, proper and maximal
+    for(typename ChangesT::const_iterator it_ = changes.begin(); it_ != changes.end(); ++it_)
+    {
+        BOOST_CHECK(!(*it_).range.empty());
+        BOOST_CHECK((*it_).was_covered != (*it_).is_covered || !((*it_).old_value == (*it_).new_value));
+        if(it_ != changes.begin())
+        {
+            const change_type& pred = *(it_ - 1);
+            BOOST_CHECK(pred.range.exclusive_less((*it_).range));
+            BOOST_CHECK(!(pred.range.touches((*it_).range) && pred.same_transition(*it_)));
+        }
+    }
+
+    // Elements are changed, iff they are in the range of a change
+    for(int x = -2; x < 120; x++)
+    {
+        codomain_type old_value, new_value;
+        bool was_covered = value_at(old_object, x, old_value);
+        bool is_covered  = value_at(new_object, x, new_value);
+        const change_type* found = 0;
+        for(typename ChangesT::const_iterator it_ = changes.begin(); it_ != changes.end(); ++it_)
+            if((*it_).range.contains(x))
+                found = &*it_;
+
+        if(was_covered == is_covered && old_value == new_value)
+            BOOST_CHECK(found == 0);
+        else
+        {
+            BOOST_REQUIRE(found != 0);
+            BOOST_CHECK_EQUAL(found->was_covered, was_covered);
+            BOOST_CHECK_EQUAL(found->is_covered,  is_covered);
+            BOOST_CHECK(found->old_value == old_value);
+            BOOST_CHECK(found->new_value == new_value);
+        }
+    }
+}
+
+template <class SetT> void check_set_diff()
+{
+    typedef typename Diff::traits<SetT>::change_type change_type;
+    for(int run = 0; run < 200; run++)
+    {
+        SetT old_object, new_object;
+        random_set_fill(old_object);
+        new_object = old_object;
+        random_set_fill(new_object);
+        for(int idx = 0; idx < rand() % 4; idx++)
+            new_object -= random_interval(100, 20);
+
+        std::vector<change_type> changes;
+        diff(old_object, new_object, std::back_inserter(changes));
+        check_changes(old_object, new_object, changes);
+
+        SetT patched = old_object;
+        patch(patched, changes.begin(), changes.end());
+        BOOST_CHECK(is_element_equal(patched, new_object));
+
+        std::vector<change_type> none;
+        diff(new_object, new_object, std::back_inserter(none));
+        BOOST_CHECK(none.empty());
+    }
+}
+
+template <class MapT> void check_map_diff()
+{
+    typedef typename Diff::traits<MapT>::change_type change_type;
+    for(int run = 0; run < 200; run++)
+    {
+        MapT old_object, new_object;
+        random_map_fill(old_object);
+        new_object = old_object;
+        random_map_fill(new_object);
+        for(int idx = 0; idx < rand() % 4; idx++)
+            new_object.erase(random_interval(100, 20));
+
+        std::vector<change_type> changes;
+        diff(old_object, new_object, std::back_inserter(changes));
+        check_changes(old_object, new_object, changes);
+
+        MapT patched = old_object;
+        patch(patched, changes.begin(), changes.end());
+        BOOST_CHECK(is_element_equal(patched, new_object));
+
+        std::vector<change_type> none;
+        diff(new_object, new_object, std::back_inserter(none));
+        BOOST_CHECK(none.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_set_diff)
+{
+    srand(83);
+    check_set_diff<interval_set<int> >();
+    check_set_diff<separate_interval_set<int> >();
+    check_set_diff<split_interval_set<int> >();
+}
+
+BOOST_AUTO_TEST_CASE(test_map_diff)
+{
+    srand(89);
+    check_map_diff<interval_map<int,int> >();
+    check_map_diff<split_interval_map<int,int> >();
+    check_map_diff<interval_map<int,int,neutron_enricher> >();
+    check_map_diff<split_interval_map<int,int,neutron_enricher> >();
+}
+
+BOOST_AUTO_TEST_CASE(test_diff_of_segmentations)
+{
+    typedef Diff::traits<split_interval_map<int,int> >::change_type change_type;
+    split_interval_map<int,int> split_map;
+    split_map.add(make_pair(rightopen_interval(1,4), 1))
+             .add(make_pair(rightopen_interval(4,8), 1))
+             .add(make_pair(rightopen_interval(8,9), 2));
+
+    // Splitting does not change contents
+    interval_map<int,int> joined_map;
+    joined_map.add(make_pair(rightopen_interval(1,8), 1))
+              .add(make_pair(rightopen_interval(8,9), 2));
+    std::vector<change_type> changes;
+    diff(split_map, joined_map, std::back_inserter(changes));
+    BOOST_CHECK(changes.empty());
+
+    // Changes across split borders are coalesced
+    joined_map.add(make_pair(rightopen_interval(2,6), 1));
+    diff(split_map, joined_map, std::back_inserter(changes));
+    BOOST_CHECK_EQUAL(changes.size(), 1u);
+    BOOST_CHECK(changes[0] == change_type(rightopen_interval(2,6), true, 1, true, 2));
+
+    interval_map<int,int> patched;
+    patched.add(make_pair(rightopen_interval(1,8), 1))
+           .add(make_pair(rightopen_interval(8,9), 2));
+    patch(patched, changes.begin(), changes.end());
+    BOOST_CHECK(patched == joined_map);
+}
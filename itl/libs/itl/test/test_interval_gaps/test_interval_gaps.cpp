@@ -0,0 +1,150 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::interval_gaps unit test
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <boost/test/unit_test.hpp>
+#include "../test_value_maker.hpp"
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/interval_gaps.hpp>
+#include <boost/itl/gap_indexed_set.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+typedef interval<int>          IntervalT;
+typedef std::vector<IntervalT> IntervalsT;
+
+// The complement within the window is the reference for gap queries
+template <class ContainerT>
+IntervalsT complement_gaps(const ContainerT& object, const IntervalT& window)
+{
+    interval_set<int> free_set;
+    free_set += window;
+    for(typename ContainerT::const_iterator it_ = object.begin(); it_ != object.end(); ++it_)
+        free_set -= Gap::segment_interval(*it_);
+    return IntervalsT(free_set.begin(), free_set.end());
+}
+
+IntervalT expected_first(const IntervalsT& free_intervals, int min_length)
+{
+    for(IntervalsT::const_iterator it_ = free_intervals.begin(); it_ != free_intervals.end(); ++it_)
+        if(min_length <= (*it_).length())
+            return *it_;
+    return IntervalT();
+}
+
+IntervalT expected_largest(const IntervalsT& free_intervals)
+{
+    IntervalT largest;
+    for(IntervalsT::const_iterator it_ = free_intervals.begin(); it_ != free_intervals.end(); ++it_)
+        if(largest.empty() || largest.length() < (*it_).length())
+            largest = *it_;
+    return largest;
+}
+
+template <class ContainerT>
+void check_gap_queries(const ContainerT& object, const IntervalT& window)
+{
+    IntervalsT expected = complement_gaps(object, window);
+    IntervalsT found;
+    gaps(object, window, std::back_inserter(found));
+    BOOST_CHECK(found == expected);
+    BOOST_CHECK_EQUAL(largest_gap(object, window), expected_largest(expected));
+    for(int min_length = 1; min_length < 12; min_length += 3)
+        BOOST_CHECK_EQUAL(first_gap(object, window, min_length), expected_first(expected, min_length));
+}
+
+template <class GapIndexedSetT>
+void check_indexed_queries(const GapIndexedSetT& object, const IntervalT& window)
+{
+    IntervalsT expected = complement_gaps(object.intervals(), window);
+    IntervalsT found;
+    object.gaps(window, std::back_inserter(found));
+    BOOST_CHECK(found == expected);
+    BOOST_CHECK_EQUAL(object.largest_gap(window), expected_largest(expected));
+    for(int min_length = 1; min_length < 12; min_length += 3)
+        BOOST_CHECK_EQUAL(object.first_gap(window, min_length), expected_first(expected, min_length));
+}
+
+BOOST_AUTO_TEST_CASE(test_gap_queries)
+{
+    srand(37);
+    for(int run = 0; run < 100; run++)
+    {
+        interval_set<int>       busy;
+        split_interval_set<int> split_busy;
+        interval_map<int,int>   bookings;
+        for(int idx = 0; idx < rand() % 30; idx++)
+        {
+            IntervalT itv = random_rightopen_interval(200, 10);
+            busy += itv;
+            split_busy += itv;
+            bookings += make_pair(itv, 1);
+        }
+        for(int query = 0; query < 10; query++)
+        {
+            IntervalT window = random_rightopen_interval(220, 100);
+            check_gap_queries(busy, window);
+            check_gap_queries(split_busy, window);
+            check_gap_queries(bookings, window);
+        }
+        if(!busy.empty())
+            BOOST_CHECK_EQUAL(largest_gap(busy), expected_largest(
+                complement_gaps(busy, rightopen_interval(busy.lower(), busy.upper()))));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_gap_indexed_set)
+{
+    srand(41);
+    gap_indexed_set<interval_set<int> > busy;
+    gap_indexed_set<split_interval_set<int> > split_busy;
+    for(int step = 0; step < 2000; step++)
+    {
+        IntervalT itv = random_rightopen_interval(1000, 12);
+        if(rand() % 3 == 0)
+        {
+            busy -= itv;
+            split_busy -= itv;
+        }
+        else
+        {
+            busy += itv;
+            split_busy += itv;
+        }
+
+        if(step % 20 == 0)
+        {
+            IntervalT window = random_rightopen_interval(1100, 300);
+            check_indexed_queries(busy, window);
+            check_indexed_queries(split_busy, window);
+
+            IntervalsT between;
+            if(!busy.empty())
+                gaps(busy.intervals(), rightopen_interval(busy.intervals().lower(), busy.intervals().upper()),
+                     std::back_inserter(between));
+            BOOST_CHECK_EQUAL(busy.gap_count(), between.size());
+            BOOST_CHECK_EQUAL(busy.largest_gap(), expected_largest(between));
+        }
+    }
+
+    gap_indexed_set<interval_set<int> > copied = busy;
+    busy.clear();
+    BOOST_CHECK_EQUAL(busy.gap_count(), 0u);
+    BOOST_CHECK(copied.gap_count() > 0);
+    check_indexed_queries(copied, rightopen_interval(-10, 1200));
+}
+
@@ -0,0 +1,176 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::interval_join unit test
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/interval_join.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+typedef interval<int>                  IntervalT;
+typedef std::pair<IntervalT, int>      SegmentT;
+
+std::string element_string(const IntervalT& itv) { return itv.as_string(); }
+
+template <class IntervalT, class CodomainT>
+std::string element_string(const std::pair<IntervalT, CodomainT>& segment)
+{ return segment.first.as_string() + "->" + itl::to_string<CodomainT>::apply(segment.second); }
+
+// Records the joined triples as strings
+struct recorder
+{
+    recorder(): _triples(new std::vector<std::string>) {}
+
+    template <class LeftT, class RightT>
+    void operator()(const LeftT& left, const RightT& right, const IntervalT& overlap)
+    { _triples->push_back(element_string(left) + " " + element_string(right) + " " + overlap.as_string()); }
+
+    std::vector<std::string> sorted()const
+    {
+        std::vector<std::string> triples = *_triples;
+        std::sort(triples.begin(), triples.end());
+        return triples;
+    }
+
+    boost::shared_ptr<std::vector<std::string> > _triples;
+};
+
+// Comparing all pairs is the reference for the join
+template <class LeftIteratorT, class RightIteratorT>
+std::vector<std::string> nested_loop_join(LeftIteratorT left_first, LeftIteratorT left_past,
+                                          RightIteratorT right_first, RightIteratorT right_past)
+{
+    recorder joined;
+    for(LeftIteratorT left_ = left_first; left_ != left_past; ++left_)
+        for(RightIteratorT right_ = right_first; right_ != right_past; ++right_)
+        {
+            IntervalT overlap = Join::key_interval(*left_).intersect(Join::key_interval(*right_));
+            if(!overlap.empty())
+                joined(*left_, *right_, overlap);
+        }
+    return joined.sorted();
+}
+
+struct lower_less_segment
+{
+    bool operator()(const SegmentT& lhs, const SegmentT& rhs)const
+    { return lhs.first.lower_less(rhs.first); }
+};
+
+void random_bookings(std::vector<IntervalT>& bookings, std::vector<SegmentT>& tariffs)
+{
+    for(int idx = 0; idx < rand() % 80; idx++)
+    {
+        int lower = rand() % 200;
+        bookings.push_back(rand() % 2 == 0 ? rightopen_interval(lower, lower + rand() % 30)
+                                           : closed_interval(lower, lower + rand() % 30));
+        tariffs.push_back(SegmentT(rightopen_interval(lower / 2, lower / 2 + rand() % 15), rand() % 4));
+    }
+    std::sort(bookings.begin(), bookings.end(), lower_less<IntervalT>());
+    std::sort(tariffs.begin(), tariffs.end(), lower_less_segment());
+}
+
+BOOST_AUTO_TEST_CASE(test_interval_join_sorted_ranges)
+{
+    srand(29);
+    for(int run = 0; run < 200; run++)
+    {
+        std::vector<IntervalT> bookings;
+        std::vector<SegmentT>  tariffs;
+        random_bookings(bookings, tariffs);
+
+        recorder joined = interval_join(bookings.begin(), bookings.end(),
+                                        tariffs.begin(), tariffs.end(), recorder());
+        BOOST_CHECK(joined.sorted() == nested_loop_join(bookings.begin(), bookings.end(),
+                                                        tariffs.begin(), tariffs.end()));
+
+        // Every left element of a part is joined by the callback of its part
+        std::vector<recorder> parts;
+        for(int part = 0; part <= run % 5; part++)
+            parts.push_back(recorder());
+        partitioned_interval_join(bookings.begin(), bookings.end(),
+                                  tariffs.begin(), tariffs.end(), parts);
+        recorder merged;
+        for(std::size_t part = 0; part < parts.size(); part++)
+            merged._triples->insert(merged._triples->end(),
+                                    parts[part]._triples->begin(), parts[part]._triples->end());
+        BOOST_CHECK(merged.sorted() == joined.sorted());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_interval_join_containers)
+{
+    srand(31);
+    for(int run = 0; run < 100; run++)
+    {
+        std::vector<IntervalT> bookings;
+        std::vector<SegmentT>  tariffs;
+        random_bookings(bookings, tariffs);
+
+        interval_set<int>       booked;
+        interval_map<int,int>   tariff_map;
+        split_interval_map<int,int> split_tariffs;
+        for(std::size_t idx = 0; idx < bookings.size(); idx++)
+        {
+            booked += bookings[idx];
+            tariff_map += tariffs[idx];
+            split_tariffs += tariffs[idx];
+        }
+
+        recorder joined = interval_join(booked, tariff_map, recorder());
+        BOOST_CHECK(joined.sorted() == nested_loop_join(booked.begin(), booked.end(),
+                                                        tariff_map.begin(), tariff_map.end()));
+        joined = interval_join(split_tariffs.begin(), split_tariffs.end(),
+                               bookings.begin(), bookings.end(), recorder());
+        BOOST_CHECK(joined.sorted() == nested_loop_join(split_tariffs.begin(), split_tariffs.end(),
+                                                        bookings.begin(), bookings.end()));
+
+        std::vector<recorder> parts;
+        for(int part = 0; part < 3; part++)
+            parts.push_back(recorder());
+        partitioned_interval_join(booked, split_tariffs, parts);
+        std::size_t joined_count = 0;
+        for(std::size_t part = 0; part < parts.size(); part++)
+            joined_count += parts[part]._triples->size();
+        BOOST_CHECK_EQUAL(joined_count, nested_loop_join(booked.begin(), booked.end(),
+                                                         split_tariffs.begin(), split_tariffs.end()).size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_interval_join_writer)
+{
+    interval_set<int> booked;
+    booked.add(rightopen_interval(1,5)).add(rightopen_interval(8,12));
+    interval_map<int,int> tariffs;
+    tariffs.add(make_pair(rightopen_interval(0,3), 10));
+    tariffs.add(make_pair(rightopen_interval(3,10), 20));
+
+    typedef join_triple<IntervalT, SegmentT> TripleT;
+    std::vector<TripleT> triples;
+    interval_join(booked, tariffs, join_writer(std::back_inserter(triples)));
+
+    BOOST_CHECK_EQUAL(triples.size(), 3u);
+    BOOST_CHECK_EQUAL(triples[0].overlap, rightopen_interval(1,3));
+    BOOST_CHECK_EQUAL(triples[0].right.second, 10);
+    BOOST_CHECK_EQUAL(triples[1].overlap, rightopen_interval(3,5));
+    BOOST_CHECK_EQUAL(triples[2].left, rightopen_interval(8,12));
+    BOOST_CHECK_EQUAL(triples[2].overlap, rightopen_interval(8,10));
+    BOOST_CHECK_EQUAL(triples[2].right.second, 20);
+}
+
@@ -30,8 +30,8 @@ using namespace boost::itl;
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_ctor_4_ordered_types, T, ordered_types)
 {
     typedef int U;
-    typedef interval_map<T,U>       IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>       IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
 
     T v0 = neutron<T>::value();
     U u1 = unon<U>::value();
@@ -46,8 +46,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_ctor_4_ordered_types,
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_equal_4_ordered_types, T, ordered_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
 
     T v0 = neutron<T>::value();
     U u1 = unon<U>::value();
@@ -90,8 +90,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_equal_4_ordered_types,
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_assign_4_ordered_types, T, ordered_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
 
     T v0 = neutron<T>::value();
     T v1 = unon<T>::value();
@@ -121,8 +121,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_assign_4_ordered_types
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_ctor_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     U u1 = make<U>(1);
     T v1 = make<T>(1);
     T v2 = make<T>(2);
@@ -149,8 +149,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_ctor_4_bicremental_typ
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_assign_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     U u1 = make<U>(1);
 
     T v1 = make<T>(1);
@@ -179,8 +179,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_assign_4_bicremental_t
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_equal_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     U u1 = make<U>(1);
 
     T v1 = make<T>(1);
@@ -217,8 +217,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_equal_4_bicremental_ty
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_add_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     U u1 = make<U>(1);
 
     T v1 = make<T>(1);
@@ -259,8 +259,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_add_4_bicremental_type
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_subtract_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     U u1 = make<U>(1);
 
     T v0 = make<T>(0);
@@ -345,8 +345,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_subtract_4_bicremental
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_erase_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     U u1 = make<U>(1);
 
     T v0 = make<T>(0);
@@ -431,8 +431,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_erase_4_bicremental_ty
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_erase2_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     typedef interval_set<T>            IntervalSetT;
     typedef split_interval_set<T>    SplitIntervalSetT;
     U u1 = make<U>(1);
@@ -519,8 +519,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_erase2_4_bicremental_t
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_insert_erase_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     U u1 = make<U>(1);
 
     T v0 = make<T>(0);
@@ -610,8 +610,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_insert_erase_4_bicreme
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_insert_erase2_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>       IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>       IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     typedef interval_set<T>            IntervalSetT;
     typedef split_interval_set<T>   SplitIntervalSetT;
     U u1 = make<U>(1);
@@ -710,8 +710,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_insert_erase2_4_bicrem
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_basic_intersect_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     typedef interval_set<T>            IntervalSetT;
     typedef split_interval_set<T>    SplitIntervalSetT;
     U u1 = make<U>(1);
@@ -809,8 +809,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_basic_intersect_4_bicr
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_basic_intersect2_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     typedef interval_set<T>            IntervalSetT;
     typedef split_interval_set<T>    SplitIntervalSetT;
     U u1 = make<U>(1);
@@ -907,8 +907,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_basic_intersect2_4_bic
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_intersect_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     typedef interval_set<T>            IntervalSetT;
     typedef split_interval_set<T>    SplitIntervalSetT;
     U u1 = make<U>(1);
@@ -988,8 +988,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_intersect_4_bicrementa
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_intersect2_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     typedef interval_set<T>            IntervalSetT;
     typedef split_interval_set<T>    SplitIntervalSetT;
     U u1 = make<U>(1);
@@ -1068,8 +1068,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_intersect2_4_bicrement
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_disjoint_4_bicremental_types, T, bicremental_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>        IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>        IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     typedef interval_set<T>            IntervalSetT;
     typedef split_interval_set<T>    SplitIntervalSetT;
     U u1 = make<U>(1);
@@ -1129,8 +1129,8 @@ struct size_greater_1 : public itl::property<Type>
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_itl_interval_map_mixed_erase_if_4_integral_types, T, integral_types)
 {         
     typedef int U;
-    typedef interval_map<T,U>       IntervalMapT;
-    typedef split_interval_map<T,U> SplitIntervalMapT;
+    typedef interval_map<T,U,test_absorber>       IntervalMapT;
+    typedef split_interval_map<T,U,test_absorber> SplitIntervalMapT;
     typedef interval_set<T>         IntervalSetT;
     typedef split_interval_set<T>   SplitIntervalSetT;
     U u1 = make<U>(1);
@@ -11,7 +11,7 @@ Copyright (c) 2008-2008: Joachim Faulhaber
 #include <boost/type_traits/is_same.hpp>
 
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -158,7 +158,7 @@ void interval_map_fundamentals_4_ordered_types()
 }
 
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -219,7 +219,7 @@ void interval_map_ctor_4_bicremental_types()
 
 
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -272,7 +272,7 @@ void interval_map_add_sub_4_bicremental_types()
 }
 
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -303,7 +303,7 @@ void interval_map_distinct_4_bicremental_types()
 }
 
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -352,7 +352,7 @@ void interval_map_distinct_4_bicremental_continuous_types()
 }
 
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -403,7 +403,7 @@ void interval_map_isolate_4_bicremental_continuous_types()
 
 
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -445,7 +445,7 @@ void interval_map_contains_4_bicremental_types()
 }
 
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -507,7 +507,7 @@ void interval_map_operators_4_bicremental_types()
 
 // Test for nontrivial intersection of interval maps with intervals and values
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -618,7 +618,7 @@ void interval_map_base_intersect_4_bicremental_types()
 
 // Test for nontrivial erasure of interval maps with intervals and interval sets
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
@@ -733,7 +733,7 @@ void interval_map_base_erase_4_bicremental_types()
 
 // Test first_collision
 template <template<class T, class U,
-                   class Traits = neutron_absorber,
+                   class Traits = test_absorber,
                    template<class>class = interval,
                    template<class>class = std::less,
                    template<class>class = std::allocator
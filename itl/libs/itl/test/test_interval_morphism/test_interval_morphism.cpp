@@ -0,0 +1,115 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::interval_morphism unit test
+#define ITL_OPERATION_STATS
+#include <stdlib.h>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/separate_interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/interval_morphism.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+
+// Clustering element by element is the reference for the run aware cluster
+template <class IntervalContainerT, class ElementContainerT>
+void check_cluster(const ElementContainerT& elements)
+{
+    IntervalContainerT clustered, expected;
+    Interval::cluster(clustered, elements);
+    const_FORALL(typename ElementContainerT, element_, elements)
+        expected += IntervalContainerT::make_domain_element(
+                        ElementContainerT::key_value(element_), ElementContainerT::data_value(element_));
+
+    BOOST_CHECK_EQUAL(clustered.iterative_size(), expected.iterative_size());
+    BOOST_CHECK(clustered == expected);
+}
+
+// Elements in a few runs with values that change now and then
+void random_elements(itl::set<int>& element_set, itl::map<int,int>& element_map)
+{
+    int element = -50;
+    for(int idx = 0; idx < 400; idx++)
+    {
+        element += rand() % 8 == 0 ? 2 + rand() % 3 : 1;
+        element_set.insert(element);
+        element_map.insert(make_pair(element, 1 + rand() % 20 / 18));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_cluster_by_runs)
+{
+    srand(1);
+    for(int run = 0; run < 10; run++)
+    {
+        itl::set<int>      element_set;
+        itl::map<int,int>  element_map;
+        random_elements(element_set, element_map);
+
+        check_cluster<interval_set<int> >(element_set);
+        check_cluster<separate_interval_set<int> >(element_set);
+        check_cluster<split_interval_set<int> >(element_set);
+        check_cluster<interval_map<int,int> >(element_map);
+        check_cluster<split_interval_map<int,int> >(element_map);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_cluster_appends_runs)
+{
+    itl::map<int,int> element_map;
+    for(int element = 0; element < 1000; element++)
+        element_map.insert(make_pair(element, 1 + element / 100));
+
+    interval_map<int,int> clustered;
+    operation_stats_scope scope;
+    Interval::cluster(clustered, element_map);
+
+    BOOST_CHECK_EQUAL(clustered.iterative_size(), 10);
+    // Only the first run needs to search the map
+    BOOST_CHECK(scope.stats().searches() <= 2);
+    BOOST_CHECK_EQUAL(scope.stats().allocations(), 10);
+
+    itl::map<int,int> atomized;
+    Interval::atomize(atomized, clustered);
+    BOOST_CHECK(atomized == element_map);
+}
+
+BOOST_AUTO_TEST_CASE(test_element_iterator)
+{
+    interval_map<int,int> segments;
+    segments.add(make_pair(rightopen_interval(1,4), 1));
+    segments.add(make_pair(closed_interval(6,7), 2));
+    segments.add(make_pair(rightopen_interval(3,5), 1));
+
+    itl::map<int,int> expected;
+    Interval::atomize(expected, segments);
+
+    itl::map<int,int> streamed;
+    Interval::element_iterator<interval_map<int,int> > it_ = Interval::elements_begin(segments);
+    for(; it_ != Interval::elements_end(segments); ++it_)
+        streamed.insert(*it_);
+    BOOST_CHECK(streamed == expected);
+    BOOST_CHECK_EQUAL(streamed.size(), 6u);
+
+    split_interval_set<int> intervals;
+    intervals.add(closed_interval(-3,-1)).add(closed_interval(-1,2)).add(5);
+    int elements[] = { -3, -2, -1, 0, 1, 2, 5 };
+    BOOST_CHECK(std::equal(elements, elements + 7, Interval::elements_begin(intervals)));
+
+    interval_set<int> empty_set;
+    BOOST_CHECK(Interval::elements_begin(empty_set) == Interval::elements_end(empty_set));
+}
+
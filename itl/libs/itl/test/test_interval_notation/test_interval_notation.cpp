@@ -0,0 +1,172 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::interval_notation unit test
+#include <stdlib.h>
+#include <limits>
+#include <string>
+#include <sstream>
+#include <boost/test/unit_test.hpp>
+#include "../test_value_maker.hpp"
+
+#include <boost/itl/set.hpp>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/interval_notation.hpp>
+#include <boost/itl/parallel_notation.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+template <class ContainerT> void fill(ContainerT& object, int count)
+{
+    for(int idx = 0; idx < count; idx++)
+        object.add(random_interval(20 * count, 20, -10 * count));
+}
+
+template <class CodomainT> void fill(interval_map<int,CodomainT>& object, int count)
+{
+    for(int idx = 0; idx < count; idx++)
+        object.add(make_pair(random_interval(20 * count, 20, -10 * count), static_cast<CodomainT>(1 + rand() % 3) / 2));
+}
+
+template <class CodomainT> void fill(split_interval_map<int,CodomainT>& object, int count)
+{
+    for(int idx = 0; idx < count; idx++)
+        object.add(make_pair(random_interval(20 * count, 20, -10 * count), static_cast<CodomainT>(1 + rand() % 3) / 2));
+}
+
+template <class ContainerT> void check_notation(int count)
+{
+    ContainerT object;
+    fill(object, count);
+
+    // The streaming writer yields the notation of as_string ...
+    std::string text = object.as_string();
+    ostringstream stream;
+    write_notation(stream, object);
+    BOOST_CHECK_EQUAL(stream.str(), text);
+
+    std::vector<char> buffer(text.size() + 1, 'x');
+    BOOST_CHECK_EQUAL(write_notation(&buffer[0], buffer.size(), object), text.size());
+    BOOST_CHECK_EQUAL(std::string(&buffer[0]), text);
+    if(!text.empty())
+    {
+        std::fill(buffer.begin(), buffer.end(), 'x');
+        BOOST_CHECK_EQUAL(write_notation(&buffer[0], text.size() / 2, object), text.size());
+        BOOST_CHECK_EQUAL(std::string(&buffer[0], text.size() / 2), text.substr(0, text.size() / 2));
+        BOOST_CHECK_EQUAL(buffer[text.size() / 2], 'x');
+    }
+
+    // ... which the parsers read back
+    ContainerT parsed;
+    BOOST_CHECK(parse_notation(text, parsed));
+    BOOST_CHECK(parsed == object);
+
+    for(unsigned threads = 2; threads <= 8; threads *= 2)
+    {
+        ContainerT parsed_in_parts;
+        BOOST_CHECK(parse_notation(text.data(), text.data() + text.size(), parsed_in_parts, threads));
+        BOOST_CHECK(parsed_in_parts == object);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_notation_round_trips)
+{
+    srand(71);
+    check_notation<interval_set<int> >(20);
+    check_notation<split_interval_set<int> >(20);
+    check_notation<interval_map<int,int> >(20);
+    check_notation<split_interval_map<int,double> >(20);
+    // Texts of more than 64K are parsed in parts
+    check_notation<interval_set<int> >(20000);
+    check_notation<split_interval_map<int,int> >(20000);
+    check_notation<interval_map<int,double> >(20000);
+}
+
+BOOST_AUTO_TEST_CASE(test_notation_values)
+{
+    interval_set<int> extremes;
+    extremes.add(closed_interval((std::numeric_limits<int>::min)(), -1));
+    extremes.add(rightopen_interval(1, (std::numeric_limits<int>::max)()));
+    interval_set<int> parsed;
+    BOOST_CHECK(parse_notation(extremes.as_string(), parsed));
+    BOOST_CHECK(parsed == extremes);
+
+    interval_map<int, itl::set<int> > members;
+    itl::set<int> group;
+    group.insert(3);
+    members.add(make_pair(rightopen_interval(1,4), group));
+    std::ostringstream stream;
+    write_notation(stream, members);
+    BOOST_CHECK_EQUAL(stream.str(), members.as_string());
+
+    interval_map<int,double> reals;
+    BOOST_CHECK(parse_notation(" ( [1, 3) , 0.25 )\n((3,5], -1.5e3) ", reals));
+    interval_map<int,double> expected;
+    expected.add(make_pair(rightopen_interval(1,3), 0.25));
+    expected.add(make_pair(leftopen_interval(3,5), -1500.0));
+    BOOST_CHECK(reals == expected);
+
+    // Floating point numbers are read back exactly
+    interval_map<int,double> thirds;
+    thirds.add(make_pair(rightopen_interval(1,3), 1.0/3.0));
+    thirds.add(make_pair(rightopen_interval(5,7), 0.1 + 0.2));
+    std::string thirds_text;
+    append_notation(thirds_text, thirds);
+    interval_map<int,double> parsed_thirds;
+    BOOST_CHECK(parse_notation(thirds_text, parsed_thirds));
+    BOOST_CHECK(parsed_thirds == thirds);
+
+    interval_map<int,std::string> texts;
+    BOOST_CHECK(parse_notation("([1,3),abc)([5,7],de)", texts));
+    BOOST_CHECK_EQUAL(texts.as_string(), "([1,3),abc)([5,7],de)");
+}
+
+BOOST_AUTO_TEST_CASE(test_notation_errors)
+{
+    // Parsing stops at the segment, that can not be read
+    std::string text = "[1,3)[5,x)[8,9]";
+    interval_set<int> object;
+    BOOST_CHECK(parse_notation(text.data(), text.data() + text.size(), object) == text.data() + 5);
+    BOOST_CHECK_EQUAL(object.as_string(), "[1,3)");
+
+    const char* malformed[] = { "[1,3", "[1 3)", "1,3)", "[,3)", "[1,3)]", "[-,3)" };
+    for(int idx = 0; idx < 6; idx++)
+    {
+        interval_set<int> failed;
+        BOOST_CHECK(!parse_notation(std::string(malformed[idx]), failed));
+    }
+
+    interval_set<unsigned int> unsigned_set;
+    BOOST_CHECK(!parse_notation("[-1,3)", unsigned_set));
+    // Values out of range are rejected
+    BOOST_CHECK(!parse_notation("[0,4294967296)", unsigned_set));
+    interval_set<short> short_set;
+    BOOST_CHECK(!parse_notation("[-32769,0)", short_set));
+    BOOST_CHECK(!parse_notation("[0,32768)", short_set));
+    BOOST_CHECK(parse_notation("[-32768,32767)", short_set));
+    interval_set<int> int_set;
+    BOOST_CHECK(!parse_notation("[1,2147483648)", int_set));
+    BOOST_CHECK(!parse_notation("[1,99999999999)", int_set));
+    interval_map<int,int> map_object;
+    BOOST_CHECK(!parse_notation("[1,3)", map_object));
+    BOOST_CHECK(!parse_notation("([1,3),2", map_object));
+
+    // The parallel parser does not change the container, if the text can not be read
+    interval_set<int> big, parsed;
+    fill(big, 20000);
+    std::string big_text = big.as_string() + "[1,";
+    parsed.add(rightopen_interval(0,1));
+    BOOST_CHECK(!parse_notation(big_text.data(), big_text.data() + big_text.size(), parsed, 4));
+    BOOST_CHECK_EQUAL(parsed.as_string(), "[0,1)");
+}
+
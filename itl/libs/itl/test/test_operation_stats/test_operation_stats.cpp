@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::operation_stats unit test
+#define ITL_OPERATION_STATS
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/separate_interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+
+BOOST_AUTO_TEST_CASE(test_operation_stats_interval_map_joins)
+{
+    typedef interval_map<int,int> IntervalMapT;
+    IntervalMapT map_a;
+
+    operation_stats_scope scope;
+    map_a.add(make_pair(rightopen_interval(1,3), 1));
+    BOOST_CHECK_EQUAL(scope.stats().searches(),    1);
+    BOOST_CHECK_EQUAL(scope.stats().allocations(), 1);
+    BOOST_CHECK_EQUAL(scope.stats().joins(),       0);
+
+    scope.restart();
+    map_a.add(make_pair(rightopen_interval(3,5), 1));
+    BOOST_CHECK_EQUAL(scope.stats().joins(),       1);
+    BOOST_CHECK_EQUAL(scope.stats().allocations(), 2);
+    BOOST_CHECK_EQUAL(map_a.iterative_size(), 1);
+
+    scope.restart();
+    map_a.add(make_pair(rightopen_interval(7,9), 0));
+    BOOST_CHECK_EQUAL(scope.stats().absorptions(), 1);
+    BOOST_CHECK_EQUAL(scope.stats().allocations(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_operation_stats_split_interval_map_splits)
+{
+    typedef split_interval_map<int,int> SplitIntervalMapT;
+    SplitIntervalMapT map_a;
+    map_a.add(make_pair(rightopen_interval(1,5), 1));
+
+    operation_stats_scope scope;
+    map_a.add(make_pair(rightopen_interval(3,7), 1));
+    BOOST_CHECK_EQUAL(scope.stats().searches(), 2);
+    BOOST_CHECK_EQUAL(scope.stats().visits(),   1);
+    BOOST_CHECK_EQUAL(scope.stats().splits(),   1);
+    BOOST_CHECK_EQUAL(scope.stats().joins(),    0);
+    BOOST_CHECK_EQUAL(map_a.iterative_size(), 3);
+
+    // [1,3)->1 [3,5)->2 [5,7)->1  -  [1,7)->1  ==  [3,5)->1
+    scope.restart();
+    map_a.subtract(make_pair(rightopen_interval(1,7), 1));
+    BOOST_CHECK_EQUAL(scope.stats().absorptions(), 2);
+    BOOST_CHECK_EQUAL(map_a.iterative_size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_operation_stats_interval_sets)
+{
+    interval_set<int> set_a;
+    split_interval_set<int> split_set_a;
+    separate_interval_set<int> sep_set_a;
+
+    operation_stats_scope scope;
+    set_a.add(rightopen_interval(1,3)).add(rightopen_interval(3,5));
+    BOOST_CHECK_EQUAL(scope.stats().joins(), 1);
+
+    scope.restart();
+    sep_set_a.add(rightopen_interval(1,3)).add(rightopen_interval(3,5));
+    BOOST_CHECK_EQUAL(scope.stats().joins(), 0);
+    BOOST_CHECK_EQUAL(scope.stats().allocations(), 2);
+
+    scope.restart();
+    split_set_a.add(rightopen_interval(1,5)).add(rightopen_interval(3,7));
+    BOOST_CHECK_EQUAL(scope.stats().splits(), 1);
+
+    scope.restart();
+    set_a.subtract(rightopen_interval(2,4));
+    BOOST_CHECK_EQUAL(scope.stats().splits(), 2);
+    BOOST_CHECK_EQUAL(scope.stats().visits(), 1);
+}
+
+namespace
+{
+    long traced_events = 0;
+    void count_traced(operation_event, const char*){ ++traced_events; }
+}
+
+BOOST_AUTO_TEST_CASE(test_operation_stats_tracer)
+{
+    interval_map<int,int> map_a;
+    operation_stats_scope scope;
+
+    set_operation_tracer(count_traced);
+    map_a.add(make_pair(rightopen_interval(1,5), 1));
+    map_a.add(make_pair(rightopen_interval(3,7), 2));
+    map_a.subtract(make_pair(rightopen_interval(0,9), 1));
+    set_operation_tracer(0);
+
+    operation_stats stats = scope.stats();
+    long all_events = 0;
+    for(int event = 0; event < operation_event_count; event++)
+        all_events += stats.count(static_cast<operation_event>(event));
+
+    BOOST_CHECK_EQUAL(traced_events, all_events);
+    BOOST_CHECK(all_events > 0);
+}
@@ -0,0 +1,131 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::overlap_sweep unit test
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/overlap_sweep.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+
+// An overlap counting interval_map is the reference for the sweep
+template <class DomainT>
+void check_overlaps(const std::vector<interval<DomainT> >& intervals, unsigned threads)
+{
+    typedef interval_map<DomainT,int>       OverlapMapT;
+    typedef split_interval_map<DomainT,int> SplitOverlapMapT;
+
+    OverlapMapT      expected,  swept;
+    SplitOverlapMapT expected_split, swept_split;
+    for(typename std::vector<interval<DomainT> >::const_iterator itv_ = intervals.begin();
+        itv_ != intervals.end(); ++itv_)
+    {
+        expected       += make_pair(*itv_, 1);
+        expected_split += make_pair(*itv_, 1);
+    }
+
+    overlap_statistics<interval<DomainT> > stats 
+        = sweep_overlaps(swept, intervals.begin(), intervals.end(), threads);
+    sweep_overlaps(swept_split, intervals.begin(), intervals.end(), threads);
+    BOOST_CHECK(swept == expected);
+    BOOST_CHECK(swept_split == expected_split);
+
+    std::size_t max_depth = 0;
+    std::vector<std::size_t> histogram(1, 0);
+    std::vector<typename interval<DomainT>::difference_type> coverage(1);
+    const_FORALL(typename OverlapMapT, segment_, expected)
+    {
+        std::size_t depth = (*segment_).CONT_VALUE;
+        max_depth = (std::max)(max_depth, depth);
+        histogram.resize((std::max)(histogram.size(), depth+1), 0);
+        coverage.resize(histogram.size());
+        ++histogram[depth];
+        coverage[depth] += (*segment_).KEY_VALUE.length();
+    }
+
+    BOOST_CHECK_EQUAL(stats.max_depth(), max_depth);
+    BOOST_CHECK_EQUAL(stats.segment_count(), expected.iterative_size());
+    for(std::size_t depth = 1; depth <= max_depth; depth++)
+    {
+        BOOST_CHECK_EQUAL(stats.segment_count(depth), histogram[depth]);
+        BOOST_CHECK_EQUAL(stats.coverage(depth), coverage[depth]);
+    }
+    BOOST_CHECK_EQUAL(stats.max_depth_segments().size(), histogram[max_depth]);
+    for(std::size_t idx = 0; idx < stats.max_depth_segments().size(); idx++)
+        BOOST_CHECK(expected.contains(typename OverlapMapT::value_type(
+                        stats.max_depth_segments()[idx], static_cast<int>(max_depth))));
+}
+
+BOOST_AUTO_TEST_CASE(test_overlap_sweep_discrete)
+{
+    srand(17);
+    for(int run = 0; run < 100; run++)
+    {
+        std::vector<interval<int> > rightopen, closed;
+        for(int idx = 0; idx < rand() % 60; idx++)
+        {
+            int lower = rand() % 100, upper = lower + rand() % 20;
+            rightopen.push_back(rightopen_interval(lower, upper));
+            closed.push_back(closed_interval(lower, upper));
+        }
+        check_overlaps(rightopen, 1);
+        check_overlaps(closed, 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_overlap_sweep_continuous)
+{
+    srand(19);
+    for(int run = 0; run < 100; run++)
+    {
+        std::vector<interval<double> > intervals;
+        for(int idx = 0; idx < rand() % 60; idx++)
+        {
+            double lower = rand() % 100, upper = lower + rand() % 20 / 2.0;
+            switch(rand() % 3)
+            {
+            case 0:  intervals.push_back(rightopen_interval(lower, upper)); break;
+            case 1:  intervals.push_back(closed_interval(lower, upper)); break;
+            default: intervals.push_back(interval<double>(lower, upper, interval<double>::OPEN)); break;
+            }
+        }
+        check_overlaps(intervals, 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_overlap_sweep_large_batch)
+{
+    srand(23);
+    std::vector<interval<int> > intervals;
+    for(int idx = 0; idx < 50000; idx++)
+    {
+        int lower = rand() % 1000000;
+        intervals.push_back(rightopen_interval(lower, lower + 1 + rand() % 100));
+    }
+    // Sorting in parts and merging them yields the same result
+    check_overlaps(intervals, 4);
+
+    std::vector<interval<int> > nested;
+    for(int idx = 0; idx < 10; idx++)
+        nested.push_back(rightopen_interval(idx, 20 - idx));
+    overlap_statistics<interval<int> > stats = sweep_overlaps(nested.begin(), nested.end());
+    BOOST_CHECK_EQUAL(stats.max_depth(), 10u);
+    BOOST_CHECK_EQUAL(stats.max_depth_segments().size(), 1u);
+    BOOST_CHECK_EQUAL(stats.max_depth_segments()[0], rightopen_interval(9, 11));
+    BOOST_CHECK_EQUAL(stats.coverage(1), 2);
+    BOOST_CHECK_EQUAL(stats.segment_count(1), 2u);
+}
+
@@ -0,0 +1,254 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::set_algo unit test
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/set.hpp>
+#include <boost/itl/map.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+typedef itl::set<int>                          SetT;
+typedef itl::map<int,int>                      MapT;
+typedef itl::map<int,int,neutron_enricher>     EnricherMapT;
+typedef itl::map<int,itl::set<int> >           SetMapT;
+
+// Operand shapes: Keys are drawn from [offset, offset + range*step) in steps of step
+struct shape
+{
+    shape(int count_, int offset_, int range_, int step_)
+        : count(count_), offset(offset_), range(range_), step(step_) {}
+    int some_key()const { return offset + (rand() % range) * step; }
+
+    int count, offset, range, step;
+};
+
+// Pairs of operands: overlapping, disjoint, interleaved, skewed and empty ones
+std::vector<std::pair<shape,shape> > operand_shapes()
+{
+    std::vector<std::pair<shape,shape> > shapes;
+    shapes.push_back(make_pair(shape(50, 0, 100, 1),   shape(50, 0, 100, 1)));
+    shapes.push_back(make_pair(shape(300, 0, 400, 1),  shape(300, 100, 400, 1)));
+    shapes.push_back(make_pair(shape(50, 0, 100, 1),   shape(50, 500, 100, 1)));
+    shapes.push_back(make_pair(shape(50, 500, 100, 1), shape(50, 0, 100, 1)));
+    shapes.push_back(make_pair(shape(80, 0, 100, 2),   shape(80, 1, 100, 2)));
+    shapes.push_back(make_pair(shape(1000, 0, 2000, 1),shape(5, 0, 2000, 1)));
+    shapes.push_back(make_pair(shape(5, 0, 2000, 1),   shape(1000, 0, 2000, 1)));
+    shapes.push_back(make_pair(shape(0, 0, 100, 1),    shape(50, 0, 100, 1)));
+    shapes.push_back(make_pair(shape(50, 0, 100, 1),   shape(0, 0, 100, 1)));
+    shapes.push_back(make_pair(shape(0, 0, 100, 1),    shape(0, 0, 100, 1)));
+    return shapes;
+}
+
+int some_value(const int*) { return rand() % 5 - 2; }
+
+itl::set<int> some_value(const itl::set<int>*)
+{
+    itl::set<int> value;
+    for(int idx = rand() % 3; idx > 0; idx--)
+        value.insert(rand() % 4);
+    return value;
+}
+
+SetT some_set(const shape& form)
+{
+    SetT object;
+    for(int idx = 0; idx < form.count; idx++)
+        object.insert(form.some_key());
+    return object;
+}
+
+template <class MapType> MapType some_map(const shape& form)
+{
+    typedef typename MapType::data_type data_type;
+    MapType object;
+    for(int idx = 0; idx < form.count; idx++)
+        object.insert(typename MapType::value_type(form.some_key(),
+                                                   some_value(static_cast<const data_type*>(0))));
+    return object;
+}
+
+//------------------------------------------------------------------------------
+// References: The algorithms that search every element of the operand
+//------------------------------------------------------------------------------
+template <class ObjectT> void add_by_find(ObjectT& result, const ObjectT& x2)
+{
+    const_FORALL(typename ObjectT, x2_, x2)
+        result.add(*x2_);
+}
+
+template <class ObjectT, class CoObjectT> void subtract_by_find(ObjectT& result, const CoObjectT& x2)
+{
+    const_FORALL(typename CoObjectT, x2_, x2)
+        result.subtract(*x2_);
+}
+
+template <class MapType> void erase_by_find(MapType& result, const SetT& x2)
+{
+    const_FORALL(SetT, x2_, x2)
+        result.erase(*x2_);
+}
+
+SetT intersect_by_find(const SetT& x1, const SetT& x2)
+{
+    SetT result;
+    const_FORALL(SetT, x1_, x1)
+        if(x2.find(*x1_) != x2.end())
+            result.insert(*x1_);
+    return result;
+}
+
+template <class MapType> MapType intersect_by_find(const MapType& x1, const MapType& x2)
+{
+    MapType result;
+    const_FORALL(typename MapType, x1_, x1)
+    {
+        typename MapType::const_iterator x2_ = x2.find((*x1_).KEY_VALUE);
+        if(x2_ != x2.end())
+        {
+            result.insert(*x1_);
+            if(is_set<typename MapType::data_type>::value)
+                result.template add<inplace_star>(*x2_);
+            else
+                result.template add<inplace_plus>(*x2_);
+        }
+    }
+    return result;
+}
+
+template <class MapType> MapType intersect_by_find(const MapType& x1, const SetT& x2)
+{
+    MapType result;
+    const_FORALL(typename MapType, x1_, x1)
+        if(x2.find((*x1_).KEY_VALUE) != x2.end())
+            result.insert(*x1_);
+    return result;
+}
+
+bool contained_by_find(const SetT& sub, const SetT& super)
+{
+    const_FORALL(SetT, sub_, sub)
+        if(super.find(*sub_) == super.end())
+            return false;
+    return true;
+}
+
+template <class MapType> bool contained_by_find(const MapType& sub, const MapType& super)
+{
+    const_FORALL(typename MapType, sub_, sub)
+    {
+        typename MapType::const_iterator super_ = super.find((*sub_).KEY_VALUE);
+        if(super_ == super.end() || !((*super_).CONT_VALUE == (*sub_).CONT_VALUE))
+            return false;
+    }
+    return true;
+}
+
+bool disjoint_by_find(const SetT& x1, const SetT& x2)
+{
+    const_FORALL(SetT, x1_, x1)
+        if(x2.find(*x1_) != x2.end())
+            return false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(test_set_algorithms)
+{
+    srand(127);
+    std::vector<std::pair<shape,shape> > shapes = operand_shapes();
+    for(std::size_t idx = 0; idx < shapes.size(); idx++)
+    {
+        SetT x1 = some_set(shapes[idx].first), x2 = some_set(shapes[idx].second);
+
+        SetT sum = x1, expected_sum = x1;
+        sum += x2;
+        add_by_find(expected_sum, x2);
+        BOOST_CHECK(sum == expected_sum);
+
+        SetT difference = x1, expected_difference = x1;
+        difference -= x2;
+        subtract_by_find(expected_difference, x2);
+        BOOST_CHECK(difference == expected_difference);
+
+        SetT section = x1;
+        section *= x2;
+        BOOST_CHECK(section == intersect_by_find(x1, x2));
+
+        SetT subset = intersect_by_find(x1, x2);
+        BOOST_CHECK_EQUAL(x1.contained_in(x2), contained_by_find(x1, x2));
+        BOOST_CHECK_EQUAL(subset.contained_in(x2), contained_by_find(subset, x2));
+        BOOST_CHECK_EQUAL(x2.contains(subset), contained_by_find(subset, x2));
+        BOOST_CHECK_EQUAL(Set::disjoint(x1, x2), disjoint_by_find(x1, x2));
+    }
+}
+
+template <class MapType> void check_map_algorithms(const shape& form1, const shape& form2)
+{
+    MapType x1 = some_map<MapType>(form1), x2 = some_map<MapType>(form2);
+    SetT keys = some_set(form2);
+
+    MapType sum = x1, expected_sum = x1;
+    sum += x2;
+    add_by_find(expected_sum, x2);
+    BOOST_CHECK(sum == expected_sum);
+
+    MapType difference = x1, expected_difference = x1;
+    difference -= x2;
+    subtract_by_find(expected_difference, x2);
+    BOOST_CHECK(difference == expected_difference);
+
+    MapType erased = x1, expected_erased = x1;
+    erased -= keys;
+    erase_by_find(expected_erased, keys);
+    BOOST_CHECK(erased == expected_erased);
+
+    MapType section = x1;
+    section *= x2;
+    BOOST_CHECK(section == intersect_by_find(x1, x2));
+
+    MapType key_section = x1;
+    key_section *= keys;
+    BOOST_CHECK(key_section == intersect_by_find(x1, keys));
+
+    BOOST_CHECK_EQUAL(x1.contained_in(x2), contained_by_find(x1, x2));
+    BOOST_CHECK_EQUAL(key_section.contained_in(x1), contained_by_find(key_section, x1));
+    BOOST_CHECK_EQUAL(x1.contains(key_section), contained_by_find(key_section, x1));
+}
+
+BOOST_AUTO_TEST_CASE(test_map_hinted_insertion)
+{
+    // Results of the merge walks are appended with an end hint
+    MapT absorber;
+    absorber.insert(absorber.end(), MapT::value_type(1, 0));
+    BOOST_CHECK(absorber.empty());
+    absorber.insert(absorber.end(), MapT::value_type(1, 2));
+    BOOST_CHECK_EQUAL(absorber.size(), 1u);
+
+    EnricherMapT enricher;
+    enricher.insert(enricher.end(), EnricherMapT::value_type(1, 0));
+    BOOST_CHECK_EQUAL(enricher.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_map_algorithms)
+{
+    srand(131);
+    std::vector<std::pair<shape,shape> > shapes = operand_shapes();
+    for(std::size_t idx = 0; idx < shapes.size(); idx++)
+    {
+        check_map_algorithms<MapT>(shapes[idx].first, shapes[idx].second);
+        check_map_algorithms<EnricherMapT>(shapes[idx].first, shapes[idx].second);
+        check_map_algorithms<SetMapT>(shapes[idx].first, shapes[idx].second);
+    }
+}
@@ -0,0 +1,136 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::sharded unit test
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/ptime.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/sharded.hpp>
+#include <boost/itl/parallel.hpp>
+#include "../test_value_maker.hpp"
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+using namespace boost::posix_time;
+
+std::vector<int> borders(int first, int step, int count)
+{
+    std::vector<int> result;
+    for(int idx = 0; idx < count; idx++)
+        result.push_back(first + idx * step);
+    return result;
+}
+
+// Reference: The same updates on an unsharded map
+template <class MapT> void check_sharded(const std::vector<int>& shard_borders)
+{
+    sharded<MapT> object(shard_borders.begin(), shard_borders.end());
+    BOOST_CHECK_EQUAL(object.shard_count(), shard_borders.size() + 1);
+    MapT expected;
+    for(int step = 0; step < 2000; step++)
+    {
+        interval<int> itv = random_interval(1000, 150);
+        int value = 1 + rand() % 3;
+        switch(rand() % 8)
+        {
+        case 0:
+            object.subtract(make_pair(itv, value));
+            expected.subtract(make_pair(itv, value));
+            break;
+        case 1:
+            object.insert(make_pair(itv, value));
+            expected.insert(make_pair(itv, value));
+            break;
+        case 2:
+            object.erase(itv);
+            expected.erase(itv);
+            break;
+        case 3:
+            object.erase(itv.lower());
+            expected.erase(itv.lower());
+            break;
+        default:
+            object += make_pair(itv, value);
+            expected += make_pair(itv, value);
+        }
+        BOOST_CHECK_EQUAL(object.contains(itv.lower()), expected.contains(itv.lower()));
+    }
+    BOOST_CHECK(is_element_equal(object.snapshot(), expected));
+    if(is_interval_joiner<MapT>::value)
+        BOOST_CHECK(object.snapshot() == expected);
+
+    object.clear();
+    BOOST_CHECK(object.snapshot().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_sharded_updates)
+{
+    srand(109);
+    check_sharded<interval_map<int,int> >(borders(100, 100, 9));
+    check_sharded<interval_map<int,int> >(borders(0, 7, 150));
+    check_sharded<interval_map<int,int> >(std::vector<int>());
+    check_sharded<split_interval_map<int,int> >(borders(100, 100, 9));
+    check_sharded<interval_map<int,int,neutron_enricher> >(borders(50, 250, 4));
+}
+
+struct load_writer
+{
+    load_writer(sharded<interval_map<int,int> >& object): _object(&object) {}
+
+    // Writers add intervals of their own and some crossing into other writers' ranges
+    void operator()(unsigned part)const
+    {
+        for(int idx = 0; idx < 500; idx++)
+        {
+            int lower = static_cast<int>(part) * 1000 + (idx * 37) % 1000;
+            _object->add(make_pair(rightopen_interval(lower, lower + 1 + idx % 300), 1));
+        }
+    }
+
+    sharded<interval_map<int,int> >* _object;
+};
+
+BOOST_AUTO_TEST_CASE(test_concurrent_writers)
+{
+    std::vector<int> shard_borders = borders(250, 250, 15);
+    sharded<interval_map<int,int> > object(shard_borders.begin(), shard_borders.end());
+    Parallel::run(load_writer(object), 4);
+
+    interval_map<int,int> expected;
+    for(int part = 0; part < 4; part++)
+        for(int idx = 0; idx < 500; idx++)
+        {
+            int lower = part * 1000 + (idx * 37) % 1000;
+            expected.add(make_pair(rightopen_interval(lower, lower + 1 + idx % 300), 1));
+        }
+    BOOST_CHECK(object.snapshot() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_sharded_time_line)
+{
+    ptime start(boost::gregorian::date(2008,11,4));
+    std::vector<ptime> shard_borders;
+    for(int hour = 6; hour < 48; hour += 6)
+        shard_borders.push_back(start + hours(hour));
+    sharded<interval_map<ptime,int> > load(shard_borders.begin(), shard_borders.end());
+
+    // An update across four shards is joined again, when it is read
+    load += make_pair(rightopen_interval(start + hours(5), start + hours(25)), 2);
+    interval_map<ptime,int> snapshot = load.snapshot();
+    BOOST_CHECK_EQUAL(snapshot.iterative_size(), 1u);
+    BOOST_CHECK_EQUAL(snapshot.lower(), start + hours(5));
+    BOOST_CHECK_EQUAL(snapshot.upper(), start + hours(25));
+    BOOST_CHECK(load.contains(start + hours(12)));
+    BOOST_CHECK(!load.contains(start + hours(25)));
+}
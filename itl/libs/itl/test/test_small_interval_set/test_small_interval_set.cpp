@@ -0,0 +1,141 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::small_interval_set unit test
+#include <stdlib.h>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/small_interval_set.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+
+template <class SmallSetT, class IntervalSetT>
+void check_same_intervals(const SmallSetT& small_set, const IntervalSetT& interval_set_)
+{
+    BOOST_CHECK_EQUAL(small_set.iterative_size(), interval_set_.iterative_size());
+    BOOST_CHECK(std::equal(interval_set_.begin(), interval_set_.end(), small_set.begin()));
+    BOOST_CHECK_EQUAL(small_set.as_string(), interval_set_.as_string());
+}
+
+BOOST_AUTO_TEST_CASE(test_small_interval_set_stays_inline)
+{
+    typedef small_interval_set<int,4> SmallSetT;
+    SmallSetT small_set;
+    small_set += rightopen_interval(1,3);
+    small_set += rightopen_interval(5,7);
+    small_set += rightopen_interval(9,11);
+    small_set += rightopen_interval(13,15);
+    BOOST_CHECK_EQUAL(small_set.iterative_size(), 4u);
+    BOOST_CHECK(!small_set.spilled());
+
+    // Touching intervals are joined
+    small_set += rightopen_interval(3,5);
+    BOOST_CHECK_EQUAL(small_set.iterative_size(), 3u);
+    BOOST_CHECK(!small_set.spilled());
+    BOOST_CHECK(small_set.contains(rightopen_interval(1,7)));
+    BOOST_CHECK(!small_set.contains(7));
+
+    small_set += 17;
+    small_set += 19;
+    BOOST_CHECK(small_set.spilled());
+    BOOST_CHECK_EQUAL(small_set.iterative_size(), 5u);
+
+    small_set -= rightopen_interval(9,20);
+    BOOST_CHECK(!small_set.spilled());
+    BOOST_CHECK_EQUAL(small_set.iterative_size(), 1u);
+    BOOST_CHECK_EQUAL(small_set.lower(), 1);
+    BOOST_CHECK_EQUAL(small_set.upper(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_small_interval_set_equals_interval_set)
+{
+    typedef small_interval_set<int,3> SmallSetT;
+    typedef interval_set<int>         IntervalSetT;
+
+    srand(42);
+    for(int run = 0; run < 50; run++)
+    {
+        SmallSetT    small_set, small_other;
+        IntervalSetT expected,  expected_other;
+        for(int step = 0; step < 40; step++)
+        {
+            int lower = rand() % 40, upper = lower + rand() % 6;
+            interval<int> itv = rightopen_interval(lower, upper);
+            switch(rand() % 4)
+            {
+            case 0: case 1: small_set += itv; expected += itv; break;
+            case 2:         small_set -= itv; expected -= itv; break;
+            default:        small_other += itv; expected_other += itv; break;
+            }
+            check_same_intervals(small_set, expected);
+        }
+
+        SmallSetT    small_section = small_set;
+        IntervalSetT expected_section = expected;
+        small_section *= small_other;
+        expected_section *= expected_other;
+        check_same_intervals(small_section, expected_section);
+
+        SmallSetT    small_union = small_set;
+        IntervalSetT expected_union = expected;
+        small_union += small_other;
+        expected_union += expected_other;
+        check_same_intervals(small_union, expected_union);
+
+        SmallSetT    small_difference = small_set;
+        IntervalSetT expected_difference = expected;
+        small_difference -= small_other;
+        expected_difference -= expected_other;
+        check_same_intervals(small_difference, expected_difference);
+
+        BOOST_CHECK(small_set == small_set);
+        BOOST_CHECK_EQUAL(small_set < small_other, expected < expected_other);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_small_interval_set_as_codomain_of_interval_map)
+{
+    typedef interval_map<int, small_interval_set<int> > SmallSetMapT;
+    typedef interval_map<int, interval_set<int> >        IntervalSetMapT;
+
+    srand(7);
+    SmallSetMapT    small_map;
+    IntervalSetMapT expected;
+    for(int step = 0; step < 300; step++)
+    {
+        int lower = rand() % 100, upper = lower + 1 + rand() % 20;
+        int value = rand() % 10;
+        interval<int> itv = rightopen_interval(lower, upper);
+        if(rand() % 3 == 0)
+        {
+            small_map.subtract(make_pair(itv, small_interval_set<int>(value)));
+            expected.subtract(make_pair(itv, interval_set<int>(value)));
+        }
+        else
+        {
+            small_map.add(make_pair(itv, small_interval_set<int>(value)));
+            expected.add(make_pair(itv, interval_set<int>(value)));
+        }
+    }
+
+    BOOST_CHECK_EQUAL(small_map.iterative_size(), expected.iterative_size());
+    SmallSetMapT::const_iterator small_ = small_map.begin();
+    IntervalSetMapT::const_iterator expected_ = expected.begin();
+    for(; expected_ != expected.end(); ++small_, ++expected_)
+    {
+        BOOST_CHECK_EQUAL((*small_).KEY_VALUE, (*expected_).KEY_VALUE);
+        check_same_intervals((*small_).CONT_VALUE, (*expected_).CONT_VALUE);
+    }
+}
+
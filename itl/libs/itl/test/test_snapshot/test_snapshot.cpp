@@ -0,0 +1,221 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::snapshot unit test
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <boost/test/unit_test.hpp>
+#include "../test_value_maker.hpp"
+
+#include <boost/itl/set.hpp>
+#include <boost/itl/map.hpp>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/separate_interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/snapshot.hpp>
+#include <boost/itl/mapped_file.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+
+template <class ContainerT> void fill(ContainerT& object)
+{
+    for(int idx = 0; idx < 100; idx++)
+        object.add(random_interval(1000, 20));
+}
+
+template <class DomainT, class CodomainT> void fill(interval_map<DomainT,CodomainT>& object)
+{
+    for(int idx = 0; idx < 100; idx++)
+        object.add(make_pair(random_interval(1000, 20), static_cast<CodomainT>(1 + rand() % 3)));
+}
+
+template <class DomainT, class CodomainT> void fill(split_interval_map<DomainT,CodomainT>& object)
+{
+    for(int idx = 0; idx < 100; idx++)
+        object.add(make_pair(random_interval(1000, 20), static_cast<CodomainT>(1 + rand() % 3)));
+}
+
+void fill(itl::set<int>& object)
+{
+    for(int idx = 0; idx < 100; idx++)
+        object.insert(rand() % 1000);
+}
+
+void fill(itl::map<int,int>& object)
+{
+    for(int idx = 0; idx < 100; idx++)
+        object.add(make_pair(rand() % 1000, 1 + rand() % 3));
+}
+
+template <class ContainerT> void check_round_trip()
+{
+    ContainerT object, copied;
+    fill(object);
+    stringstream stream;
+    BOOST_CHECK(write_snapshot(stream, object));
+    BOOST_CHECK(read_snapshot(stream, copied));
+    BOOST_CHECK(copied == object);
+
+    // Equal containers yield equal snapshots
+    stringstream again;
+    write_snapshot(again, copied);
+    BOOST_CHECK(again.str() == stream.str());
+}
+
+BOOST_AUTO_TEST_CASE(test_snapshot_round_trips)
+{
+    srand(53);
+    check_round_trip<interval_set<int> >();
+    check_round_trip<separate_interval_set<int> >();
+    check_round_trip<split_interval_set<int> >();
+    check_round_trip<interval_map<int,int> >();
+    check_round_trip<split_interval_map<int,double> >();
+    check_round_trip<itl::set<int> >();
+    check_round_trip<itl::map<int,int> >();
+
+    interval_set<int> empty_set;
+    stringstream stream;
+    write_snapshot(stream, empty_set);
+    empty_set.add(rightopen_interval(1,2));
+    BOOST_CHECK(read_snapshot(stream, empty_set));
+    BOOST_CHECK(empty_set.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_snapshot_formats)
+{
+    srand(59);
+    split_interval_map<int,int> split_map;
+    fill(split_map);
+    stringstream stream;
+    write_snapshot(stream, split_map);
+
+    // A split map is joined again by reading it into an interval_map
+    interval_map<int,int> joined, expected;
+    BOOST_CHECK(read_snapshot(stream, joined));
+    for(split_interval_map<int,int>::const_iterator it_ = split_map.begin(); it_ != split_map.end(); ++it_)
+        expected.add(*it_);
+    BOOST_CHECK(joined == expected);
+
+    // Snapshots of other kinds or value sizes are rejected
+    stringstream other(stream.str());
+    interval_set<int> set_of_map;
+    BOOST_CHECK(!read_snapshot(other, set_of_map));
+    other.str(stream.str());
+    interval_map<int,double> double_map;
+    BOOST_CHECK(!read_snapshot(other, double_map));
+
+    // So are other versions and truncated snapshots
+    string changed = stream.str();
+    changed[4] = 2;
+    other.str(changed);
+    BOOST_CHECK(!read_snapshot(other, joined));
+    other.str(stream.str().substr(0, stream.str().size() - 1));
+    other.clear();
+    BOOST_CHECK(!read_snapshot(other, joined));
+}
+
+// Snapshots are kept in vectors of words, so the records are aligned
+template <class ContainerT>
+std::vector<boost::uint64_t> snapshot_memory(const ContainerT& object)
+{
+    stringstream stream;
+    write_snapshot(stream, object);
+    string image = stream.str();
+    std::vector<boost::uint64_t> memory(image.size() / sizeof(boost::uint64_t) + 1);
+    memcpy(&memory[0], image.data(), image.size());
+    return memory;
+}
+
+template <class ContainerT>
+void check_view_queries(const ContainerT& object, const snapshot_view<ContainerT>& view)
+{
+    BOOST_CHECK_EQUAL(view.iterative_size(), object.iterative_size());
+    for(int x = -5; x < 1030; x++)
+    {
+        BOOST_CHECK_EQUAL(view.contains(x), object.contains(x));
+        if(view.contains(x))
+            BOOST_CHECK((*view.find(x)).interval().contains(x));
+    }
+    for(int idx = 0; idx < 50; idx++)
+    {
+        interval<int> itv = random_interval(1050, 100);
+        ContainerT section, expected;
+        view.add_intersection(section, itv);
+        object.add_intersection(expected, itv);
+        BOOST_CHECK(section == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_snapshot_views)
+{
+    srand(61);
+    interval_map<int,int> map_object;
+    split_interval_set<int> set_object;
+    fill(map_object);
+    fill(set_object);
+
+    std::vector<boost::uint64_t> map_memory = snapshot_memory(map_object);
+    snapshot_view<interval_map<int,int> > map_view(&map_memory[0], map_memory.size() * sizeof(boost::uint64_t));
+    BOOST_CHECK(map_view.is_attached());
+    check_view_queries(map_object, map_view);
+    interval_map<int,int>::const_iterator it_ = map_object.begin();
+    for(snapshot_view<interval_map<int,int> >::const_iterator rec_ = map_view.begin(); rec_ != map_view.end(); ++rec_, ++it_)
+        BOOST_CHECK(map_view.value(rec_) == *it_);
+
+    std::vector<boost::uint64_t> set_memory = snapshot_memory(set_object);
+    snapshot_view<split_interval_set<int> > set_view(&set_memory[0], set_memory.size() * sizeof(boost::uint64_t));
+    check_view_queries(set_object, set_view);
+
+    // Views check kind and size of the snapshot
+    snapshot_view<interval_set<int> > wrong_kind(&map_memory[0], map_memory.size() * sizeof(boost::uint64_t));
+    BOOST_CHECK(!wrong_kind.is_attached());
+    snapshot_view<interval_map<int,int> > truncated(&map_memory[0], sizeof(Snapshot::header) + 10);
+    BOOST_CHECK(!truncated.is_attached());
+
+    itl::map<int,int> element_map;
+    fill(element_map);
+    std::vector<boost::uint64_t> element_memory = snapshot_memory(element_map);
+    snapshot_view<itl::map<int,int> > element_view(&element_memory[0], element_memory.size() * sizeof(boost::uint64_t));
+    for(int x = 0; x < 1000; x++)
+    {
+        BOOST_CHECK_EQUAL(element_view.contains(x), element_map.contains(x));
+        if(element_view.contains(x))
+            BOOST_CHECK_EQUAL((*element_view.find(x)).value, (*element_map.find(x)).CONT_VALUE);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_mapped_snapshot)
+{
+    srand(67);
+    interval_map<int,int> object;
+    fill(object);
+    const char* path = "test_snapshot.bin";
+    {
+        ofstream file(path, ios::out | ios::binary);
+        BOOST_CHECK(write_snapshot(file, object));
+    }
+
+    mapped_file mapping(path);
+    BOOST_CHECK(mapping.is_open());
+    snapshot_view<interval_map<int,int> > view(mapping.data(), mapping.size());
+    BOOST_CHECK(view.is_attached());
+    check_view_queries(object, view);
+    mapping.close();
+    remove(path);
+
+    BOOST_CHECK(!mapped_file("no_such_snapshot.bin").is_open());
+}
+
@@ -16,6 +16,7 @@ Copyright (c) 2008-2008: Joachim Faulhaber
 #include <boost/itl/rational.hpp> 
 
 #include <boost/itl/interval.hpp>
+#include <boost/itl/impl_config.hpp>
 
 typedef ::boost::mpl::list<
     unsigned short, unsigned int, unsigned long  
@@ -59,5 +60,14 @@ typedef ::boost::mpl::list<
 //    ,boost::gregorian::date
 > ordered_types;
 
+// Traits of the interval maps under test. The suites are built for
+// btree_map implemented interval maps, if ITL_TEST_BTREE_IMPLEMENTATION
+// is defined.
+#ifdef ITL_TEST_BTREE_IMPLEMENTATION
+typedef boost::itl::btree_implemented<boost::itl::neutron_absorber> test_absorber;
+#else
+typedef boost::itl::neutron_absorber test_absorber;
+#endif
+
 #endif 
 
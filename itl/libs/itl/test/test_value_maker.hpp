@@ -8,7 +8,9 @@ Copyright (c) 2008-2008: Joachim Faulhaber
 #ifndef __itl_test_value_maker_JOFA_080916_H__
 #define __itl_test_value_maker_JOFA_080916_H__
 
+#include <stdlib.h>
 #include <boost/itl/type_traits/neutron.hpp>
+#include <boost/itl/interval.hpp>
 
 namespace boost{ namespace itl
 {
@@ -26,6 +28,29 @@ BicrementableT make(int n)
     return value;
 }
 
+/// A random right open interval of 1 to \c max_length integers
+/** Its lower bound is drawn from [offset, offset + range). */
+inline interval<int> random_rightopen_interval(int range, int max_length, int offset = 0)
+{
+    int lower = offset + rand() % range;
+    return rightopen_interval(lower, lower + 1 + rand() % max_length);
+}
+
+/// A random interval of integers with random bound types
+/** Its lower bound is drawn from [offset, offset + range). It contains
+    at most \c max_length + 1 integers and may be empty. */
+inline interval<int> random_interval(int range, int max_length, int offset = 0)
+{
+    int lower = offset + rand() % range;
+    switch(rand() % 4)
+    {
+    case 0:  return rightopen_interval(lower, lower + 1 + rand() % max_length);
+    case 1:  return closed_interval(lower, lower + rand() % max_length);
+    case 2:  return open_interval(lower, lower + 2 + rand() % max_length);
+    default: return leftopen_interval(lower, lower + 1 + rand() % max_length);
+    }
+}
+
 }} // namespace boost itl
 
 #endif 
@@ -0,0 +1,126 @@
+/*----------------------------------------------------------------------------+
+Copyright (c) 2008-2008: Joachim Faulhaber
++-----------------------------------------------------------------------------+
+   Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENCE.txt or copy at
+           http://www.boost.org/LICENSE_1_0.txt)
++----------------------------------------------------------------------------*/
+#define BOOST_TEST_MODULE itl::windowed unit test
+#include <stdlib.h>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/itl/ptime.hpp>
+#include <boost/itl/interval_set.hpp>
+#include <boost/itl/separate_interval_set.hpp>
+#include <boost/itl/split_interval_set.hpp>
+#include <boost/itl/interval_map.hpp>
+#include <boost/itl/split_interval_map.hpp>
+#include <boost/itl/windowed.hpp>
+#include "../test_value_maker.hpp"
+
+using namespace std;
+using namespace boost;
+using namespace unit_test;
+using namespace boost::itl;
+using namespace boost::posix_time;
+
+template <class ContainerT> void random_fill(ContainerT& object, const interval<int>&)
+{
+    for(int idx = 0; idx < rand() % 30; idx++)
+        object += random_interval(100, 12);
+}
+
+template <class ContainerT, class CodomainT>
+void random_fill(ContainerT& object, const std::pair<const interval<int>, CodomainT>&)
+{
+    for(int idx = 0; idx < rand() % 30; idx++)
+        object += make_pair(random_interval(100, 12), 1 + rand() % 3);
+}
+
+// Reference: Erasure of the intervals before and after x
+template <class ContainerT> void check_truncation()
+{
+    for(int run = 0; run < 300; run++)
+    {
+        ContainerT object;
+        random_fill(object, typename ContainerT::value_type());
+        int x = rand() % 120 - 10;
+
+        ContainerT before = object, expected_before = object;
+        before.truncate_before(x);
+        expected_before.erase(rightopen_interval(-20, x));
+        BOOST_CHECK(is_element_equal(before, expected_before));
+        BOOST_CHECK(before.iterative_size() <= object.iterative_size());
+
+        ContainerT after = object, expected_after = object;
+        after.truncate_after(x);
+        expected_after.erase(leftopen_interval(x, 140));
+        BOOST_CHECK(is_element_equal(after, expected_after));
+        BOOST_CHECK(after.iterative_size() <= object.iterative_size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_truncation)
+{
+    srand(97);
+    check_truncation<interval_set<int> >();
+    check_truncation<separate_interval_set<int> >();
+    check_truncation<split_interval_set<int> >();
+    check_truncation<interval_map<int,int> >();
+    check_truncation<split_interval_map<int,int> >();
+
+    interval_map<int,int> load;
+    load.add(make_pair(rightopen_interval(1,5), 1))
+        .add(make_pair(rightopen_interval(3,9), 1));
+    load.truncate_before(4).truncate_after(6);
+    interval_map<int,int> expected;
+    expected.add(make_pair(rightopen_interval(4,5), 2))
+            .add(make_pair(closed_interval(5,6), 1));
+    BOOST_CHECK_EQUAL(load, expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_windowed_map)
+{
+    ptime start(boost::gregorian::date(2008,11,4));
+    windowed<interval_map<ptime,int> > load(hours(24));
+
+    // One sample per hour during two days
+    for(int hour = 0; hour < 48; hour++)
+    {
+        ptime begin = start + hours(hour);
+        load += make_pair(rightopen_interval(begin, begin + hours(2)), 1);
+        BOOST_CHECK(!(load.container().lower() < load.expiry()));
+    }
+    BOOST_CHECK_EQUAL(load.horizon(), start + hours(49));
+    BOOST_CHECK_EQUAL(load.container().lower(), start + hours(25));
+    BOOST_CHECK(!load.contains(start + hours(24)));
+    BOOST_CHECK(load.contains(start + hours(30)));
+
+    // Late samples that are already expired do not come back
+    load += make_pair(rightopen_interval(start, start + hours(3)), 5);
+    BOOST_CHECK_EQUAL(load.container().lower(), start + hours(25));
+
+    load.advance(start + hours(72));
+    BOOST_CHECK_EQUAL(load.container().lower(), start + hours(48));
+    load.advance(start + hours(100));
+    BOOST_CHECK(load.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_windowed_set)
+{
+    srand(101);
+    windowed<interval_set<int> > recent(50);
+    interval_set<int> all;
+    for(int step = 0; step < 500; step++)
+    {
+        interval<int> itv = rightopen_interval(step, step + 1 + rand() % 5);
+        if(rand() % 4 == 0)
+            continue;
+        recent += itv;
+        all += itv;
+        interval_set<int> expected = all;
+        expected.truncate_before(recent.expiry());
+        BOOST_CHECK(recent.container() == expected);
+    }
+}
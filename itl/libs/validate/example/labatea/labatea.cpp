@@ -9,6 +9,7 @@ Copyright (c) 2007-2008: Joachim Faulhaber
 +----------------------------------------------------------------------------*/
 #include <iostream>
 #include <stdio.h>
+#include <stdlib.h>
 #include <boost/validate/loki_xt/Tuple.h>
 #include <boost/itl/set.hpp>
 #include <boost/itl/map.hpp>
@@ -50,9 +51,12 @@ void test_Validater()
 }
 
 
-void test_realmvalidater()
+void test_realmvalidater(int argc, char* argv[])
 {
     RealmValidater validater;
+    validater.setThreadCount(boost::thread::hardware_concurrency());
+    if(argc > 1) // reproduce a run by the seed it reported
+        validater.setSeed(strtoul(argv[1], NULL, 10));
     cout << 
     ">> ------------------------------------------------------ <<\n"
     ">> -------- Law based test automaton 'LaBatea' ---------- <<\n"
@@ -63,9 +67,9 @@ void test_realmvalidater()
 };
 
 
-int main()
+int main(int argc, char* argv[])
 {
     //test_Validater();
-    test_realmvalidater();
+    test_realmvalidater(argc, argv);
     return 0;
 }